@@ -0,0 +1,241 @@
+#ifndef AGREGACIONDENSA_H
+#define AGREGACIONDENSA_H
+
+// Agregación densa para claves de pocos valores distintos.
+//
+// Muchas claves de los análisis tienen dominios chicos: una decena de países,
+// tres medios de envío, unas pocas categorías. Para ellas GroupByDenso
+// codifica cada columna clave con un diccionario (valor -> código 0..n-1, en
+// orden de aparición) y acumula en un arreglo plano indexado por los códigos:
+// una fila por código de la primera clave y 'umbral' celdas por cada una de
+// las siguientes (país x medio es una matriz de países x umbral). Cada
+// columna se busca en un diccionario de pocas entradas que entra en caché y
+// se compara por su firma, sin recorrer los strings de la clave compuesta.
+//
+// Con una sola columna clave el diccionario ya es la tabla hash y el arreglo
+// no ahorra nada: ahí conviene GroupBy.
+//
+// Si alguna columna supera 'umbral' valores distintos el arreglo dejaría de
+// ser chico: se descarta lo acumulado y se vuelve a agrupar con GroupBy
+// (hashing). En los dos casos getGrupos() devuelve los mismos grupos que
+// GroupBy, en orden de primera aparición y con primeraFila/ultimaFila, así que
+// quien los usa no sabe por cuál camino se calcularon.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "GroupBy.h"
+
+using namespace std;
+
+// Firma de un valor de texto: los primeros y los últimos 8 bytes y el largo.
+// Hasta 16 bytes (países, ciudades, medios, categorías, fechas) identifica al
+// valor sin más; para valores más largos hay que comparar también el string.
+struct FirmaTexto {
+    uint64_t inicio = 0;
+    uint64_t fin = 0;
+    size_t largo = 0;
+
+    explicit FirmaTexto(const string& s) : largo(s.size()) {
+        const char* p = s.data();
+        if (largo >= 8) {
+            memcpy(&inicio, p, 8);
+            memcpy(&fin, p + largo - 8, 8);
+        } else {
+            for (size_t i = 0; i < largo; ++i) inicio = (inicio << 8) | static_cast<unsigned char>(p[i]);
+        }
+    }
+
+    bool operator==(const FirmaTexto& otra) const {
+        return inicio == otra.inicio && fin == otra.fin && largo == otra.largo;
+    }
+
+    uint64_t hash() const {
+        uint64_t h = (inicio * 0x9e3779b97f4a7c15ULL) ^ ((fin + largo) * 0xc2b2ae3d27d4eb4fULL);
+        return h ^ (h >> 29);
+    }
+};
+
+// Diccionario de una columna: código de cada valor distinto, en orden de
+// aparición. codificar() devuelve -1 si el valor es nuevo y ya hay 'limite'.
+class Diccionario {
+private:
+    struct Ranura {
+        FirmaTexto firma;
+        int32_t codigo; // -1 si la ranura está libre
+    };
+
+    vector<string> valores;
+    vector<Ranura> tabla; // tamaño potencia de dos, factor de carga <= 1/2
+    size_t limite;
+
+    void crecer() {
+        vector<Ranura> anterior(tabla.size() * 2, Ranura{FirmaTexto(string()), -1});
+        anterior.swap(tabla);
+        size_t mascara = tabla.size() - 1;
+        for (const Ranura& r : anterior) {
+            if (r.codigo < 0) continue;
+            size_t pos = r.firma.hash() & mascara;
+            while (tabla[pos].codigo >= 0) pos = (pos + 1) & mascara;
+            tabla[pos] = r;
+        }
+    }
+
+public:
+    explicit Diccionario(size_t lim) : tabla(16, Ranura{FirmaTexto(string()), -1}), limite(lim) {}
+
+    int codificar(const string& valor) {
+        FirmaTexto firma(valor);
+        size_t mascara = tabla.size() - 1;
+        size_t pos = firma.hash() & mascara;
+        while (tabla[pos].codigo >= 0) {
+            const Ranura& r = tabla[pos];
+            if (r.firma == firma && (firma.largo <= 16 || valores[r.codigo] == valor)) return r.codigo;
+            pos = (pos + 1) & mascara;
+        }
+        if (valores.size() >= limite) return -1;
+        valores.push_back(valor);
+        tabla[pos] = Ranura{firma, static_cast<int32_t>(valores.size()) - 1};
+        int codigo = tabla[pos].codigo;
+        if (valores.size() * 2 > tabla.size()) crecer();
+        return codigo;
+    }
+
+    const string& valor(int codigo) const {
+        return valores[codigo];
+    }
+
+    size_t getTamanio() const {
+        return valores.size();
+    }
+};
+
+template <class ClavesGrupo, class... Agregados>
+class GroupByDenso;
+
+template <class... Columnas, class... Agregados>
+class GroupByDenso<Claves<Columnas...>, Agregados...> {
+public:
+    typedef GroupBy<Claves<Columnas...>, Agregados...> GroupByHash;
+    typedef typename GroupByHash::Grupo Grupo;
+    static const size_t CANTIDAD_CLAVES = sizeof...(Columnas);
+
+private:
+    static_assert(conjunction<is_same<typename Columnas::Tipo, string>...>::value,
+                  "GroupByDenso solo codifica columnas de texto");
+
+    struct Celda {
+        tuple<Agregados...> agregados;
+        long long primeraFila = -1; // -1: celda sin ventas
+        long long ultimaFila = -1;
+    };
+
+    size_t umbral;
+    vector<Diccionario> diccionarios;
+    vector<Celda> celdas;
+    size_t celdasPorFila; // umbral^(claves - 1)
+    vector<Grupo> grupos;
+    bool denso = true;
+
+    // Posición de la venta en 'celdas': los códigos leídos en base 'umbral'.
+    // -1 si alguna columna ya no entra en su diccionario.
+    template <size_t... I>
+    long long indiceCelda(const Venta& v, index_sequence<I...>) {
+        long long indice = 0;
+        bool entra = true;
+        ((entra = entra && agregarDigito(indice, diccionarios[I].codificar(Columnas::de(v)))), ...);
+        return entra ? indice : -1;
+    }
+
+    bool agregarDigito(long long& indice, int codigo) const {
+        indice = indice * umbral + codigo;
+        return codigo >= 0;
+    }
+
+    template <size_t... I>
+    static void agregarEn(Celda& c, const Venta& v, index_sequence<I...>) {
+        (get<I>(c.agregados).agregar(v), ...);
+    }
+
+    template <size_t... I>
+    typename GroupByHash::Clave claveDe(size_t indice, index_sequence<I...>) const {
+        // Descompone el índice en los códigos de cada columna (base 'umbral')
+        int codigos[CANTIDAD_CLAVES];
+        for (size_t i = CANTIDAD_CLAVES; i-- > 1;) {
+            codigos[i] = static_cast<int>(indice % umbral);
+            indice /= umbral;
+        }
+        codigos[0] = static_cast<int>(indice);
+        return typename GroupByHash::Clave(diccionarios[I].valor(codigos[I])...);
+    }
+
+    bool agregarDenso(const Lista<Venta>& lista) {
+        long long fila = 0;
+        for (Nodo<Venta>* nodo = lista.getInicio(); nodo != nullptr; nodo = nodo->getSiguiente(), ++fila) {
+            const Venta& v = nodo->verDato();
+            long long indice = indiceCelda(v, index_sequence_for<Columnas...>());
+            if (indice < 0) return false;
+            if (static_cast<size_t>(indice) >= celdas.size()) {
+                // Apareció un código nuevo en la primera columna: otra fila
+                celdas.resize((indice / celdasPorFila + 1) * celdasPorFila);
+            }
+            Celda& celda = celdas[indice];
+            if (celda.primeraFila < 0) celda.primeraFila = fila;
+            celda.ultimaFila = fila;
+            agregarEn(celda, v, index_sequence_for<Agregados...>());
+        }
+
+        vector<pair<long long, size_t>> usadas; // (primera fila, índice)
+        for (size_t i = 0; i < celdas.size(); ++i) {
+            if (celdas[i].primeraFila >= 0) usadas.push_back({celdas[i].primeraFila, i});
+        }
+        sort(usadas.begin(), usadas.end());
+        for (const auto& u : usadas) {
+            const Celda& celda = celdas[u.second];
+            grupos.push_back(Grupo{claveDe(u.second, index_sequence_for<Columnas...>()), celda.agregados, 0,
+                                   celda.primeraFila, celda.ultimaFila});
+        }
+        return true;
+    }
+
+public:
+    explicit GroupByDenso(size_t umbralPorColumna = 64)
+        : umbral(umbralPorColumna), diccionarios(CANTIDAD_CLAVES, Diccionario(umbralPorColumna)), celdasPorFila(1) {
+        for (size_t i = 1; i < CANTIDAD_CLAVES; ++i) celdasPorFila *= umbral;
+    }
+
+    // Agrupa toda la lista. Con más de 'umbral' valores en alguna columna
+    // vuelve a empezar con GroupBy.
+    void agregar(const Lista<Venta>& lista) {
+        if (agregarDenso(lista)) return;
+
+        denso = false;
+        celdas.clear();
+        celdas.shrink_to_fit();
+        GroupByHash porHash;
+        porHash.agregar(lista);
+        grupos = porHash.getGrupos();
+    }
+
+    // Grupos en el orden en que aparecieron por primera vez
+    const vector<Grupo>& getGrupos() const {
+        return grupos;
+    }
+
+    size_t getTamanio() const {
+        return grupos.size();
+    }
+
+    // false si hubo que caer en GroupBy por superar el umbral
+    bool esDenso() const {
+        return denso;
+    }
+};
+
+#endif // AGREGACIONDENSA_H
@@ -0,0 +1,416 @@
+#ifndef AGREGACIONEXTERNA_H
+#define AGREGACIONEXTERNA_H
+
+// Agregación con presupuesto de memoria (--memoria). Las ventas no se cargan:
+// cada análisis lee el CSV de principio a fin (recorrerVentasCSV, CargaCSV.h)
+// y agrupa con GroupByExterno en lugar de GroupBy.
+//
+// GroupByExterno<Claves<...>, Agregados...> agrupa en memoria mientras la
+// tabla entre en el presupuesto (contando lo que ocupa al crecer). Si no
+// entra, la derrama en PARTICIONES_DISCO archivos temporales según los bits
+// altos del hash de la clave: cada grupo ya agregado se escribe como un
+// registro parcial y las ventas que siguen se escriben enteras, con su número
+// de fila, en la partición de su clave. Al terminar cada partición se agrupa
+// sola (sus claves no están en ninguna otra) partiendo de los parciales; si
+// su tabla tampoco entra, lo que falta se vuelve a partir con los bits
+// siguientes del hash, hasta NIVELES_PARTICION veces. Los grupos terminados
+// se juntan en otro archivo y se leen al final, ordenados por primera fila:
+// getGrupos() devuelve los mismos grupos, en el mismo orden y con las mismas
+// sumas (hechas en el orden de las filas) que GroupBy sobre todas las ventas,
+// y los análisis dan exactamente los mismos resultados.
+//
+// El presupuesto acota la tabla de agregación y los buffers de las
+// particiones; los grupos del resultado tienen que entrar en memoria (se
+// leen en un vector de su tamaño justo).
+//
+// Los archivos se crean con mkstemp en el directorio temporal y se borran
+// enseguida (quedan abiertos): no dejan restos aunque el proceso termine mal.
+// Si no se pueden crear o escribir se lanza runtime_error.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Venta.h"
+#include "Lista.h"
+#include "GroupBy.h"
+#include "AgregacionDensa.h"
+#include "CargaCSV.h"       // recorrerVentasCSV
+#include "RegistroBinario.h"
+#include "Metricas.h"
+
+using namespace std;
+
+#define PARTICIONES_DISCO 32                  // Archivos por derrame
+#define BITS_PARTICION 5                      // log2(PARTICIONES_DISCO)
+#define NIVELES_PARTICION 4                   // Veces que se puede volver a partir una partición
+#define TAMANIO_BUFFER_PARTICION (64 * 1024)  // Escritura de cada partición
+#define TAMANIO_LECTURA_PARTICION (1 << 20)   // Lectura de una partición
+// Buffers de las particiones que se escriben y de la que se lee
+#define RESERVA_BUFFERS_DISCO (PARTICIONES_DISCO * TAMANIO_BUFFER_PARTICION + 2 * TAMANIO_LECTURA_PARTICION)
+#define MEMORIA_MINIMA_MB 8                   // --memoria: la mitad se va en buffers
+
+enum TipoRegistroParticion : uint8_t {
+    PARTICION_GRUPO = 1, // claves, agregados, primera y última fila
+    PARTICION_VENTA = 2, // fila y venta completa
+};
+
+// Lo que se derramó a disco en toda la corrida
+struct EstadisticasDisco {
+    long long derrames = 0;     // tablas que no entraron en el presupuesto
+    long long particiones = 0;  // archivos temporales creados
+    long long registros = 0;
+    long long bytesEscritos = 0;
+    int nivelMaximo = 0;        // 0: sin particiones repartidas
+};
+
+EstadisticasDisco g_estadisticasDisco;
+
+// Archivo temporal de registros (largo u32 + contenido), escrito por bloques
+// y leído de una sola pasada
+class ArchivoParticion {
+private:
+    int fd = -1;
+    string buffer;
+
+    void volcar() {
+        if (buffer.empty()) return;
+        if (!escribirTodoFd(fd, buffer.data(), buffer.size())) {
+            throw runtime_error(string("no se pudo escribir una particion: ") + strerror(errno));
+        }
+        g_estadisticasDisco.bytesEscritos += static_cast<long long>(buffer.size());
+        buffer.clear();
+    }
+
+public:
+    explicit ArchivoParticion(const string& directorio) {
+        string plantilla = directorio + "/tp_particion_XXXXXX";
+        vector<char> ruta(plantilla.begin(), plantilla.end());
+        ruta.push_back('\0');
+        fd = mkstemp(ruta.data());
+        if (fd == -1) {
+            throw runtime_error("no se pudo crear un archivo temporal en " + directorio + ": " + strerror(errno));
+        }
+        unlink(ruta.data());
+        buffer.reserve(TAMANIO_BUFFER_PARTICION);
+        g_estadisticasDisco.particiones++;
+    }
+
+    ~ArchivoParticion() {
+        if (fd != -1) close(fd);
+    }
+
+    ArchivoParticion(const ArchivoParticion&) = delete;
+    ArchivoParticion& operator=(const ArchivoParticion&) = delete;
+
+    void agregar(const string& registro) {
+        if (buffer.size() + sizeof(uint32_t) + registro.size() > TAMANIO_BUFFER_PARTICION) volcar();
+        agregarU32(buffer, static_cast<uint32_t>(registro.size()));
+        buffer += registro;
+        g_estadisticasDisco.registros++;
+    }
+
+    // Escribe lo que queda en el buffer y lo libera
+    void terminarEscritura() {
+        volcar();
+        string().swap(buffer);
+    }
+
+    // Llama a 'funcion' con cada registro, en el orden en que se agregaron
+    template <class Funcion>
+    void recorrer(Funcion funcion) {
+        terminarEscritura();
+        if (lseek(fd, 0, SEEK_SET) != 0) {
+            throw runtime_error(string("no se pudo leer una particion: ") + strerror(errno));
+        }
+        vector<char> bloque(TAMANIO_LECTURA_PARTICION);
+        string pendiente; // bytes leídos desde el primer registro sin procesar
+        string registro;
+        size_t pos = 0;
+        while (true) {
+            ssize_t leidos = read(fd, bloque.data(), bloque.size());
+            if (leidos < 0 && errno == EINTR) continue;
+            if (leidos < 0) throw runtime_error(string("no se pudo leer una particion: ") + strerror(errno));
+            if (leidos == 0) break;
+            pendiente.erase(0, pos);
+            pos = 0;
+            pendiente.append(bloque.data(), static_cast<size_t>(leidos));
+            while (pendiente.size() - pos >= sizeof(uint32_t)) {
+                uint32_t largo;
+                memcpy(&largo, pendiente.data() + pos, sizeof(largo));
+                if (pendiente.size() - pos - sizeof(uint32_t) < largo) break;
+                registro.assign(pendiente, pos + sizeof(uint32_t), largo);
+                pos += sizeof(uint32_t) + largo;
+                funcion(registro);
+            }
+        }
+        if (pos != pendiente.size()) throw runtime_error("particion cortada");
+    }
+};
+
+template <class ClavesGrupo, class... Agregados>
+class GroupByExterno;
+
+template <class... Columnas, class... Agregados>
+class GroupByExterno<Claves<Columnas...>, Agregados...> {
+public:
+    typedef GroupBy<Claves<Columnas...>, Agregados...> Tabla;
+    typedef typename Tabla::Grupo Grupo;
+    typedef typename Tabla::Clave Clave;
+
+private:
+    static_assert(conjunction<is_same<typename Columnas::Tipo, string>...>::value,
+                  "GroupByExterno solo escribe claves de texto");
+    static_assert(conjunction<is_trivially_copyable<Agregados>...>::value,
+                  "GroupByExterno escribe los agregados byte a byte");
+
+    typedef vector<unique_ptr<ArchivoParticion>> Particiones;
+
+    size_t presupuestoTabla;
+    string directorio;
+    Tabla enMemoria;
+    Particiones particiones; // vacío mientras la tabla entra en memoria
+    vector<Grupo> grupos;    // resultado, si hubo particiones
+    long long filas = 0;
+    string registro;
+
+    static size_t particionDe(size_t hash, int nivel) {
+        return (hash >> (sizeof(size_t) * 8 - BITS_PARTICION * (nivel + 1))) & (PARTICIONES_DISCO - 1);
+    }
+
+    template <size_t... I>
+    static void escribirClaves(string& destino, const Clave& clave, index_sequence<I...>) {
+        (agregarTexto(destino, get<I>(clave)), ...);
+    }
+
+    template <size_t... I>
+    static void escribirAgregados(string& destino, const tuple<Agregados...>& agregados, index_sequence<I...>) {
+        (agregarBytes(destino, get<I>(agregados)), ...);
+    }
+
+    template <size_t... I>
+    static void leerClaves(LectorRegistroWAL& lector, Clave& clave, index_sequence<I...>) {
+        ((get<I>(clave) = lector.leerTexto()), ...);
+    }
+
+    template <size_t... I>
+    static void leerAgregados(LectorRegistroWAL& lector, tuple<Agregados...>& agregados, index_sequence<I...>) {
+        ((get<I>(agregados) = lector.template leer<Agregados>()), ...);
+    }
+
+    static void escribirGrupo(string& destino, const Grupo& grupo) {
+        destino.push_back(static_cast<char>(PARTICION_GRUPO));
+        escribirClaves(destino, grupo.claves, index_sequence_for<Columnas...>());
+        escribirAgregados(destino, grupo.agregados, index_sequence_for<Agregados...>());
+        agregarBytes(destino, grupo.primeraFila);
+        agregarBytes(destino, grupo.ultimaFila);
+    }
+
+    static Grupo leerGrupo(LectorRegistroWAL& lector) {
+        Grupo grupo;
+        leerClaves(lector, grupo.claves, index_sequence_for<Columnas...>());
+        leerAgregados(lector, grupo.agregados, index_sequence_for<Agregados...>());
+        grupo.primeraFila = lector.leer<long long>();
+        grupo.ultimaFila = lector.leer<long long>();
+        grupo.hashClave = Tabla::hashDe(grupo.claves);
+        return grupo;
+    }
+
+    static void aplicar(Tabla& tabla, const string& contenido) {
+        LectorRegistroWAL lector(contenido);
+        if (lector.leer<uint8_t>() == PARTICION_GRUPO) {
+            Grupo grupo = leerGrupo(lector);
+            if (lector.ok) tabla.agregarGrupo(move(grupo));
+        } else {
+            long long fila = lector.leer<long long>();
+            Venta v = lector.leerVenta();
+            if (lector.ok) tabla.agregar(v, fila);
+        }
+        if (!lector.ok || !lector.alFinal()) throw runtime_error("registro de particion invalido");
+    }
+
+    static size_t hashDeRegistro(const string& contenido) {
+        LectorRegistroWAL lector(contenido);
+        if (lector.leer<uint8_t>() == PARTICION_GRUPO) {
+            Clave clave;
+            leerClaves(lector, clave, index_sequence_for<Columnas...>());
+            return Tabla::hashDe(clave);
+        }
+        lector.leer<long long>();
+        return Tabla::hashDe(lector.leerVenta());
+    }
+
+    // Escribe los grupos de la tabla en particiones nuevas del nivel y la vacía
+    void derramar(Tabla& tabla, Particiones& destino, int nivel) {
+        for (int i = 0; i < PARTICIONES_DISCO; ++i) destino.push_back(make_unique<ArchivoParticion>(directorio));
+        for (const Grupo& grupo : tabla.getGrupos()) {
+            registro.clear();
+            escribirGrupo(registro, grupo);
+            destino[particionDe(grupo.hashClave, nivel)]->agregar(registro);
+        }
+        tabla = Tabla();
+        g_estadisticasDisco.derrames++;
+        g_estadisticasDisco.nivelMaximo = max(g_estadisticasDisco.nivelMaximo, nivel);
+    }
+
+    // Agrupa una partición y escribe sus grupos en 'resultado'. Si la tabla no
+    // entra, el resto de la partición se reparte con los bits del nivel.
+    void agruparParticion(ArchivoParticion& particion, int nivel, ArchivoParticion& resultado, size_t& cantidad) {
+        Tabla tabla;
+        Particiones subparticiones;
+        particion.recorrer([&](const string& contenido) {
+            if (!subparticiones.empty()) {
+                subparticiones[particionDe(hashDeRegistro(contenido), nivel)]->agregar(contenido);
+                return;
+            }
+            aplicar(tabla, contenido);
+            // En el último nivel la partición se agrupa aunque pase el presupuesto
+            if (nivel < NIVELES_PARTICION && tabla.getBytesAlCrecer() > presupuestoTabla) {
+                derramar(tabla, subparticiones, nivel);
+            }
+        });
+
+        if (subparticiones.empty()) {
+            for (const Grupo& grupo : tabla.getGrupos()) {
+                registro.clear();
+                escribirGrupo(registro, grupo);
+                resultado.agregar(registro);
+            }
+            cantidad += tabla.getTamanio();
+            return;
+        }
+        for (auto& s : subparticiones) s->terminarEscritura();
+        for (auto& s : subparticiones) {
+            agruparParticion(*s, nivel + 1, resultado, cantidad);
+            s.reset();
+        }
+    }
+
+public:
+    // 'presupuesto': bytes para la agregación, buffers de las particiones incluidos
+    GroupByExterno(size_t presupuesto, const string& directorioTemporal)
+        : presupuestoTabla(presupuesto > RESERVA_BUFFERS_DISCO ? presupuesto - RESERVA_BUFFERS_DISCO : 0),
+          directorio(directorioTemporal) {}
+
+    void agregar(const Venta& v) {
+        long long fila = filas++;
+        if (particiones.empty()) {
+            enMemoria.agregar(v, fila);
+            if (enMemoria.getBytesAlCrecer() > presupuestoTabla) derramar(enMemoria, particiones, 0);
+            return;
+        }
+        registro.clear();
+        registro.push_back(static_cast<char>(PARTICION_VENTA));
+        agregarBytes(registro, fila);
+        agregarVentaWAL(registro, v);
+        particiones[particionDe(Tabla::hashDe(v), 0)]->agregar(registro);
+    }
+
+    // Agrupa las particiones, si las hubo. Va después de la última venta.
+    void terminar() {
+        if (particiones.empty()) return;
+        TemporizadorFase temporizador("disco/particiones", "disco", filas);
+        for (auto& p : particiones) p->terminarEscritura();
+
+        ArchivoParticion resultado(directorio);
+        size_t cantidad = 0;
+        for (auto& p : particiones) {
+            agruparParticion(*p, 1, resultado, cantidad);
+            p.reset();
+        }
+
+        grupos.reserve(cantidad);
+        resultado.recorrer([&](const string& contenido) {
+            LectorRegistroWAL lector(contenido);
+            lector.leer<uint8_t>();
+            grupos.push_back(leerGrupo(lector));
+        });
+        sort(grupos.begin(), grupos.end(),
+             [](const Grupo& a, const Grupo& b) { return a.primeraFila < b.primeraFila; });
+    }
+
+    // Grupos en el orden en que aparecieron por primera vez
+    const vector<Grupo>& getGrupos() const {
+        return particiones.empty() ? enMemoria.getGrupos() : grupos;
+    }
+
+    size_t getTamanio() const {
+        return getGrupos().size();
+    }
+
+    long long getFilas() const {
+        return filas;
+    }
+};
+
+// --- Agrupamiento de los análisis ---
+// Analisis.h arma sus tablas con Agrupacion::Agrupamiento (o
+// AgrupamientoDenso, para claves de pocos valores) y las llena con
+// Agrupacion::agrupar(tabla, listaVentas).
+
+// CSV y presupuesto de los análisis con --memoria
+struct FuenteEnDisco {
+    string archivo;
+    size_t presupuesto;          // bytes
+    string directorioTemporal;
+};
+
+// Fuente de los análisis con --memoria (nullptr: sobre la lista cargada)
+const FuenteEnDisco* g_fuenteEnDisco = nullptr;
+
+// Directorio de los archivos temporales por defecto: $TMPDIR o /tmp
+string directorioTemporalPorDefecto() {
+    const char* tmp = getenv("TMPDIR");
+    return tmp != nullptr && *tmp != '\0' ? tmp : "/tmp";
+}
+
+// Recorre las ventas del CSV de g_fuenteEnDisco
+template <class Funcion>
+void recorrerVentasEnDisco(Funcion funcion) {
+    if (!recorrerVentasCSV(g_fuenteEnDisco->archivo, funcion)) {
+        throw runtime_error("no se pudo abrir el archivo " + g_fuenteEnDisco->archivo);
+    }
+}
+
+struct AgrupacionEnMemoria {
+    template <class ClavesGrupo, class... Agregados>
+    using Agrupamiento = GroupBy<ClavesGrupo, Agregados...>;
+    template <class ClavesGrupo, class... Agregados>
+    using AgrupamientoDenso = GroupByDenso<ClavesGrupo, Agregados...>;
+
+    template <class Tabla>
+    static void agrupar(Tabla& tabla, const Lista<Venta>& listaVentas) {
+        tabla.agregar(listaVentas);
+    }
+};
+
+// Las ventas no están en la lista (queda vacía): se leen del CSV. Las claves
+// de pocos valores también van a GroupByExterno, que con ellas nunca derrama.
+struct AgrupacionEnDisco {
+    template <class ClavesGrupo, class... Agregados>
+    struct Agrupamiento : GroupByExterno<ClavesGrupo, Agregados...> {
+        explicit Agrupamiento(size_t = 0)
+            : GroupByExterno<ClavesGrupo, Agregados...>(g_fuenteEnDisco->presupuesto, g_fuenteEnDisco->directorioTemporal) {}
+    };
+    template <class ClavesGrupo, class... Agregados>
+    using AgrupamientoDenso = Agrupamiento<ClavesGrupo, Agregados...>;
+
+    template <class Tabla>
+    static void agrupar(Tabla& tabla, const Lista<Venta>&) {
+        recorrerVentasEnDisco([&](const Venta& v) { tabla.agregar(v); });
+        tabla.terminar();
+    }
+};
+
+#endif // AGREGACIONEXTERNA_H
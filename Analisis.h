@@ -0,0 +1,1344 @@
+#ifndef ANALISIS_H
+#define ANALISIS_H
+
+// Funciones auxiliares, contadores y análisis sobre la lista de ventas.
+// Se separan de main.cpp para poder reutilizarlas desde otros ejecutables
+// (por ejemplo benchmark.cpp) sin arrastrar los menús interactivos.
+
+#include <iostream>     // Para entrada/salida de consola (cout, cin, endl)
+#include <string>       // Para usar el tipo de dato string
+#include <vector>       // Para usar el contenedor dinámico vector
+#include <iomanip>      // Para fixed y setprecision (formato de salida flotante)
+#include <stdexcept>    // Para manejar excepciones como runtime_error, invalid_argument
+#include <limits>       // Necesario para numeric_limits
+#include <cctype>       // Necesario para tolower
+#include <algorithm>    // Necesario para transform
+#include <unordered_map> // Índice de claves externas al anidar grupos
+#include <map>           // Países de compararDosProductosPorPais
+
+using namespace std;
+
+#include "Venta.h"      // Clase que representa una venta
+#include "Lista.h"      // Implementación de Lista Enlazada
+#include "HashEntry.h"  // Entrada para la tabla hash
+#include "HashMapList.h" // Implementación de Tabla Hash con manejo de colisiones por listas
+#include "quickSort.h"  // Algoritmo de ordenamiento QuickSort genérico
+#include "Metricas.h"   // Temporizadores por fase
+#include "SalidaReporte.h" // Salida buffereada y formato de montos (fijo2)
+#include "Resultados.h" // Escritores JSON/CSV de resultados
+#include "GroupBy.h"    // Agrupamiento genérico por columnas
+#include "AgregacionDensa.h" // Agrupamiento en arreglos para claves de pocos valores
+#include "IndiceVentas.h" // Bitmaps por país, categoría y envío
+#include "Muestreo.h"   // Agregados estimados sobre una muestra (--approx)
+#include "AgregacionExterna.h" // Agrupamiento con presupuesto de memoria (--memoria)
+
+#define TAMANIO_HASH_PAISES 50                 // Tamaño inicial para el hash de países
+#define TAMANIO_HASH_CIUDADES 100              // Reutilizamos el tamaño para los inner HashMaps
+#define UMBRAL_CLAVES_DENSAS 64                // Valores distintos por columna para agrupar en arreglo
+
+
+//Contadores de condicionales
+struct ConditionalCounters {
+    int analizarTop5CiudadesPorPais_ifs = 0;
+    int analizarMontoTotalPorProductoPorPais_ifs = 0;
+    int analizarPromedioVentasPorCategoriaPorPais_ifs = 0;
+    int analizarMedioEnvioMasUtilizadoPorPais_ifs = 0;
+    int analizarMedioEnvioMasUtilizadoPorCategoria_ifs = 0;
+    int analizarDiaMayorVentas_ifs = 0;
+    int analizarProductoMasYMenosVendido_ifs = 0;
+    int eliminarVenta_ifs = 0; 
+    int modificarVenta_ifs = 0; 
+    int listarVentasPorCiudad_ifs = 0;
+    int listarVentasPorRangoFechasPorPais_ifs = 0;
+    int compararDosPaises_ifs = 0;
+    int compararDosProductosPorPais_ifs = 0;
+    int buscarProductosPorDebajoUmbralPorPais_ifs = 0;
+    int buscarProductosPorEncimaUmbral_ifs = 0;
+};
+
+// Un juego de contadores por hilo: en modo servidor varias consultas corren a
+// la vez y no deben pisarse los contadores entre sí.
+thread_local ConditionalCounters g_condCounters;
+
+// --- Funciones Auxiliares ---
+// Función hash simple para strings (necesaria para el HashMap)
+unsigned int stringHash(string s) {
+    unsigned int hash = 0;
+    for (char c : s) {
+        hash = hash * 31 + c;
+    }
+    return hash;
+}
+
+// Función para normalizar cadenas
+string normalizeString(string s) {
+    transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+
+// Estructura para el promedio de ventas por categoría
+struct CategoriaEstadisticas {
+    float totalMonto;
+    int totalCantidad;
+
+    CategoriaEstadisticas(float tm = 0.0f, int tc = 0) : totalMonto(tm), totalCantidad(tc) {}
+
+    float getPromedio() const {
+        if (totalCantidad == 0) return 0.0f;
+        return totalMonto / totalCantidad;
+    }
+};
+
+struct ProductoEstadisticas {
+    int totalCantidad;
+    float totalMonto;
+
+    ProductoEstadisticas(int tc = 0, float tm = 0.0f) : totalCantidad(tc), totalMonto(tm) {}
+};
+
+bool parseDate(const string& dateStr, int& day, int& month, int& year) {
+    if (dateStr.length() != 10 || dateStr[2] != '/' || dateStr[5] != '/') { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; 
+        return false; // Formato inválido
+    }
+    try {
+        day = stoi(dateStr.substr(0, 2));
+        month = stoi(dateStr.substr(3, 2));
+        year = stoi(dateStr.substr(6, 4));
+        // Validacion básica de rangos (ej. 1-31 para dia, 1-12 para mes)
+        if (day < 1 || day > 31 || month < 1 || month > 12 || year < 1900 || year > 2100) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; 
+            return false;
+        }
+    } catch (const invalid_argument& e) {
+        return false; // Error de conversion (no es un numero)
+    } catch (const out_of_range& e) { 
+        return false; // Numero fuera de rango
+    }
+    return true;
+}
+
+int compareDates(int d1, int m1, int y1, int d2, int m2, int y2) {
+    if (y1 != y2) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; return y1 - y2; } 
+    if (m1 != m2) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; return m1 - m2; } 
+    g_condCounters.listarVentasPorRangoFechasPorPais_ifs++;
+    return d1 - d2;
+}
+
+// Los tres datos por país que usa compararDosPaises salen del cubo país x
+// producto que mantiene el índice (CuboVentas.h): no se recorre la lista.
+
+// Obtiene el monto total de ventas para un país específico
+float obtenerMontoTotalPais(const Lista<Venta>& listaVentas, const string& paisAComparar) {
+    shared_ptr<const IndiceVentas> indice = g_indicesVentas.obtener(listaVentas);
+    const ResumenPais* resumen = indice->resumenPais(paisAComparar);
+    return resumen == nullptr ? 0.0f : static_cast<float>(resumen->monto);
+}
+
+// Grupos del cubo en el orden en que los devolvía el HashMapList de 'tamanio'
+// buckets en que se acumulaban con remove+put: por bucket y, dentro del
+// bucket, por su última fila. Así los empates se resuelven igual que antes.
+vector<const TotalesGrupo*> ordenarTotalesComoHashMapList(const GruposPorClave& grupos, unsigned int tamanio) {
+    vector<pair<pair<unsigned int, unsigned long long>, const TotalesGrupo*>> posiciones;
+    for (const TotalesGrupo& g : grupos.getGrupos()) {
+        posiciones.push_back({{stringHash(g.clave) % tamanio, g.ultimaSecuencia}, &g});
+    }
+    sort(posiciones.begin(), posiciones.end(),
+         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    vector<const TotalesGrupo*> ordenados;
+    for (const auto& p : posiciones) ordenados.push_back(p.second);
+    return ordenados;
+}
+
+// Obtiene los productos más vendidos (por monto) para un país específico
+vector<pair<string, float>> obtenerProductosMasVendidosPais(const Lista<Venta>& listaVentas, const string& paisAComparar, int topN) {
+    shared_ptr<const IndiceVentas> indice = g_indicesVentas.obtener(listaVentas);
+    const ResumenPais* resumen = indice->resumenPais(paisAComparar);
+    if (resumen == nullptr) return {};
+
+    vector<pair<string, float>> allProducts;
+    for (const TotalesGrupo* p : ordenarTotalesComoHashMapList(resumen->productos, TAMANIO_HASH_CIUDADES)) {
+        allProducts.push_back({p->clave, p->monto});
+    }
+    sort(allProducts.begin(), allProducts.end(), [](const pair<string, float>& a, const pair<string, float>& b) {
+        return a.second > b.second; // Ordenar por monto descendente
+    });
+
+    if ((int)allProducts.size() > topN) allProducts.resize(max(topN, 0));
+    return allProducts;
+}
+
+// Obtiene el medio de envío más usado para un país específico
+pair<string, int> obtenerMedioEnvioMasUsadoPais(const Lista<Venta>& listaVentas, const string& paisAComparar) {
+    shared_ptr<const IndiceVentas> indice = g_indicesVentas.obtener(listaVentas);
+    const ResumenPais* resumen = indice->resumenPais(paisAComparar);
+
+    string medioMasUtilizado = "N/A";
+    int maxCount = 0;
+    if (resumen != nullptr && !resumen->medios.getGrupos().empty()) {
+        maxCount = -1;
+        for (const TotalesGrupo* m : ordenarTotalesComoHashMapList(resumen->medios, TAMANIO_HASH_CIUDADES)) {
+            if (m->ventas > maxCount) {
+                maxCount = m->ventas;
+                medioMasUtilizado = m->clave;
+            }
+        }
+    }
+    return {medioMasUtilizado, maxCount};
+}
+
+// --- Resultados de los análisis ---
+// Cada análisis se calcula en una de estas estructuras (calcular*) y después
+// se muestra como texto (mostrar*) o se entrega a un EscritorResultado
+// (escribir*). Los grupos quedan en el orden en que los devuelve el hash.
+// Con --approx los valores son estimaciones sobre una muestra: 'muestra' lo
+// indica y cada valor lleva el margen de su intervalo de confianza del 95%.
+
+struct CiudadesPais {
+    string pais;
+    vector<CiudadMonto> ciudades; // hasta 5, de mayor a menor monto
+};
+
+struct ResultadoTop5Ciudades {
+    vector<CiudadesPais> paises;
+    ResumenMuestra muestra;
+};
+
+struct ProductosPais {
+    string pais;
+    vector<pair<string, float>> productos; // producto, monto total
+    vector<float> margenes;                // uno por producto
+};
+
+struct ResultadoMontoPorProductoPais {
+    vector<ProductosPais> paises;
+    ResumenMuestra muestra;
+};
+
+struct CategoriasPais {
+    string pais;
+    vector<pair<string, float>> categorias; // categoría, promedio por unidad
+    vector<float> margenes;                 // uno por categoría
+};
+
+struct ResultadoPromedioPorCategoriaPais {
+    vector<CategoriasPais> paises;
+    ResumenMuestra muestra;
+};
+
+struct MedioEnvioGrupo {
+    string grupo;  // país o categoría
+    bool hayDatos = false;
+    string medio;
+    int veces = -1;
+    int margen = 0;
+};
+
+struct ResultadoMedioEnvio {
+    vector<MedioEnvioGrupo> grupos;
+    ResumenMuestra muestra;
+};
+
+#define CANTIDAD_MEJORES_DIAS 5
+
+struct DiaMonto {
+    string dia;
+    float monto;
+    float margen = 0.0f;
+};
+
+struct ResultadoDiaMayorVentas {
+    bool hayDatos = false;
+    string dia;
+    float monto = -1.0f;
+    vector<DiaMonto> mejoresDias;                // los CANTIDAD_MEJORES_DIAS de mayor monto
+    vector<pair<string, DiaMonto>> mejorPorPais; // por país, ordenados por nombre
+    ResumenMuestra muestra;
+};
+
+struct ResultadoProductoMasYMenosVendido {
+    bool hayDatos = false;
+    string masVendido;
+    int cantidadMas = -1;
+    string menosVendido;
+    int cantidadMenos = numeric_limits<int>::max();
+    int margenMas = 0;
+    int margenMenos = 0;
+    ResumenMuestra muestra;
+};
+
+// Percentiles del monto por venta de un grupo (una categoría, un país o
+// todas las ventas)
+struct PercentilesGrupo {
+    string grupo;
+    long long ventas;
+    float minimo, p50, p90, p99, maximo;
+    long long margenVentas = 0;
+    float margenP50 = 0.0f, margenP90 = 0.0f, margenP99 = 0.0f;
+};
+
+struct ResultadoPercentilesMontos {
+    vector<PercentilesGrupo> categorias; // por nombre
+    vector<PercentilesGrupo> paises;     // por nombre
+    PercentilesGrupo total{"", 0, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    ResumenMuestra muestra;
+};
+
+// --- Resultados estimados ---
+// El texto aclara el tamaño de la muestra y agrega " (+/- margen)" a cada
+// valor; JSON y CSV agregan una columna "margen" y una tabla "muestra".
+
+void mostrarMuestra(const ResumenMuestra& muestra, ostream& salida) {
+    if (!muestra.estimado) return;
+    salida << "(Estimado sobre una muestra " << muestra.estratificacion << " de " << muestra.ventas << " de "
+           << muestra.poblacion << " ventas; +/- es el margen del intervalo de confianza del 95%)\n";
+}
+
+void mostrarMargenMonto(const ResumenMuestra& muestra, double margen, ostream& salida) {
+    if (muestra.estimado) salida << " (+/- $" << fijo2(margen) << ")";
+}
+
+void mostrarMargenConteo(const ResumenMuestra& muestra, long long margen, ostream& salida) {
+    if (muestra.estimado) salida << " (+/- " << margen << ")";
+}
+
+vector<string> columnasConMargen(const ResumenMuestra& muestra, vector<string> columnas) {
+    if (muestra.estimado) columnas.push_back("margen");
+    return columnas;
+}
+
+void escribirMargen(const ResumenMuestra& muestra, double margen, EscritorResultado& escritor) {
+    if (muestra.estimado) escritor.real(static_cast<float>(margen));
+}
+
+void escribirMuestra(const ResumenMuestra& muestra, EscritorResultado& escritor) {
+    if (!muestra.estimado) return;
+    escritor.comenzarTabla("muestra", {"estratificacion", "ventas", "poblacion", "confianza"});
+    escritor.texto(muestra.estratificacion);
+    escritor.entero(muestra.ventas);
+    escritor.entero(muestra.poblacion);
+    escritor.real(0.95f);
+    escritor.terminarFila();
+    escritor.terminarTabla();
+}
+
+// --- Orden de los grupos ---
+// Los análisis agrupan con GroupBy (GroupBy.h) pero informan los grupos en el
+// mismo orden en que los devolvía el HashMapList que usaban antes: por bucket
+// (stringHash % tamaño) y, dentro del bucket, por orden de llegada. Las claves
+// que se actualizaban con remove+put pasaban al final de su bucket con cada
+// venta, así que para ellas cuenta la última fila del grupo y no la primera.
+
+template <class Grupo>
+long long filaDeOrden(const Grupo& grupo, bool porUltimaFila) {
+    return porUltimaFila ? grupo.ultimaFila : grupo.primeraFila;
+}
+
+// Grupos de una sola clave de texto, ordenados como HashMapList::getAllEntries
+template <class Grupo>
+vector<const Grupo*> ordenarComoHashMapList(const vector<Grupo>& grupos, unsigned int tamanio, bool porUltimaFila) {
+    vector<pair<pair<unsigned int, long long>, const Grupo*>> posiciones;
+    for (const Grupo& grupo : grupos) {
+        posiciones.push_back({{stringHash(grupo.template clave<0>()) % tamanio, filaDeOrden(grupo, porUltimaFila)}, &grupo});
+    }
+    sort(posiciones.begin(), posiciones.end(),
+         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    vector<const Grupo*> ordenados;
+    for (const auto& p : posiciones) ordenados.push_back(p.second);
+    return ordenados;
+}
+
+// Grupos con la misma clave externa, como un HashMapList interno
+template <class Grupo>
+struct GruposAnidados {
+    string clave;
+    vector<const Grupo*> internos;
+};
+
+// Grupos de clave (externa, interna) armados como
+// HashMapList<externa, HashMapList<interna, X>*>. A la tabla externa sólo se
+// le hacía put la primera vez, así que ahí cuenta la primera fila.
+template <class Grupo>
+vector<GruposAnidados<Grupo>> anidarComoHashMapList(const vector<Grupo>& grupos, unsigned int tamanioExterno,
+                                                    unsigned int tamanioInterno, bool internoPorUltimaFila) {
+    // getGrupos() viene en orden de primera aparición: el primer grupo de cada
+    // clave externa tiene la primera fila de esa clave
+    vector<GruposAnidados<Grupo>> anidados;
+    vector<long long> primeraFila;
+    unordered_map<string, size_t> indice;
+    for (const Grupo& grupo : grupos) {
+        const string& externa = grupo.template clave<0>();
+        auto it = indice.find(externa);
+        if (it == indice.end()) {
+            it = indice.emplace(externa, anidados.size()).first;
+            anidados.push_back({externa, {}});
+            primeraFila.push_back(grupo.primeraFila);
+        }
+        anidados[it->second].internos.push_back(&grupo);
+    }
+
+    for (GruposAnidados<Grupo>& a : anidados) {
+        sort(a.internos.begin(), a.internos.end(), [&](const Grupo* x, const Grupo* y) {
+            unsigned int bx = stringHash(x->template clave<1>()) % tamanioInterno;
+            unsigned int by = stringHash(y->template clave<1>()) % tamanioInterno;
+            if (bx != by) return bx < by;
+            return filaDeOrden(*x, internoPorUltimaFila) < filaDeOrden(*y, internoPorUltimaFila);
+        });
+    }
+
+    vector<size_t> orden(anidados.size());
+    for (size_t i = 0; i < orden.size(); ++i) orden[i] = i;
+    sort(orden.begin(), orden.end(), [&](size_t x, size_t y) {
+        unsigned int bx = stringHash(anidados[x].clave) % tamanioExterno;
+        unsigned int by = stringHash(anidados[y].clave) % tamanioExterno;
+        if (bx != by) return bx < by;
+        return primeraFila[x] < primeraFila[y];
+    });
+
+    vector<GruposAnidados<Grupo>> ordenados;
+    for (size_t i : orden) ordenados.push_back(move(anidados[i]));
+    return ordenados;
+}
+
+// --- Funciones de Análisis --
+// Cada calcular* es una plantilla sobre los agregados (Muestreo.h):
+// AgregacionExacta usa Suma y Conteo y AgregacionMuestral los estima sobre la
+// muestra de --approx. También lo es sobre el agrupamiento
+// (AgregacionExterna.h): AgrupacionEnMemoria recorre la lista y
+// AgrupacionEnDisco lee el CSV de --memoria con un presupuesto de memoria. La
+// versión sin plantilla elige según g_muestraVentas y g_fuenteEnDisco.
+
+// Top 5 de ciudades de cada país a partir de los montos ya agrupados por
+// (país, ciudad). También lo usan los agregados de --seguir (Seguimiento.h),
+// que agrupan las ventas a medida que llegan.
+template <class Agrupamiento>
+ResultadoTop5Ciudades resultadoTop5Ciudades(const Agrupamiento& ventasPorPaisCiudad) {
+    ResultadoTop5Ciudades resultado;
+    for (const auto& paisGrupos : anidarComoHashMapList(ventasPorPaisCiudad.getGrupos(), TAMANIO_HASH_PAISES, TAMANIO_HASH_CIUDADES, true)) {
+        CiudadesPais ciudadesPais;
+        ciudadesPais.pais = paisGrupos.clave;
+
+        vector<CiudadMonto> ciudadesMontos;
+        for (const auto* grupo : paisGrupos.internos) {
+            ciudadesMontos.push_back(CiudadMonto(grupo->template clave<1>(), grupo->template valor<0>(),
+                                                 static_cast<float>(grupo->template margen<0>())));
+        }
+
+        if (!ciudadesMontos.empty()) { g_condCounters.analizarTop5CiudadesPorPais_ifs++; 
+            quickSort(ciudadesMontos, 0, ciudadesMontos.size() - 1, compararCiudadesMonto);
+        }
+
+        int count = 0;
+        for (const auto& cm : ciudadesMontos) {
+            if (count < 5) { g_condCounters.analizarTop5CiudadesPorPais_ifs++; 
+                ciudadesPais.ciudades.push_back(cm);
+                count++;
+            } else { g_condCounters.analizarTop5CiudadesPorPais_ifs++;
+                break;
+            }
+        }
+        if (ciudadesMontos.empty()) { g_condCounters.analizarTop5CiudadesPorPais_ifs++;
+        }
+        resultado.paises.push_back(ciudadesPais);
+    }
+    return resultado;
+}
+
+template <class Agregacion, class Agrupacion = AgrupacionEnMemoria>
+ResultadoTop5Ciudades calcularTop5CiudadesPorPais(const Lista<Venta>& listaVentas) {
+    TemporizadorFase temporizador("analizarTop5CiudadesPorPais", "analisis", listaVentas.getTamanio());
+
+    typename Agrupacion::template Agrupamiento<Claves<ColumnaPais, ColumnaCiudad>, typename Agregacion::template Suma<ColumnaMonto>> ventasPorPaisCiudad;
+    Agrupacion::agrupar(ventasPorPaisCiudad, listaVentas);
+
+    ResultadoTop5Ciudades resultado = resultadoTop5Ciudades(ventasPorPaisCiudad);
+    resultado.muestra = Agregacion::resumen();
+    return resultado;
+}
+
+ResultadoTop5Ciudades calcularTop5CiudadesPorPais(const Lista<Venta>& listaVentas) {
+    if (g_muestraVentas != nullptr) return calcularTop5CiudadesPorPais<AgregacionMuestral>(listaVentas);
+    if (g_fuenteEnDisco != nullptr) return calcularTop5CiudadesPorPais<AgregacionExacta, AgrupacionEnDisco>(listaVentas);
+    return calcularTop5CiudadesPorPais<AgregacionExacta>(listaVentas);
+}
+
+void mostrarTop5CiudadesPorPais(const ResultadoTop5Ciudades& resultado, ostream& salida) {
+    salida << "\n--- TOP 5 DE CIUDADES CON MAYOR MONTO DE VENTAS POR PAIS ---\n";
+    mostrarMuestra(resultado.muestra, salida);
+    for (const CiudadesPais& ciudadesPais : resultado.paises) {
+        salida << "\nPais: " << ciudadesPais.pais << "\n";
+        salida << "--------------------------------\n";
+        for (size_t i = 0; i < ciudadesPais.ciudades.size(); ++i) {
+            const CiudadMonto& cm = ciudadesPais.ciudades[i];
+            salida << (i + 1) << ". Ciudad: " << cm.ciudad << ", Monto Total: $" << fijo2(cm.monto);
+            mostrarMargenMonto(resultado.muestra, cm.margen, salida);
+            salida << "\n";
+        }
+        if (ciudadesPais.ciudades.empty()) {
+            salida << "No hay datos de ventas para este pais.\n";
+        }
+    }
+}
+
+void escribirTop5CiudadesPorPais(const ResultadoTop5Ciudades& resultado, EscritorResultado& escritor) {
+    escritor.comenzarReporte("top5");
+    escritor.comenzarTabla("ciudades", columnasConMargen(resultado.muestra, {"pais", "posicion", "ciudad", "monto"}));
+    for (const CiudadesPais& ciudadesPais : resultado.paises) {
+        for (size_t i = 0; i < ciudadesPais.ciudades.size(); ++i) {
+            escritor.texto(ciudadesPais.pais);
+            escritor.entero(i + 1);
+            escritor.texto(ciudadesPais.ciudades[i].ciudad);
+            escritor.real(ciudadesPais.ciudades[i].monto);
+            escribirMargen(resultado.muestra, ciudadesPais.ciudades[i].margen, escritor);
+            escritor.terminarFila();
+        }
+    }
+    escritor.terminarTabla();
+    escribirMuestra(resultado.muestra, escritor);
+    escritor.terminarReporte();
+}
+
+void analizarTop5CiudadesPorPais(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    g_condCounters.analizarTop5CiudadesPorPais_ifs = 0; // Reiniciar contador para esta llamada
+    mostrarTop5CiudadesPorPais(calcularTop5CiudadesPorPais(listaVentas), salida);
+}
+
+void analizarTop5CiudadesPorPais(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    g_condCounters.analizarTop5CiudadesPorPais_ifs = 0;
+    escribirTop5CiudadesPorPais(calcularTop5CiudadesPorPais(listaVentas), escritor);
+}
+
+template <class Agregacion, class Agrupacion = AgrupacionEnMemoria>
+ResultadoMontoPorProductoPais calcularMontoTotalPorProductoPorPais(const Lista<Venta>& listaVentas) {
+    TemporizadorFase temporizador("analizarMontoTotalPorProductoPorPais", "analisis", listaVentas.getTamanio());
+
+    typename Agrupacion::template Agrupamiento<Claves<ColumnaPais, ColumnaProducto>, typename Agregacion::template Suma<ColumnaMonto>> productosPorPaisMontos;
+    Agrupacion::agrupar(productosPorPaisMontos, listaVentas);
+
+    ResultadoMontoPorProductoPais resultado;
+    resultado.muestra = Agregacion::resumen();
+    auto paisesConProductos = anidarComoHashMapList(productosPorPaisMontos.getGrupos(), TAMANIO_HASH_PAISES, TAMANIO_HASH_CIUDADES, true);
+
+    if (paisesConProductos.empty()) { g_condCounters.analizarMontoTotalPorProductoPorPais_ifs++; 
+    } else { g_condCounters.analizarMontoTotalPorProductoPorPais_ifs++; 
+        for (const auto& paisGrupos : paisesConProductos) {
+            ProductosPais productosPais;
+            productosPais.pais = paisGrupos.clave;
+            for (const auto* grupo : paisGrupos.internos) {
+                productosPais.productos.push_back({grupo->template clave<1>(), grupo->template valor<0>()});
+                productosPais.margenes.push_back(static_cast<float>(grupo->template margen<0>()));
+            }
+            g_condCounters.analizarMontoTotalPorProductoPorPais_ifs++; // vacío o no
+            resultado.paises.push_back(productosPais);
+        }
+    }
+    return resultado;
+}
+
+ResultadoMontoPorProductoPais calcularMontoTotalPorProductoPorPais(const Lista<Venta>& listaVentas) {
+    if (g_muestraVentas != nullptr) return calcularMontoTotalPorProductoPorPais<AgregacionMuestral>(listaVentas);
+    if (g_fuenteEnDisco != nullptr) return calcularMontoTotalPorProductoPorPais<AgregacionExacta, AgrupacionEnDisco>(listaVentas);
+    return calcularMontoTotalPorProductoPorPais<AgregacionExacta>(listaVentas);
+}
+
+void mostrarMontoTotalPorProductoPorPais(const ResultadoMontoPorProductoPais& resultado, ostream& salida) {
+    salida << "\n\n--- MONTO TOTAL VENDIDO POR PRODUCTO, DISCRIMINADO POR PAIS ---\n";
+    mostrarMuestra(resultado.muestra, salida);
+    if (resultado.paises.empty()) {
+        salida << "No se encontraron datos de ventas por producto y pais.\n";
+        return;
+    }
+    for (const ProductosPais& productosPais : resultado.paises) {
+        salida << "\nPais: " << productosPais.pais << "\n";
+        salida << "--------------------------------\n";
+        if (productosPais.productos.empty()) {
+            salida << "  No hay productos vendidos para este pais.\n";
+        }
+        for (size_t i = 0; i < productosPais.productos.size(); ++i) {
+            const auto& prodMonto = productosPais.productos[i];
+            salida << "  Producto: " << prodMonto.first << ", Monto Total Vendido: $"
+                 << fijo2(prodMonto.second);
+            mostrarMargenMonto(resultado.muestra, productosPais.margenes[i], salida);
+            salida << "\n";
+        }
+    }
+}
+
+void escribirMontoTotalPorProductoPorPais(const ResultadoMontoPorProductoPais& resultado, EscritorResultado& escritor) {
+    escritor.comenzarReporte("producto-pais");
+    escritor.comenzarTabla("productos", columnasConMargen(resultado.muestra, {"pais", "producto", "monto"}));
+    for (const ProductosPais& productosPais : resultado.paises) {
+        for (size_t i = 0; i < productosPais.productos.size(); ++i) {
+            escritor.texto(productosPais.pais);
+            escritor.texto(productosPais.productos[i].first);
+            escritor.real(productosPais.productos[i].second);
+            escribirMargen(resultado.muestra, productosPais.margenes[i], escritor);
+            escritor.terminarFila();
+        }
+    }
+    escritor.terminarTabla();
+    escribirMuestra(resultado.muestra, escritor);
+    escritor.terminarReporte();
+}
+
+void analizarMontoTotalPorProductoPorPais(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    g_condCounters.analizarMontoTotalPorProductoPorPais_ifs = 0; // Reiniciar contador
+    mostrarMontoTotalPorProductoPorPais(calcularMontoTotalPorProductoPorPais(listaVentas), salida);
+}
+
+void analizarMontoTotalPorProductoPorPais(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    g_condCounters.analizarMontoTotalPorProductoPorPais_ifs = 0;
+    escribirMontoTotalPorProductoPorPais(calcularMontoTotalPorProductoPorPais(listaVentas), escritor);
+}
+
+template <class Agregacion, class Agrupacion = AgrupacionEnMemoria>
+ResultadoPromedioPorCategoriaPais calcularPromedioVentasPorCategoriaPorPais(const Lista<Venta>& listaVentas) {
+    TemporizadorFase temporizador("analizarPromedioVentasPorCategoriaPorPais", "analisis", listaVentas.getTamanio());
+
+    // Países y categorías son pocos: matriz país x categoría
+    typename Agrupacion::template AgrupamientoDenso<Claves<ColumnaPais, ColumnaCategoria>,
+                                                    typename Agregacion::template Suma<ColumnaMonto>,
+                                                    typename Agregacion::template Suma<ColumnaCantidad>>
+        categoriasPorPais(UMBRAL_CLAVES_DENSAS);
+    Agrupacion::agrupar(categoriasPorPais, listaVentas);
+
+    ResultadoPromedioPorCategoriaPais resultado;
+    resultado.muestra = Agregacion::resumen();
+    // Las estadísticas de cada categoría se actualizaban en su lugar (sin
+    // remove+put): el orden interno es el de la primera venta
+    auto paisesConCategorias = anidarComoHashMapList(categoriasPorPais.getGrupos(), TAMANIO_HASH_PAISES, TAMANIO_HASH_CIUDADES, false);
+
+    if (paisesConCategorias.empty()) { g_condCounters.analizarPromedioVentasPorCategoriaPorPais_ifs++; 
+    } else { g_condCounters.analizarPromedioVentasPorCategoriaPorPais_ifs++; 
+        for (const auto& paisGrupos : paisesConCategorias) {
+            CategoriasPais categoriasPais;
+            categoriasPais.pais = paisGrupos.clave;
+            for (const auto* grupo : paisGrupos.internos) {
+                CategoriaEstadisticas stats(grupo->template valor<0>(), grupo->template valor<1>());
+                categoriasPais.categorias.push_back({grupo->template clave<1>(), stats.getPromedio()});
+                categoriasPais.margenes.push_back(static_cast<float>(
+                    margenCociente(stats.totalMonto, grupo->template margen<0>(), stats.totalCantidad, grupo->template margen<1>())));
+            }
+            g_condCounters.analizarPromedioVentasPorCategoriaPorPais_ifs++; // vacío o no
+            resultado.paises.push_back(categoriasPais);
+        }
+    }
+    return resultado;
+}
+
+ResultadoPromedioPorCategoriaPais calcularPromedioVentasPorCategoriaPorPais(const Lista<Venta>& listaVentas) {
+    if (g_muestraVentas != nullptr) return calcularPromedioVentasPorCategoriaPorPais<AgregacionMuestral>(listaVentas);
+    if (g_fuenteEnDisco != nullptr) return calcularPromedioVentasPorCategoriaPorPais<AgregacionExacta, AgrupacionEnDisco>(listaVentas);
+    return calcularPromedioVentasPorCategoriaPorPais<AgregacionExacta>(listaVentas);
+}
+
+void mostrarPromedioVentasPorCategoriaPorPais(const ResultadoPromedioPorCategoriaPais& resultado, ostream& salida) {
+    salida << "\n\n--- PROMEDIO DE VENTAS POR CATEGORIA EN CADA PAIS ---\n";
+    mostrarMuestra(resultado.muestra, salida);
+    if (resultado.paises.empty()) {
+        salida << "No se encontraron datos de ventas por categoria y pais.\n";
+        return;
+    }
+    for (const CategoriasPais& categoriasPais : resultado.paises) {
+        salida << "\nPais: " << categoriasPais.pais << "\n";
+        salida << "--------------------------------\n";
+        if (categoriasPais.categorias.empty()) {
+            salida << "  No hay categorias vendidas para este pais.\n";
+        }
+        for (size_t i = 0; i < categoriasPais.categorias.size(); ++i) {
+            const auto& catPromedio = categoriasPais.categorias[i];
+            salida << "  Categoria: " << catPromedio.first
+                 << ", Promedio de Ventas: $" << fijo2(catPromedio.second);
+            mostrarMargenMonto(resultado.muestra, categoriasPais.margenes[i], salida);
+            salida << "\n";
+        }
+    }
+}
+
+void escribirPromedioVentasPorCategoriaPorPais(const ResultadoPromedioPorCategoriaPais& resultado, EscritorResultado& escritor) {
+    escritor.comenzarReporte("categoria-pais");
+    escritor.comenzarTabla("categorias", columnasConMargen(resultado.muestra, {"pais", "categoria", "promedio"}));
+    for (const CategoriasPais& categoriasPais : resultado.paises) {
+        for (size_t i = 0; i < categoriasPais.categorias.size(); ++i) {
+            escritor.texto(categoriasPais.pais);
+            escritor.texto(categoriasPais.categorias[i].first);
+            escritor.real(categoriasPais.categorias[i].second);
+            escribirMargen(resultado.muestra, categoriasPais.margenes[i], escritor);
+            escritor.terminarFila();
+        }
+    }
+    escritor.terminarTabla();
+    escribirMuestra(resultado.muestra, escritor);
+    escritor.terminarReporte();
+}
+
+void analizarPromedioVentasPorCategoriaPorPais(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    g_condCounters.analizarPromedioVentasPorCategoriaPorPais_ifs = 0; // Reiniciar contador
+    mostrarPromedioVentasPorCategoriaPorPais(calcularPromedioVentasPorCategoriaPorPais(listaVentas), salida);
+}
+
+void analizarPromedioVentasPorCategoriaPorPais(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    g_condCounters.analizarPromedioVentasPorCategoriaPorPais_ifs = 0;
+    escribirPromedioVentasPorCategoriaPorPais(calcularPromedioVentasPorCategoriaPorPais(listaVentas), escritor);
+}
+
+// Medio de envío más usado de cada grupo (país o categoría), a partir de los
+// conteos por (grupo, medio). 'contador' es el contador de condicionales del
+// análisis que lo pide.
+template <class Grupo>
+ResultadoMedioEnvio medioMasUtilizadoPorGrupo(const vector<GruposAnidados<Grupo>>& gruposConEnvios, int& contador) {
+    ResultadoMedioEnvio resultado;
+
+    if (gruposConEnvios.empty()) { contador++; 
+    } else { contador++; 
+        for (const auto& grupoEnvios : gruposConEnvios) {
+            MedioEnvioGrupo medioGrupo;
+            medioGrupo.grupo = grupoEnvios.clave;
+
+            if (grupoEnvios.internos.empty()) { contador++; 
+            } else { contador++; 
+                medioGrupo.hayDatos = true;
+                for (const Grupo* metodoCount : grupoEnvios.internos) {
+                    if (metodoCount->template valor<0>() > medioGrupo.veces) { contador++; 
+                        medioGrupo.veces = metodoCount->template valor<0>();
+                        medioGrupo.medio = metodoCount->template clave<1>();
+                        medioGrupo.margen = static_cast<int>(llround(metodoCount->template margen<0>()));
+                    }
+                }
+            }
+            resultado.grupos.push_back(medioGrupo);
+        }
+    }
+    return resultado;
+}
+
+// 'grupo' es "Pais" o "Categoria"; 'sinDatos' y 'sinDatosGrupo' son los
+// mensajes para cuando no hay ventas o el grupo no tiene envíos
+void mostrarMedioEnvio(const ResultadoMedioEnvio& resultado, const string& titulo, const string& grupo,
+                       const string& sinDatos, const string& sinDatosGrupo, ostream& salida) {
+    salida << titulo;
+    mostrarMuestra(resultado.muestra, salida);
+    if (resultado.grupos.empty()) {
+        salida << sinDatos;
+        return;
+    }
+    for (const MedioEnvioGrupo& medioGrupo : resultado.grupos) {
+        salida << "\n" << grupo << ": " << medioGrupo.grupo << "\n";
+        salida << "--------------------------------\n";
+        if (!medioGrupo.hayDatos) {
+            salida << sinDatosGrupo;
+        } else {
+            salida << "  Medio mas utilizado: " << medioGrupo.medio
+                 << " (aparece " << medioGrupo.veces;
+            mostrarMargenConteo(resultado.muestra, medioGrupo.margen, salida);
+            salida << " veces)\n";
+        }
+    }
+}
+
+void escribirMedioEnvio(const ResultadoMedioEnvio& resultado, const string& reporte, const string& columnaGrupo,
+                        EscritorResultado& escritor) {
+    escritor.comenzarReporte(reporte);
+    escritor.comenzarTabla("medios", columnasConMargen(resultado.muestra, {columnaGrupo, "medio", "veces"}));
+    for (const MedioEnvioGrupo& medioGrupo : resultado.grupos) {
+        if (!medioGrupo.hayDatos) continue;
+        escritor.texto(medioGrupo.grupo);
+        escritor.texto(medioGrupo.medio);
+        escritor.entero(medioGrupo.veces);
+        escribirMargen(resultado.muestra, medioGrupo.margen, escritor);
+        escritor.terminarFila();
+    }
+    escritor.terminarTabla();
+    escribirMuestra(resultado.muestra, escritor);
+    escritor.terminarReporte();
+}
+
+template <class Agregacion, class Agrupacion = AgrupacionEnMemoria>
+ResultadoMedioEnvio calcularMedioEnvioMasUtilizadoPorPais(const Lista<Venta>& listaVentas) {
+    TemporizadorFase temporizador("analizarMedioEnvioMasUtilizadoPorPais", "analisis", listaVentas.getTamanio());
+
+    typename Agrupacion::template AgrupamientoDenso<Claves<ColumnaPais, ColumnaMedioEnvio>, typename Agregacion::Conteo> enviosPorPaisMetodo(UMBRAL_CLAVES_DENSAS);
+    Agrupacion::agrupar(enviosPorPaisMetodo, listaVentas);
+
+    ResultadoMedioEnvio resultado =
+        medioMasUtilizadoPorGrupo(anidarComoHashMapList(enviosPorPaisMetodo.getGrupos(), TAMANIO_HASH_PAISES, TAMANIO_HASH_CIUDADES, true),
+                                  g_condCounters.analizarMedioEnvioMasUtilizadoPorPais_ifs);
+    resultado.muestra = Agregacion::resumen();
+    return resultado;
+}
+
+ResultadoMedioEnvio calcularMedioEnvioMasUtilizadoPorPais(const Lista<Venta>& listaVentas) {
+    if (g_muestraVentas != nullptr) return calcularMedioEnvioMasUtilizadoPorPais<AgregacionMuestral>(listaVentas);
+    if (g_fuenteEnDisco != nullptr) return calcularMedioEnvioMasUtilizadoPorPais<AgregacionExacta, AgrupacionEnDisco>(listaVentas);
+    return calcularMedioEnvioMasUtilizadoPorPais<AgregacionExacta>(listaVentas);
+}
+
+void mostrarMedioEnvioMasUtilizadoPorPais(const ResultadoMedioEnvio& resultado, ostream& salida) {
+    mostrarMedioEnvio(resultado, "\n\n--- MEDIO DE ENVIO MAS UTILIZADO POR PAIS ---\n", "Pais",
+                      "No se encontraron datos de medios de envio por pais.\n",
+                      "  No hay medios de envio registrados para este pais.\n", salida);
+}
+
+void analizarMedioEnvioMasUtilizadoPorPais(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    g_condCounters.analizarMedioEnvioMasUtilizadoPorPais_ifs = 0; // Reiniciar contador
+    mostrarMedioEnvioMasUtilizadoPorPais(calcularMedioEnvioMasUtilizadoPorPais(listaVentas), salida);
+}
+
+void analizarMedioEnvioMasUtilizadoPorPais(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    g_condCounters.analizarMedioEnvioMasUtilizadoPorPais_ifs = 0;
+    escribirMedioEnvio(calcularMedioEnvioMasUtilizadoPorPais(listaVentas), "envio-pais", "pais", escritor);
+}
+
+template <class Agregacion, class Agrupacion = AgrupacionEnMemoria>
+ResultadoMedioEnvio calcularMedioEnvioMasUtilizadoPorCategoria(const Lista<Venta>& listaVentas) {
+    TemporizadorFase temporizador("analizarMedioEnvioMasUtilizadoPorCategoria", "analisis", listaVentas.getTamanio());
+
+    typename Agrupacion::template AgrupamientoDenso<Claves<ColumnaCategoria, ColumnaMedioEnvio>, typename Agregacion::Conteo> enviosPorCategoriaMetodo(UMBRAL_CLAVES_DENSAS);
+    Agrupacion::agrupar(enviosPorCategoriaMetodo, listaVentas);
+
+    ResultadoMedioEnvio resultado =
+        medioMasUtilizadoPorGrupo(anidarComoHashMapList(enviosPorCategoriaMetodo.getGrupos(), TAMANIO_HASH_CIUDADES, TAMANIO_HASH_CIUDADES, true),
+                                  g_condCounters.analizarMedioEnvioMasUtilizadoPorCategoria_ifs);
+    resultado.muestra = Agregacion::resumen();
+    return resultado;
+}
+
+ResultadoMedioEnvio calcularMedioEnvioMasUtilizadoPorCategoria(const Lista<Venta>& listaVentas) {
+    if (g_muestraVentas != nullptr) return calcularMedioEnvioMasUtilizadoPorCategoria<AgregacionMuestral>(listaVentas);
+    if (g_fuenteEnDisco != nullptr) return calcularMedioEnvioMasUtilizadoPorCategoria<AgregacionExacta, AgrupacionEnDisco>(listaVentas);
+    return calcularMedioEnvioMasUtilizadoPorCategoria<AgregacionExacta>(listaVentas);
+}
+
+void mostrarMedioEnvioMasUtilizadoPorCategoria(const ResultadoMedioEnvio& resultado, ostream& salida) {
+    mostrarMedioEnvio(resultado, "\n\n--- MEDIO DE ENVIO MAS UTILIZADO POR CATEGORIA ---\n", "Categoria",
+                      "No se encontraron datos de medios de envio por categoria.\n",
+                      "  No hay medios de envio registrados para esta categoria.\n", salida);
+}
+
+void analizarMedioEnvioMasUtilizadoPorCategoria(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    g_condCounters.analizarMedioEnvioMasUtilizadoPorCategoria_ifs = 0; // Reiniciar contador
+    mostrarMedioEnvioMasUtilizadoPorCategoria(calcularMedioEnvioMasUtilizadoPorCategoria(listaVentas), salida);
+}
+
+void analizarMedioEnvioMasUtilizadoPorCategoria(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    g_condCounters.analizarMedioEnvioMasUtilizadoPorCategoria_ifs = 0;
+    escribirMedioEnvio(calcularMedioEnvioMasUtilizadoPorCategoria(listaVentas), "envio-categoria", "categoria", escritor);
+}
+
+// Día de mayor monto, los mejores días y el mejor de cada país, a partir de
+// series por día (SerieDiaria.h). Las fechas se agrupan por día del
+// calendario: "5/9/2024" y "05/09/2024" son el mismo día, y las que no son
+// una fecha válida no cuentan.
+ResultadoDiaMayorVentas resultadoDiaMayorVentas(const SerieDiaria& global,
+                                                vector<pair<string, const SerieDiaria*>> paises) {
+    ResultadoDiaMayorVentas resultado;
+    for (long long dia : global.mejoresDias(CANTIDAD_MEJORES_DIAS)) {
+        resultado.mejoresDias.push_back({formatearDia(dia), static_cast<float>(global.dia(dia).monto)});
+    }
+    if (resultado.mejoresDias.empty()) { g_condCounters.analizarDiaMayorVentas_ifs++;
+        return resultado;
+    }
+    g_condCounters.analizarDiaMayorVentas_ifs++;
+    resultado.hayDatos = true;
+    resultado.dia = resultado.mejoresDias[0].dia;
+    resultado.monto = resultado.mejoresDias[0].monto;
+
+    sort(paises.begin(), paises.end(),
+         [](const pair<string, const SerieDiaria*>& a, const pair<string, const SerieDiaria*>& b) { return a.first < b.first; });
+    for (const auto& pais : paises) {
+        long long desde, hasta, dia;
+        TotalesDia totales;
+        if (pais.second == nullptr || !pais.second->tramo(desde, hasta)) continue;
+        if (pais.second->diaMayor(desde, hasta, dia, totales)) { g_condCounters.analizarDiaMayorVentas_ifs++;
+            resultado.mejorPorPais.push_back({pais.first, {formatearDia(dia), static_cast<float>(totales.monto)}});
+        }
+    }
+    return resultado;
+}
+
+// Con --approx: el monto de cada día (global y por país) se estima sobre la
+// muestra, los días se eligen con las mismas series y cada día informado
+// lleva el margen de su estimación
+ResultadoDiaMayorVentas estimarDiaMayorVentas(const Lista<Venta>& listaVentas, const MuestraVentas& muestra) {
+    unordered_map<long long, EstimadorTotal> porDia;
+    map<string, unordered_map<long long, EstimadorTotal>> porPaisDia;
+    for (Nodo<Venta>* nodo = listaVentas.getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+        const Venta& v = nodo->verDato();
+        long long dia;
+        if (!leerDia(v.fecha, dia)) continue;
+        uint32_t estrato = muestra.estrato(v);
+        porDia[dia].agregar(estrato, v.montoTotal);
+        porPaisDia[v.pais][dia].agregar(estrato, v.montoTotal);
+    }
+
+    SerieDiaria global;
+    for (const auto& d : porDia) global.sumar(d.first, TotalesDia(d.second.estimar(muestra).valor, 0, 1));
+    vector<SerieDiaria> seriesPaises(porPaisDia.size());
+    vector<pair<string, const SerieDiaria*>> paises;
+    for (const auto& pais : porPaisDia) {
+        SerieDiaria& serie = seriesPaises[paises.size()];
+        for (const auto& d : pais.second) serie.sumar(d.first, TotalesDia(d.second.estimar(muestra).valor, 0, 1));
+        paises.push_back({pais.first, &serie});
+    }
+
+    ResultadoDiaMayorVentas resultado = resultadoDiaMayorVentas(global, paises);
+    auto margenDe = [&](const unordered_map<long long, EstimadorTotal>& dias, const string& fecha) {
+        long long dia = 0;
+        leerDia(fecha, dia);
+        return static_cast<float>(dias.at(dia).estimar(muestra).margen);
+    };
+    for (DiaMonto& d : resultado.mejoresDias) d.margen = margenDe(porDia, d.dia);
+    for (auto& pais : resultado.mejorPorPais) pais.second.margen = margenDe(porPaisDia.at(pais.first), pais.second.dia);
+    resultado.muestra = AgregacionMuestral::resumen();
+    return resultado;
+}
+
+// Con --memoria no hay índice: las mismas series por día y los mismos
+// resúmenes de cuantiles se arman leyendo el CSV, con los países y las
+// categorías numerados como en el índice (sin distinguir mayúsculas, con el
+// nombre de su primera aparición), así que dan los mismos resultados. Ocupan
+// lo mismo que en el índice: dependen de los días y los países, no de las
+// ventas.
+class CodigosComoIndice {
+private:
+    unordered_map<string, uint32_t> codigoPorValor;
+    unordered_map<string, uint32_t> codigoPorClave;
+    vector<string> valores;
+
+public:
+    uint32_t codificar(const string& valor) {
+        auto it = codigoPorValor.find(valor);
+        if (it != codigoPorValor.end()) return it->second;
+        auto insertado = codigoPorClave.emplace(normalizarClaveIndice(valor), static_cast<uint32_t>(valores.size()));
+        if (insertado.second) valores.push_back(valor);
+        codigoPorValor.emplace(valor, insertado.first->second);
+        return insertado.first->second;
+    }
+
+    const string& valor(uint32_t codigo) const {
+        return valores[codigo];
+    }
+};
+
+ResultadoDiaMayorVentas calcularDiaMayorVentasEnDisco() {
+    CodigosComoIndice paises;
+    SeriesDiarias series;
+    recorrerVentasEnDisco([&](const Venta& v) {
+        uint32_t codigo = paises.codificar(v.pais);
+        long long dia;
+        if (leerDia(v.fecha, dia)) series.sumar(codigo, dia, TotalesDia(static_cast<double>(v.montoTotal), v.cantidad, 1));
+    });
+    vector<pair<string, const SerieDiaria*>> porPais;
+    for (uint32_t c = 0; c < series.getCantidadPaises(); ++c) porPais.push_back({paises.valor(c), series.pais(c)});
+    return resultadoDiaMayorVentas(series.getGlobal(), porPais);
+}
+
+ResultadoDiaMayorVentas calcularDiaMayorVentas(const Lista<Venta>& listaVentas) {
+    TemporizadorFase temporizador("analizarDiaMayorVentas", "analisis", listaVentas.getTamanio());
+    if (g_muestraVentas != nullptr) return estimarDiaMayorVentas(listaVentas, *g_muestraVentas);
+    if (g_fuenteEnDisco != nullptr) return calcularDiaMayorVentasEnDisco();
+
+    // El índice ya tiene los totales por día en un arreglo denso
+    shared_ptr<const IndiceVentas> indice = g_indicesVentas.obtener(listaVentas);
+    return resultadoDiaMayorVentas(indice->serieGlobal(), indice->seriesPorPais());
+}
+
+void mostrarDiaMayorVentas(const ResultadoDiaMayorVentas& resultado, ostream& salida) {
+    salida << "\n\n--- DIA CON MAYOR CANTIDAD DE VENTAS (POR MONTO DE DINERO) ---\n";
+    mostrarMuestra(resultado.muestra, salida);
+    if (!resultado.hayDatos) {
+        salida << "No se encontraron datos de ventas por dia.\n";
+    } else {
+        salida << "El dia con mayor cantidad de ventas fue: " << resultado.dia
+             << " con un monto total de: $" << fijo2(resultado.monto);
+        mostrarMargenMonto(resultado.muestra, resultado.mejoresDias[0].margen, salida);
+        salida << "\n";
+
+        salida << "\nDias con mayor monto de ventas:\n";
+        for (size_t i = 0; i < resultado.mejoresDias.size(); ++i) {
+            salida << (i + 1) << ". " << resultado.mejoresDias[i].dia << ": $" << fijo2(resultado.mejoresDias[i].monto);
+            mostrarMargenMonto(resultado.muestra, resultado.mejoresDias[i].margen, salida);
+            salida << "\n";
+        }
+
+        salida << "\nDia de mayor monto por pais:\n";
+        for (const auto& pais : resultado.mejorPorPais) {
+            salida << "  " << pais.first << ": " << pais.second.dia << " ($" << fijo2(pais.second.monto);
+            mostrarMargenMonto(resultado.muestra, pais.second.margen, salida);
+            salida << ")\n";
+        }
+    }
+}
+
+void escribirDiaMayorVentas(const ResultadoDiaMayorVentas& resultado, EscritorResultado& escritor) {
+    escritor.comenzarReporte("dia");
+    escritor.comenzarTabla("dia", columnasConMargen(resultado.muestra, {"fecha", "monto"}));
+    if (resultado.hayDatos) {
+        escritor.texto(resultado.dia);
+        escritor.real(resultado.monto);
+        escribirMargen(resultado.muestra, resultado.mejoresDias[0].margen, escritor);
+        escritor.terminarFila();
+    }
+    escritor.terminarTabla();
+
+    escritor.comenzarTabla("mejores_dias", columnasConMargen(resultado.muestra, {"posicion", "fecha", "monto"}));
+    for (size_t i = 0; i < resultado.mejoresDias.size(); ++i) {
+        escritor.entero(static_cast<long long>(i + 1));
+        escritor.texto(resultado.mejoresDias[i].dia);
+        escritor.real(resultado.mejoresDias[i].monto);
+        escribirMargen(resultado.muestra, resultado.mejoresDias[i].margen, escritor);
+        escritor.terminarFila();
+    }
+    escritor.terminarTabla();
+
+    escritor.comenzarTabla("por_pais", columnasConMargen(resultado.muestra, {"pais", "fecha", "monto"}));
+    for (const auto& pais : resultado.mejorPorPais) {
+        escritor.texto(pais.first);
+        escritor.texto(pais.second.dia);
+        escritor.real(pais.second.monto);
+        escribirMargen(resultado.muestra, pais.second.margen, escritor);
+        escritor.terminarFila();
+    }
+    escritor.terminarTabla();
+    escribirMuestra(resultado.muestra, escritor);
+    escritor.terminarReporte();
+}
+
+void analizarDiaMayorVentas(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    g_condCounters.analizarDiaMayorVentas_ifs = 0; // Reiniciar contador
+    mostrarDiaMayorVentas(calcularDiaMayorVentas(listaVentas), salida);
+}
+
+void analizarDiaMayorVentas(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    g_condCounters.analizarDiaMayorVentas_ifs = 0;
+    escribirDiaMayorVentas(calcularDiaMayorVentas(listaVentas), escritor);
+}
+
+// Producto más y menos vendido a partir de las cantidades ya agrupadas por
+// producto (también lo usan los agregados de --seguir)
+template <class Agrupamiento>
+ResultadoProductoMasYMenosVendido resultadoProductoMasYMenosVendido(const Agrupamiento& cantidadVendidaPorProducto) {
+    ResultadoProductoMasYMenosVendido resultado;
+    vector<const typename Agrupamiento::Grupo*> productosCantidades =
+        ordenarComoHashMapList(cantidadVendidaPorProducto.getGrupos(), TAMANIO_HASH_CIUDADES * 2, true);
+
+    if (productosCantidades.empty()) { g_condCounters.analizarProductoMasYMenosVendido_ifs++; 
+    } else { g_condCounters.analizarProductoMasYMenosVendido_ifs++;
+        resultado.hayDatos = true;
+        for (const auto* entry : productosCantidades) {
+            if (entry->template valor<0>() > resultado.cantidadMas) { g_condCounters.analizarProductoMasYMenosVendido_ifs++; 
+                resultado.cantidadMas = entry->template valor<0>();
+                resultado.masVendido = entry->template clave<0>();
+                resultado.margenMas = static_cast<int>(llround(entry->template margen<0>()));
+            }
+            if (entry->template valor<0>() < resultado.cantidadMenos) { g_condCounters.analizarProductoMasYMenosVendido_ifs++; 
+                resultado.cantidadMenos = entry->template valor<0>();
+                resultado.menosVendido = entry->template clave<0>();
+                resultado.margenMenos = static_cast<int>(llround(entry->template margen<0>()));
+            }
+        }
+    }
+    return resultado;
+}
+
+template <class Agregacion, class Agrupacion = AgrupacionEnMemoria>
+ResultadoProductoMasYMenosVendido calcularProductoMasYMenosVendido(const Lista<Venta>& listaVentas) {
+    TemporizadorFase temporizador("analizarProductoMasYMenosVendido", "analisis", listaVentas.getTamanio());
+
+    typename Agrupacion::template Agrupamiento<Claves<ColumnaProducto>, typename Agregacion::template Suma<ColumnaCantidad>> cantidadVendidaPorProducto;
+    Agrupacion::agrupar(cantidadVendidaPorProducto, listaVentas);
+
+    ResultadoProductoMasYMenosVendido resultado = resultadoProductoMasYMenosVendido(cantidadVendidaPorProducto);
+    resultado.muestra = Agregacion::resumen();
+    return resultado;
+}
+
+ResultadoProductoMasYMenosVendido calcularProductoMasYMenosVendido(const Lista<Venta>& listaVentas) {
+    if (g_muestraVentas != nullptr) return calcularProductoMasYMenosVendido<AgregacionMuestral>(listaVentas);
+    if (g_fuenteEnDisco != nullptr) return calcularProductoMasYMenosVendido<AgregacionExacta, AgrupacionEnDisco>(listaVentas);
+    return calcularProductoMasYMenosVendido<AgregacionExacta>(listaVentas);
+}
+
+void mostrarProductoMasYMenosVendido(const ResultadoProductoMasYMenosVendido& resultado, ostream& salida) {
+    salida << "\n\n--- PRODUCTO MAS VENDIDO Y MENOS VENDIDO EN CANTIDAD TOTAL (UNIDADES) ---\n";
+    mostrarMuestra(resultado.muestra, salida);
+    if (!resultado.hayDatos) {
+        salida << "No se encontraron datos de productos vendidos.\n";
+    } else {
+        salida << "El producto mas vendido en cantidad total fue: " << resultado.masVendido
+             << " con " << resultado.cantidadMas;
+        mostrarMargenConteo(resultado.muestra, resultado.margenMas, salida);
+        salida << " unidades vendidas.\n";
+        salida << "El producto menos vendido en cantidad total fue: " << resultado.menosVendido
+             << " con " << resultado.cantidadMenos;
+        mostrarMargenConteo(resultado.muestra, resultado.margenMenos, salida);
+        salida << " unidades vendidas.\n";
+    }
+}
+
+void escribirProductoMasYMenosVendido(const ResultadoProductoMasYMenosVendido& resultado, EscritorResultado& escritor) {
+    escritor.comenzarReporte("producto");
+    escritor.comenzarTabla("productos", columnasConMargen(resultado.muestra, {"tipo", "producto", "cantidad"}));
+    if (resultado.hayDatos) {
+        escritor.texto("mas_vendido");
+        escritor.texto(resultado.masVendido);
+        escritor.entero(resultado.cantidadMas);
+        escribirMargen(resultado.muestra, resultado.margenMas, escritor);
+        escritor.terminarFila();
+        escritor.texto("menos_vendido");
+        escritor.texto(resultado.menosVendido);
+        escritor.entero(resultado.cantidadMenos);
+        escribirMargen(resultado.muestra, resultado.margenMenos, escritor);
+        escritor.terminarFila();
+    }
+    escritor.terminarTabla();
+    escribirMuestra(resultado.muestra, escritor);
+    escritor.terminarReporte();
+}
+
+void analizarProductoMasYMenosVendido(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    g_condCounters.analizarProductoMasYMenosVendido_ifs = 0; // Reiniciar contador
+    mostrarProductoMasYMenosVendido(calcularProductoMasYMenosVendido(listaVentas), salida);
+}
+
+void analizarProductoMasYMenosVendido(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    g_condCounters.analizarProductoMasYMenosVendido_ifs = 0;
+    escribirProductoMasYMenosVendido(calcularProductoMasYMenosVendido(listaVentas), escritor);
+}
+
+// Percentiles p50/p90/p99 del monto de cada venta por categoría y por país,
+// leídos de los resúmenes KLL del índice (aproximados: ver Sketches.h). El
+// total combina los resúmenes de los países.
+PercentilesGrupo percentilesDe(const string& grupo, const ResumenCuantiles& cuantiles) {
+    vector<float> q = cuantiles.cuantiles({0.5, 0.9, 0.99});
+    return {grupo, static_cast<long long>(cuantiles.getCantidad()), cuantiles.getMinimo(), q[0], q[1], q[2],
+            cuantiles.getMaximo()};
+}
+
+vector<PercentilesGrupo> percentilesPorGrupo(const vector<pair<string, const ResumenCuantiles*>>& grupos) {
+    vector<PercentilesGrupo> resultado;
+    for (const auto& g : grupos) {
+        if (g.second->getCantidad() > 0) resultado.push_back(percentilesDe(g.first, *g.second));
+    }
+    sort(resultado.begin(), resultado.end(), [](const PercentilesGrupo& a, const PercentilesGrupo& b) {
+        return a.grupo < b.grupo;
+    });
+    return resultado;
+}
+
+// Montos de un grupo de la muestra con el peso de cada venta (N_h / n_h)
+struct MontosPonderados {
+    vector<pair<float, double>> montos; // (monto, peso)
+    EstimadorTotal ventas;
+};
+
+// Percentiles ponderados de un grupo de la muestra. El margen de cada uno
+// sale del intervalo de rangos q +/- 1,96 sqrt(q (1 - q) / n) (Woodruff),
+// con n el tamaño efectivo del grupo y la corrección por población finita.
+PercentilesGrupo percentilesEstimados(const string& grupo, MontosPonderados& m, const MuestraVentas& muestra) {
+    sort(m.montos.begin(), m.montos.end());
+    vector<double> acumulado;
+    double total = 0.0, cuadrados = 0.0;
+    for (const auto& x : m.montos) {
+        total += x.second;
+        cuadrados += x.second * x.second;
+        acumulado.push_back(total);
+    }
+    double efectivo = total * total / cuadrados;
+    double correccion = max(0.0, 1.0 - m.montos.size() / total);
+
+    auto cuantil = [&](double q) {
+        q = min(1.0, max(0.0, q));
+        size_t i = lower_bound(acumulado.begin(), acumulado.end(), q * total) - acumulado.begin();
+        return m.montos[min(i, m.montos.size() - 1)].first;
+    };
+    auto conMargen = [&](double q, float& margen) {
+        float valor = cuantil(q);
+        double delta = Z_CONFIANZA * sqrt(q * (1.0 - q) / efectivo * correccion);
+        margen = max(cuantil(q + delta) - valor, valor - cuantil(q - delta));
+        return valor;
+    };
+
+    Estimacion ventas = m.ventas.estimar(muestra);
+    PercentilesGrupo p{grupo, llround(ventas.valor), m.montos.front().first, 0.0f, 0.0f, 0.0f, m.montos.back().first};
+    p.margenVentas = llround(ventas.margen);
+    p.p50 = conMargen(0.5, p.margenP50);
+    p.p90 = conMargen(0.9, p.margenP90);
+    p.p99 = conMargen(0.99, p.margenP99);
+    return p;
+}
+
+// Con --approx los percentiles salen de la muestra, ordenando sus montos;
+// mínimo y máximo son los de la muestra
+ResultadoPercentilesMontos estimarPercentilesMontos(const Lista<Venta>& listaVentas, const MuestraVentas& muestra) {
+    unordered_map<string, MontosPonderados> categorias, paises;
+    MontosPonderados todas;
+    for (Nodo<Venta>* nodo = listaVentas.getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+        const Venta& v = nodo->verDato();
+        uint32_t estrato = muestra.estrato(v);
+        pair<float, double> monto(v.montoTotal, muestra.peso(estrato));
+        for (MontosPonderados* m : {&categorias[v.categoria], &paises[v.pais], &todas}) {
+            m->montos.push_back(monto);
+            m->ventas.agregar(estrato, 1.0);
+        }
+    }
+
+    auto porNombre = [&](unordered_map<string, MontosPonderados>& grupos) {
+        vector<PercentilesGrupo> resultado;
+        for (auto& g : grupos) resultado.push_back(percentilesEstimados(g.first, g.second, muestra));
+        sort(resultado.begin(), resultado.end(), [](const PercentilesGrupo& a, const PercentilesGrupo& b) {
+            return a.grupo < b.grupo;
+        });
+        return resultado;
+    };
+    ResultadoPercentilesMontos resultado;
+    resultado.categorias = porNombre(categorias);
+    resultado.paises = porNombre(paises);
+    if (!todas.montos.empty()) resultado.total = percentilesEstimados("Todas", todas, muestra);
+    resultado.muestra = AgregacionMuestral::resumen();
+    return resultado;
+}
+
+// Como cuantilesPor() del índice, leyendo el CSV de --memoria
+ResultadoPercentilesMontos calcularPercentilesMontosEnDisco() {
+    CodigosComoIndice codigosPais, codigosCategoria;
+    vector<ResumenCuantiles> cuantilesPais, cuantilesCategoria;
+    auto agregarA = [](vector<ResumenCuantiles>& cuantiles, uint32_t codigo, float monto) {
+        if (codigo >= cuantiles.size()) cuantiles.resize(codigo + 1);
+        cuantiles[codigo].agregar(monto);
+    };
+    recorrerVentasEnDisco([&](const Venta& v) {
+        agregarA(cuantilesPais, codigosPais.codificar(v.pais), v.montoTotal);
+        agregarA(cuantilesCategoria, codigosCategoria.codificar(v.categoria), v.montoTotal);
+    });
+    auto conNombres = [](const vector<ResumenCuantiles>& cuantiles, const CodigosComoIndice& codigos) {
+        vector<pair<string, const ResumenCuantiles*>> grupos;
+        for (uint32_t c = 0; c < cuantiles.size(); ++c) grupos.push_back({codigos.valor(c), &cuantiles[c]});
+        return grupos;
+    };
+
+    ResultadoPercentilesMontos resultado;
+    resultado.categorias = percentilesPorGrupo(conNombres(cuantilesCategoria, codigosCategoria));
+    resultado.paises = percentilesPorGrupo(conNombres(cuantilesPais, codigosPais));
+    ResumenCuantiles todas;
+    for (const ResumenCuantiles& pais : cuantilesPais) todas.combinar(pais);
+    if (todas.getCantidad() > 0) resultado.total = percentilesDe("Todas", todas);
+    return resultado;
+}
+
+ResultadoPercentilesMontos calcularPercentilesMontos(const Lista<Venta>& listaVentas) {
+    TemporizadorFase temporizador("analizarPercentilesMontos", "analisis", listaVentas.getTamanio());
+    if (g_muestraVentas != nullptr) return estimarPercentilesMontos(listaVentas, *g_muestraVentas);
+    if (g_fuenteEnDisco != nullptr) return calcularPercentilesMontosEnDisco();
+
+    shared_ptr<const IndiceVentas> indice = g_indicesVentas.obtener(listaVentas);
+    ResultadoPercentilesMontos resultado;
+    resultado.categorias = percentilesPorGrupo(indice->cuantilesPor(INDICE_CATEGORIA));
+    vector<pair<string, const ResumenCuantiles*>> paises = indice->cuantilesPor(INDICE_PAIS);
+    resultado.paises = percentilesPorGrupo(paises);
+    ResumenCuantiles todas;
+    for (const auto& pais : paises) todas.combinar(*pais.second);
+    if (todas.getCantidad() > 0) resultado.total = percentilesDe("Todas", todas);
+    return resultado;
+}
+
+void mostrarPercentilesMontos(const ResultadoPercentilesMontos& resultado, ostream& salida) {
+    salida << "\n\n--- PERCENTILES DEL MONTO POR VENTA (APROXIMADOS) ---\n";
+    mostrarMuestra(resultado.muestra, salida);
+    if (resultado.total.ventas == 0) {
+        salida << "No se encontraron datos de ventas.\n";
+        return;
+    }
+    const ResumenMuestra& muestra = resultado.muestra;
+    auto linea = [&](const PercentilesGrupo& g) {
+        salida << "  " << g.grupo << " (" << g.ventas;
+        mostrarMargenConteo(muestra, g.margenVentas, salida);
+        salida << " ventas): p50 $" << fijo2(g.p50);
+        mostrarMargenMonto(muestra, g.margenP50, salida);
+        salida << ", p90 $" << fijo2(g.p90);
+        mostrarMargenMonto(muestra, g.margenP90, salida);
+        salida << ", p99 $" << fijo2(g.p99);
+        mostrarMargenMonto(muestra, g.margenP99, salida);
+        salida << " (minimo $" << fijo2(g.minimo) << ", maximo $" << fijo2(g.maximo) << ")\n";
+    };
+    salida << "\nPor categoria:\n";
+    for (const PercentilesGrupo& g : resultado.categorias) linea(g);
+    salida << "\nPor pais:\n";
+    for (const PercentilesGrupo& g : resultado.paises) linea(g);
+    salida << "\nTodas las ventas:\n";
+    linea(resultado.total);
+}
+
+void escribirPercentilesMontos(const ResultadoPercentilesMontos& resultado, EscritorResultado& escritor) {
+    escritor.comenzarReporte("percentiles");
+    vector<string> columnas = {"agrupacion", "grupo", "ventas", "minimo", "p50", "p90", "p99", "maximo"};
+    if (resultado.muestra.estimado) {
+        columnas.insert(columnas.end(), {"margen_ventas", "margen_p50", "margen_p90", "margen_p99"});
+    }
+    escritor.comenzarTabla("percentiles", columnas);
+    auto fila = [&](const char* agrupacion, const PercentilesGrupo& g) {
+        escritor.texto(agrupacion);
+        escritor.texto(g.grupo);
+        escritor.entero(g.ventas);
+        escritor.real(g.minimo);
+        escritor.real(g.p50);
+        escritor.real(g.p90);
+        escritor.real(g.p99);
+        escritor.real(g.maximo);
+        if (resultado.muestra.estimado) {
+            escritor.entero(g.margenVentas);
+            escritor.real(g.margenP50);
+            escritor.real(g.margenP90);
+            escritor.real(g.margenP99);
+        }
+        escritor.terminarFila();
+    };
+    for (const PercentilesGrupo& g : resultado.categorias) fila("categoria", g);
+    for (const PercentilesGrupo& g : resultado.paises) fila("pais", g);
+    if (resultado.total.ventas > 0) fila("total", resultado.total);
+    escritor.terminarTabla();
+    escribirMuestra(resultado.muestra, escritor);
+    escritor.terminarReporte();
+}
+
+void analizarPercentilesMontos(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    mostrarPercentilesMontos(calcularPercentilesMontos(listaVentas), salida);
+}
+
+void analizarPercentilesMontos(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    escribirPercentilesMontos(calcularPercentilesMontos(listaVentas), escritor);
+}
+
+// Análisis disponibles por nombre (el de las órdenes "analyze"), en el orden
+// en que los corre realizarTodosLosAnalisis
+struct AnalisisDisponible {
+    const char* nombre;
+    void (*texto)(const Lista<Venta>&, ostream&);
+    void (*estructurado)(const Lista<Venta>&, EscritorResultado&);
+};
+
+const AnalisisDisponible ANALISIS_DISPONIBLES[] = {
+    {"top5", analizarTop5CiudadesPorPais, analizarTop5CiudadesPorPais},
+    {"producto-pais", analizarMontoTotalPorProductoPorPais, analizarMontoTotalPorProductoPorPais},
+    {"categoria-pais", analizarPromedioVentasPorCategoriaPorPais, analizarPromedioVentasPorCategoriaPorPais},
+    {"envio-pais", analizarMedioEnvioMasUtilizadoPorPais, analizarMedioEnvioMasUtilizadoPorPais},
+    {"envio-categoria", analizarMedioEnvioMasUtilizadoPorCategoria, analizarMedioEnvioMasUtilizadoPorCategoria},
+    {"dia", analizarDiaMayorVentas, analizarDiaMayorVentas},
+    {"producto", analizarProductoMasYMenosVendido, analizarProductoMasYMenosVendido},
+    {"percentiles", analizarPercentilesMontos, analizarPercentilesMontos},
+};
+
+// Función que realiza todos los análisis
+void realizarTodosLosAnalisis(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    for (const AnalisisDisponible& analisis : ANALISIS_DISPONIBLES) {
+        analisis.texto(listaVentas, salida);
+    }
+}
+
+void realizarTodosLosAnalisis(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    for (const AnalisisDisponible& analisis : ANALISIS_DISPONIBLES) {
+        analisis.estructurado(listaVentas, escritor);
+    }
+}
+
+#endif // ANALISIS_H
@@ -0,0 +1,480 @@
+#ifndef ANALISISAPROXIMADO_H
+#define ANALISISAPROXIMADO_H
+
+// Variantes aproximadas de los análisis, en memoria acotada.
+//
+// analizarTop5CiudadesPorPais y analizarProductoMasYMenosVendido agrupan con
+// una entrada por ciudad o producto, y contar clientes distintos por país
+// necesitaría una por cliente. SketchesVentas reemplaza esas tablas por los
+// resúmenes de Sketches.h:
+//   - por país: un HyperLogLog de clientes y un space-saving + Count-Min de
+//     ciudades pesadas por monto;
+//   - global: un HyperLogLog de clientes y un space-saving + Count-Min de
+//     productos pesados por unidades.
+// La memoria depende sólo de la cantidad de países (unos 70 KB cada uno), no
+// de las filas, ciudades, productos ni clientes.
+//
+// Los resúmenes se combinan: sketchesDesdeArchivos lee uno o más CSV en
+// tramos, un SketchesVentas por hilo, sin armar la lista, y al final los une.
+//
+// Los montos y unidades informados son la menor de las dos cotas superiores
+// (space-saving y Count-Min); el intervalo va del peso del contador menos su
+// error a esa cota. Mientras un resumen no reemplazó contadores (hubo como
+// mucho 64 ciudades en el país, 256 productos en total) sus valores son
+// exactos. El producto menos vendido sólo se puede informar en ese caso:
+// space-saving descarta justamente los de menor peso.
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Analisis.h"
+#include "CargaCSV.h"
+#include "Sketches.h"
+
+using namespace std;
+
+#define CONTADORES_CIUDADES_PAIS 64 // ciudades por país en el space-saving: error <= monto del país / 64
+#define CONTADORES_PRODUCTOS 256    // productos en el space-saving: error <= unidades totales / 256
+
+struct SketchesPais {
+    long long ventas = 0;
+    HyperLogLog clientes;
+    ResumenFrecuentes ciudades{CONTADORES_CIUDADES_PAIS}; // por monto
+    CountMin montoCiudades;
+};
+
+class SketchesVentas {
+private:
+    map<string, SketchesPais> paises; // por país tal como aparece
+    HyperLogLog clientes;             // de todos los países
+    ResumenFrecuentes productos{CONTADORES_PRODUCTOS}; // por unidades
+    CountMin cantidadProductos;
+    long long ventas = 0;
+
+public:
+    void agregar(const Venta& venta) {
+        SketchesPais& pais = paises[venta.pais];
+        uint64_t hashCliente = hashSketch(venta.cliente);
+        pais.ventas++;
+        pais.clientes.agregarHash(hashCliente);
+        pais.ciudades.agregar(venta.ciudad, venta.montoTotal);
+        pais.montoCiudades.agregar(venta.ciudad, venta.montoTotal);
+        clientes.agregarHash(hashCliente);
+        productos.agregar(venta.producto, venta.cantidad);
+        cantidadProductos.agregar(venta.producto, venta.cantidad);
+        ventas++;
+    }
+
+    void agregar(const Lista<Venta>& lista) {
+        for (Nodo<Venta>* nodo = lista.getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+            agregar(nodo->verDato());
+        }
+    }
+
+    // Une los resúmenes de otro conjunto de ventas (otro hilo u otro archivo)
+    void combinar(const SketchesVentas& otro) {
+        for (const auto& p : otro.paises) {
+            SketchesPais& pais = paises[p.first];
+            pais.ventas += p.second.ventas;
+            pais.clientes.combinar(p.second.clientes);
+            pais.ciudades.combinar(p.second.ciudades);
+            pais.montoCiudades.combinar(p.second.montoCiudades);
+        }
+        clientes.combinar(otro.clientes);
+        productos.combinar(otro.productos);
+        cantidadProductos.combinar(otro.cantidadProductos);
+        ventas += otro.ventas;
+    }
+
+    const map<string, SketchesPais>& getPaises() const {
+        return paises;
+    }
+
+    const HyperLogLog& getClientes() const {
+        return clientes;
+    }
+
+    const ResumenFrecuentes& getProductos() const {
+        return productos;
+    }
+
+    const CountMin& getCantidadProductos() const {
+        return cantidadProductos;
+    }
+
+    long long getVentas() const {
+        return ventas;
+    }
+
+    size_t getBytes() const {
+        size_t total = clientes.getBytes() + productos.getBytes() + cantidadProductos.getBytes();
+        for (const auto& p : paises) {
+            total += p.first.capacity() + sizeof(SketchesPais) + p.second.clientes.getBytes() +
+                     p.second.ciudades.getBytes() + p.second.montoCiudades.getBytes();
+        }
+        return total;
+    }
+};
+
+SketchesVentas calcularSketchesVentas(const Lista<Venta>& listaVentas) {
+    TemporizadorFase temporizador("calcularSketchesVentas", "analisis", listaVentas.getTamanio());
+    SketchesVentas sketches;
+    sketches.agregar(listaVentas);
+    return sketches;
+}
+
+// --- Lectura de CSV en tramos ---
+
+// Un tramo [inicio, fin) de bytes de un archivo: le tocan las líneas que
+// empiezan en él
+struct TramoCSV {
+    string archivo;
+    long long inicio;
+    long long fin;
+};
+
+// Agrega las ventas del tramo. Las líneas que no se pueden interpretar se
+// cuentan en 'descartadas'. Devuelve false si el archivo no se pudo abrir.
+bool agregarTramoCSV(const TramoCSV& tramo, SketchesVentas& sketches, long long& descartadas) {
+    ifstream archivo(tramo.archivo, ios::binary);
+    if (!archivo.is_open()) return false;
+    string linea;
+    long long posicion = tramo.inicio;
+    if (tramo.inicio == 0) {
+        getline(archivo, linea); // Saltear encabezado
+    } else {
+        // La línea que empieza antes del tramo es del tramo anterior
+        archivo.seekg(tramo.inicio - 1);
+        getline(archivo, linea);
+        posicion = tramo.inicio - 1;
+    }
+    posicion += static_cast<long long>(linea.size()) + 1;
+    while (posicion < tramo.fin && getline(archivo, linea)) {
+        posicion += static_cast<long long>(linea.size()) + 1;
+        if (linea.empty() || linea == "\r") continue;
+        try {
+            sketches.agregar(parsearLineaVenta(linea));
+        } catch (const exception&) {
+            descartadas++;
+        }
+    }
+    return true;
+}
+
+// Arma los resúmenes de uno o más CSV sin cargarlos en memoria: cada archivo
+// se parte en tramos que leen 'hilos' hilos, cada uno con su propio
+// SketchesVentas, y al final se combinan. Devuelve false (con 'error') si
+// algún archivo no se pudo abrir.
+bool sketchesDesdeArchivos(const vector<string>& archivos, unsigned hilos, SketchesVentas& resultado,
+                           long long& descartadas, string& error) {
+    TemporizadorFase temporizador("sketchesDesdeArchivos", "carga");
+    hilos = max(1u, hilos);
+    vector<TramoCSV> tramos;
+    for (const string& nombre : archivos) {
+        ifstream archivo(nombre, ios::binary | ios::ate);
+        if (!archivo.is_open()) {
+            error = "No se pudo abrir el archivo " + nombre + ".";
+            return false;
+        }
+        long long tamanio = static_cast<long long>(archivo.tellg());
+        for (unsigned i = 0; i < hilos; ++i) {
+            tramos.push_back({nombre, tamanio * i / hilos, tamanio * (i + 1) / hilos});
+        }
+    }
+
+    vector<SketchesVentas> parciales(hilos);
+    vector<long long> descartadasPorHilo(hilos, 0);
+    atomic<size_t> siguiente(0);
+    atomic<bool> fallo(false);
+    vector<thread> trabajadores;
+    for (unsigned h = 0; h < hilos; ++h) {
+        trabajadores.emplace_back([&, h]() {
+            for (size_t t = siguiente++; t < tramos.size(); t = siguiente++) {
+                if (!agregarTramoCSV(tramos[t], parciales[h], descartadasPorHilo[h])) fallo = true;
+            }
+        });
+    }
+    for (thread& t : trabajadores) t.join();
+    if (fallo) {
+        error = "No se pudo leer uno de los archivos.";
+        return false;
+    }
+
+    descartadas = 0;
+    for (unsigned h = 0; h < hilos; ++h) {
+        resultado.combinar(parciales[h]);
+        descartadas += descartadasPorHilo[h];
+    }
+    temporizador.setFilas(resultado.getVentas());
+    return true;
+}
+
+// --- Top 5 de ciudades por país ---
+
+struct CiudadAproximada {
+    string ciudad;
+    double monto;       // cota superior
+    double montoMinimo; // cota inferior
+};
+
+struct CiudadesPaisAproximado {
+    string pais;
+    bool exacto;
+    vector<CiudadAproximada> ciudades; // hasta 5, de mayor a menor monto
+};
+
+struct ResultadoTop5Aproximado {
+    vector<CiudadesPaisAproximado> paises; // por nombre
+};
+
+ResultadoTop5Aproximado calcularTop5CiudadesPorPaisAproximado(const SketchesVentas& sketches) {
+    ResultadoTop5Aproximado resultado;
+    for (const auto& p : sketches.getPaises()) {
+        CiudadesPaisAproximado pais;
+        pais.pais = p.first;
+        pais.exacto = p.second.ciudades.esExacto();
+        for (const ElementoFrecuente& e : p.second.ciudades.mayores(p.second.ciudades.getCapacidad())) {
+            double cota = min(e.peso, p.second.montoCiudades.estimar(e.clave));
+            pais.ciudades.push_back({e.clave, cota, e.peso - e.error});
+        }
+        // El Count-Min puede bajar la cota de una ciudad y cambiar el orden
+        sort(pais.ciudades.begin(), pais.ciudades.end(), [](const CiudadAproximada& a, const CiudadAproximada& b) {
+            if (a.monto != b.monto) return a.monto > b.monto;
+            return a.ciudad < b.ciudad;
+        });
+        if (pais.ciudades.size() > 5) pais.ciudades.resize(5);
+        resultado.paises.push_back(move(pais));
+    }
+    return resultado;
+}
+
+void mostrarTop5CiudadesPorPaisAproximado(const ResultadoTop5Aproximado& resultado, ostream& salida) {
+    salida << "\n--- TOP 5 DE CIUDADES CON MAYOR MONTO DE VENTAS POR PAIS (APROXIMADO) ---\n";
+    for (const CiudadesPaisAproximado& pais : resultado.paises) {
+        salida << "\nPais: " << pais.pais << (pais.exacto ? "" : " (aproximado)") << "\n";
+        salida << "--------------------------------\n";
+        for (size_t i = 0; i < pais.ciudades.size(); ++i) {
+            const CiudadAproximada& c = pais.ciudades[i];
+            salida << (i + 1) << ". Ciudad: " << c.ciudad << ", Monto Total: $" << fijo2(c.monto);
+            if (!pais.exacto) salida << " (minimo $" << fijo2(c.montoMinimo) << ")";
+            salida << "\n";
+        }
+    }
+}
+
+void escribirTop5CiudadesPorPaisAproximado(const ResultadoTop5Aproximado& resultado, EscritorResultado& escritor) {
+    escritor.comenzarReporte("top5-aprox");
+    escritor.comenzarTabla("ciudades", {"pais", "posicion", "ciudad", "monto", "monto_minimo", "exacto"});
+    for (const CiudadesPaisAproximado& pais : resultado.paises) {
+        for (size_t i = 0; i < pais.ciudades.size(); ++i) {
+            escritor.texto(pais.pais);
+            escritor.entero(i + 1);
+            escritor.texto(pais.ciudades[i].ciudad);
+            escritor.real(static_cast<float>(pais.ciudades[i].monto));
+            escritor.real(static_cast<float>(pais.ciudades[i].montoMinimo));
+            escritor.entero(pais.exacto);
+            escritor.terminarFila();
+        }
+    }
+    escritor.terminarTabla();
+    escritor.terminarReporte();
+}
+
+// --- Producto más y menos vendido ---
+
+struct ResultadoProductoAproximado {
+    bool hayDatos = false;
+    bool exacto = false;    // sin contadores reemplazados: también hay menos vendido
+    string masVendido;
+    long long cantidadMas = 0;
+    long long cantidadMasMinima = 0;
+    string menosVendido;
+    long long cantidadMenos = 0;
+    double cotaError = 0.0; // error máximo de cualquier producto
+};
+
+ResultadoProductoAproximado calcularProductoMasYMenosVendidoAproximado(const SketchesVentas& sketches) {
+    ResultadoProductoAproximado resultado;
+    const ResumenFrecuentes& productos = sketches.getProductos();
+    vector<ElementoFrecuente> orden = productos.mayores(productos.getCapacidad());
+    if (orden.empty()) return resultado;
+
+    resultado.hayDatos = true;
+    resultado.exacto = productos.esExacto();
+    resultado.cotaError = productos.cotaError();
+    const ElementoFrecuente* mas = nullptr;
+    double cotaMas = 0.0;
+    for (const ElementoFrecuente& e : orden) {
+        double cota = min(e.peso, sketches.getCantidadProductos().estimar(e.clave));
+        if (mas == nullptr || cota > cotaMas) {
+            mas = &e;
+            cotaMas = cota;
+        }
+    }
+    resultado.masVendido = mas->clave;
+    resultado.cantidadMas = llround(cotaMas);
+    resultado.cantidadMasMinima = llround(mas->peso - mas->error);
+    if (resultado.exacto) {
+        // 'orden' va de mayor a menor y, a igual cantidad, por nombre
+        const ElementoFrecuente* menos = &orden.back();
+        for (const ElementoFrecuente& e : orden) {
+            if (e.peso == menos->peso) { menos = &e; break; }
+        }
+        resultado.menosVendido = menos->clave;
+        resultado.cantidadMenos = llround(menos->peso);
+    }
+    return resultado;
+}
+
+void mostrarProductoMasYMenosVendidoAproximado(const ResultadoProductoAproximado& resultado, ostream& salida) {
+    salida << "\n\n--- PRODUCTO MAS VENDIDO Y MENOS VENDIDO EN CANTIDAD TOTAL (UNIDADES, APROXIMADO) ---\n";
+    if (!resultado.hayDatos) {
+        salida << "No se encontraron datos de productos vendidos.\n";
+        return;
+    }
+    salida << "El producto mas vendido en cantidad total fue: " << resultado.masVendido
+           << " con " << resultado.cantidadMas << " unidades vendidas";
+    if (!resultado.exacto) salida << " (minimo " << resultado.cantidadMasMinima << ")";
+    salida << ".\n";
+    if (resultado.exacto) {
+        salida << "El producto menos vendido en cantidad total fue: " << resultado.menosVendido
+               << " con " << resultado.cantidadMenos << " unidades vendidas.\n";
+    } else {
+        salida << "Hay mas de " << CONTADORES_PRODUCTOS << " productos distintos: el menos vendido no se puede "
+               << "determinar con el resumen (error maximo por producto: " << llround(resultado.cotaError)
+               << " unidades).\n";
+    }
+}
+
+void escribirProductoMasYMenosVendidoAproximado(const ResultadoProductoAproximado& resultado,
+                                                EscritorResultado& escritor) {
+    escritor.comenzarReporte("producto-aprox");
+    escritor.comenzarTabla("productos", {"tipo", "producto", "cantidad", "cantidad_minima"});
+    if (resultado.hayDatos) {
+        escritor.texto("mas_vendido");
+        escritor.texto(resultado.masVendido);
+        escritor.entero(resultado.cantidadMas);
+        escritor.entero(resultado.cantidadMasMinima);
+        escritor.terminarFila();
+        if (resultado.exacto) {
+            escritor.texto("menos_vendido");
+            escritor.texto(resultado.menosVendido);
+            escritor.entero(resultado.cantidadMenos);
+            escritor.entero(resultado.cantidadMenos);
+            escritor.terminarFila();
+        }
+    }
+    escritor.terminarTabla();
+    escritor.terminarReporte();
+}
+
+// --- Clientes distintos por país ---
+
+struct ClientesPais {
+    string pais;
+    long long ventas;
+    long long clientes; // estimado
+};
+
+struct ResultadoClientesAproximado {
+    vector<ClientesPais> paises; // por nombre
+    long long ventasTotales = 0;
+    long long clientesTotales = 0;
+    double errorRelativo = 0.0;
+};
+
+ResultadoClientesAproximado calcularClientesDistintosPorPais(const SketchesVentas& sketches) {
+    ResultadoClientesAproximado resultado;
+    for (const auto& p : sketches.getPaises()) {
+        resultado.paises.push_back({p.first, p.second.ventas, llround(p.second.clientes.estimar())});
+    }
+    resultado.ventasTotales = sketches.getVentas();
+    resultado.clientesTotales = llround(sketches.getClientes().estimar());
+    resultado.errorRelativo = sketches.getClientes().errorRelativo();
+    return resultado;
+}
+
+void mostrarClientesDistintosPorPais(const ResultadoClientesAproximado& resultado, ostream& salida) {
+    salida << "\n\n--- CLIENTES DISTINTOS POR PAIS (APROXIMADO, ERROR TIPICO "
+           << fijo2(static_cast<float>(resultado.errorRelativo * 100)) << "%) ---\n";
+    for (const ClientesPais& pais : resultado.paises) {
+        salida << "Pais: " << pais.pais << ", Clientes distintos: " << pais.clientes
+               << " (en " << pais.ventas << " ventas)\n";
+    }
+    salida << "Total (sin repetir clientes entre paises): " << resultado.clientesTotales
+           << " (en " << resultado.ventasTotales << " ventas)\n";
+}
+
+void escribirClientesDistintosPorPais(const ResultadoClientesAproximado& resultado, EscritorResultado& escritor) {
+    escritor.comenzarReporte("clientes-aprox");
+    escritor.comenzarTabla("clientes", {"pais", "ventas", "clientes"});
+    for (const ClientesPais& pais : resultado.paises) {
+        escritor.texto(pais.pais);
+        escritor.entero(pais.ventas);
+        escritor.entero(pais.clientes);
+        escritor.terminarFila();
+    }
+    escritor.texto("(total)");
+    escritor.entero(resultado.ventasTotales);
+    escritor.entero(resultado.clientesTotales);
+    escritor.terminarFila();
+    escritor.terminarTabla();
+    escritor.terminarReporte();
+}
+
+// --- Sobre la lista cargada ---
+
+void analizarTop5CiudadesPorPaisAproximado(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    mostrarTop5CiudadesPorPaisAproximado(calcularTop5CiudadesPorPaisAproximado(calcularSketchesVentas(listaVentas)), salida);
+}
+
+void analizarTop5CiudadesPorPaisAproximado(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    escribirTop5CiudadesPorPaisAproximado(calcularTop5CiudadesPorPaisAproximado(calcularSketchesVentas(listaVentas)), escritor);
+}
+
+void analizarProductoMasYMenosVendidoAproximado(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    mostrarProductoMasYMenosVendidoAproximado(
+        calcularProductoMasYMenosVendidoAproximado(calcularSketchesVentas(listaVentas)), salida);
+}
+
+void analizarProductoMasYMenosVendidoAproximado(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    escribirProductoMasYMenosVendidoAproximado(
+        calcularProductoMasYMenosVendidoAproximado(calcularSketchesVentas(listaVentas)), escritor);
+}
+
+void analizarClientesDistintosPorPais(const Lista<Venta>& listaVentas, ostream& salida = cout) {
+    mostrarClientesDistintosPorPais(calcularClientesDistintosPorPais(calcularSketchesVentas(listaVentas)), salida);
+}
+
+void analizarClientesDistintosPorPais(const Lista<Venta>& listaVentas, EscritorResultado& escritor) {
+    escribirClientesDistintosPorPais(calcularClientesDistintosPorPais(calcularSketchesVentas(listaVentas)), escritor);
+}
+
+// Análisis aproximados por nombre ("analyze top5-aprox"...). No forman parte
+// de "analyze all".
+const AnalisisDisponible ANALISIS_APROXIMADOS[] = {
+    {"top5-aprox", analizarTop5CiudadesPorPaisAproximado, analizarTop5CiudadesPorPaisAproximado},
+    {"producto-aprox", analizarProductoMasYMenosVendidoAproximado, analizarProductoMasYMenosVendidoAproximado},
+    {"clientes-aprox", analizarClientesDistintosPorPais, analizarClientesDistintosPorPais},
+};
+
+// Los tres reportes a partir de resúmenes ya armados (por ejemplo, con
+// sketchesDesdeArchivos)
+void mostrarReportesAproximados(const SketchesVentas& sketches, ostream& salida) {
+    mostrarTop5CiudadesPorPaisAproximado(calcularTop5CiudadesPorPaisAproximado(sketches), salida);
+    mostrarProductoMasYMenosVendidoAproximado(calcularProductoMasYMenosVendidoAproximado(sketches), salida);
+    mostrarClientesDistintosPorPais(calcularClientesDistintosPorPais(sketches), salida);
+}
+
+void escribirReportesAproximados(const SketchesVentas& sketches, EscritorResultado& escritor) {
+    escribirTop5CiudadesPorPaisAproximado(calcularTop5CiudadesPorPaisAproximado(sketches), escritor);
+    escribirProductoMasYMenosVendidoAproximado(calcularProductoMasYMenosVendidoAproximado(sketches), escritor);
+    escribirClientesDistintosPorPais(calcularClientesDistintosPorPais(sketches), escritor);
+}
+
+#endif // ANALISISAPROXIMADO_H
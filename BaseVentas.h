@@ -0,0 +1,71 @@
+#ifndef BASEVENTAS_H
+#define BASEVENTAS_H
+
+// Dataset versionado con copia en escritura.
+//
+// Los lectores fijan la versión vigente con fijar() y trabajan sobre ella sin
+// tomar ningún lock: la versión es inmutable mientras la tengan. Un escritor
+// copia la versión vigente, aplica el cambio sobre la copia y la publica de
+// forma atómica; los lectores que ya tenían la anterior la siguen viendo
+// entera, nunca un cambio a medio aplicar. Cada versión se libera cuando el
+// último lector que la tenía suelta su shared_ptr (al estilo RCU).
+//
+// Los escritores se serializan entre sí con un mutex. La copia es O(n), del
+// mismo orden que recorrer la lista para ubicar la venta a modificar. Cada
+// versión es una lista nueva para RegistroIndices, así que si la vigente
+// tenía índice se copia también (RegistroIndices::heredar) y el cambio lo
+// actualiza, en lugar de reconstruirlo en la primera consulta.
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "Venta.h"
+#include "Lista.h"
+#include "Metricas.h"
+#include "IndiceVentas.h"
+
+using namespace std;
+
+struct VersionVentas {
+    Lista<Venta> ventas;
+    unsigned long long epoca = 0; // se incrementa con cada versión publicada
+};
+
+class BaseVentas {
+private:
+    shared_ptr<const VersionVentas> vigente;
+    mutex mtxEscritura;
+
+public:
+    // Toma posesión de una versión inicial ya cargada (por ejemplo desde el CSV)
+    explicit BaseVentas(shared_ptr<VersionVentas> inicial) : vigente(move(inicial)) {}
+
+    // Versión vigente; se mantiene válida mientras se conserve el puntero
+    shared_ptr<const VersionVentas> fijar() const {
+        return atomic_load(&vigente);
+    }
+
+    // Aplica 'cambio' sobre una copia de la versión vigente. Si 'cambio'
+    // devuelve true la copia se publica como nueva versión; si no, se descarta.
+    template <class Cambio>
+    bool modificar(Cambio cambio) {
+        lock_guard<mutex> lock(mtxEscritura);
+        shared_ptr<const VersionVentas> actual = atomic_load(&vigente);
+        shared_ptr<VersionVentas> nueva;
+        {
+            TemporizadorFase temporizador("snapshot/copia", "gestion");
+            nueva = make_shared<VersionVentas>(*actual);
+        }
+        g_indicesVentas.heredar(actual->ventas, nueva->ventas);
+        if (!cambio(nueva->ventas)) {
+            g_indicesVentas.descartar(nueva->ventas);
+            return false;
+        }
+        nueva->epoca = actual->epoca + 1;
+        atomic_store(&vigente, shared_ptr<const VersionVentas>(move(nueva)));
+        return true;
+    }
+};
+
+#endif // BASEVENTAS_H
@@ -0,0 +1,158 @@
+#ifndef CACHECONSULTAS_H
+#define CACHECONSULTAS_H
+
+// Caché de resultados de consultas.
+//
+// Las consultas que agregan (comparar países o productos, productos por
+// encima/debajo de un umbral) se repiten mucho con los mismos parámetros y
+// cada una vuelve a recorrer la lista. CacheConsultas guarda el resultado ya
+// calculado (la estructura Resultado*, antes de escribirla en texto, JSON o
+// CSV) bajo una clave canónica: el nombre de la consulta y sus argumentos
+// normalizados.
+//
+// Cada resultado recuerda la época de la lista con la que se calculó: su
+// identidad y su versión (Lista::getIdentidad/getVersion). Toda alta, baja o
+// modificación avanza la versión, igual que la carga o el WAL, así que un
+// resultado de otra época nunca se sirve: se descarta y se recalcula. En modo
+// servidor cada escritura publica una lista nueva, con otra identidad.
+//
+// El tamaño se acota con MAXIMO_BYTES_CACHE_CONSULTAS: al pasarse se
+// desalojan los resultados usados hace más tiempo (LRU). Los listados por
+// ciudad o por rango no se guardan: su resultado son las filas mismas.
+
+#include <atomic>
+#include <cstdio>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "Lista.h"
+#include "Venta.h"
+
+using namespace std;
+
+#define MAXIMO_BYTES_CACHE_CONSULTAS (8 * 1024 * 1024)
+
+// Clave canónica: la consulta y sus argumentos separados por \x1f (no puede
+// aparecer en un argumento leído de una línea)
+inline string claveConsulta(const char* consulta, initializer_list<string> argumentos) {
+    string clave = consulta;
+    for (const string& a : argumentos) {
+        clave += '\x1f';
+        clave += a;
+    }
+    return clave;
+}
+
+// Un umbral en la clave: 500, 500.0 y 500.00 son el mismo float
+inline string claveUmbral(float umbral) {
+    char texto[32];
+    snprintf(texto, sizeof(texto), "%.9g", umbral);
+    return texto;
+}
+
+class CacheConsultas {
+private:
+    struct Entrada {
+        string clave;
+        unsigned long long identidad;
+        unsigned long long version;
+        shared_ptr<const void> resultado;
+        size_t bytes;
+    };
+
+    mutex mtx;
+    list<Entrada> entradas; // la más usada primero
+    unordered_map<string, list<Entrada>::iterator> porClave;
+    size_t bytes = 0;
+    size_t maximoBytes;
+    atomic<bool> habilitada{true};
+
+    unsigned long long aciertos = 0;
+    unsigned long long fallos = 0;
+    unsigned long long invalidadas = 0; // fallos por un resultado de otra época
+    unsigned long long desalojadas = 0;
+
+    // Requiere tener el mutex
+    void quitar(list<Entrada>::iterator it) {
+        bytes -= it->bytes;
+        porClave.erase(it->clave);
+        entradas.erase(it);
+    }
+
+public:
+    explicit CacheConsultas(size_t maximo = MAXIMO_BYTES_CACHE_CONSULTAS) : maximoBytes(maximo) {}
+
+    // Copia en 'resultado' el de 'clave' para la época actual de la lista o,
+    // si no está, lo calcula con calcular(resultado) y lo guarda. calcular
+    // devuelve false si la consulta no es válida (por ejemplo el mismo país
+    // dos veces); eso no se guarda. bytesResultado(T) estima su tamaño.
+    template <class T, class Calcular>
+    bool obtener(const Lista<Venta>& lista, const string& clave, T& resultado, Calcular calcular) {
+        unsigned long long identidad = lista.getIdentidad(), version = lista.getVersion();
+        if (!habilitada) return calcular(resultado);
+        {
+            lock_guard<mutex> lock(mtx);
+            auto it = porClave.find(clave);
+            if (it != porClave.end()) {
+                Entrada& e = *it->second;
+                if (e.identidad == identidad && e.version == version) {
+                    aciertos++;
+                    entradas.splice(entradas.begin(), entradas, it->second);
+                    resultado = *static_pointer_cast<const T>(e.resultado);
+                    return true;
+                }
+                invalidadas++;
+                quitar(it->second);
+            }
+            fallos++;
+        }
+
+        // Se calcula sin el mutex: otra consulta puede usar la caché mientras
+        if (!calcular(resultado)) return false;
+        size_t tamanio = sizeof(Entrada) + clave.size() * 2 + bytesResultado(resultado);
+
+        lock_guard<mutex> lock(mtx);
+        if (!habilitada || tamanio > maximoBytes) return true;
+        auto it = porClave.find(clave);
+        if (it != porClave.end()) quitar(it->second); // otro hilo lo calculó a la vez
+        entradas.push_front(Entrada{clave, identidad, version, make_shared<const T>(resultado), tamanio});
+        porClave[clave] = entradas.begin();
+        bytes += tamanio;
+        while (bytes > maximoBytes) {
+            desalojadas++;
+            quitar(prev(entradas.end()));
+        }
+        return true;
+    }
+
+    // Sin caché cada consulta se calcula siempre (para medirlas)
+    void setHabilitada(bool h) {
+        lock_guard<mutex> lock(mtx);
+        habilitada = h;
+        if (!habilitada) {
+            entradas.clear();
+            porClave.clear();
+            bytes = 0;
+        }
+    }
+
+    void imprimirResumen(ostream& out) {
+        lock_guard<mutex> lock(mtx);
+        unsigned long long consultas = aciertos + fallos;
+        out << "\n--- Cache de consultas ---\n";
+        out << "Aciertos: " << aciertos << ", fallos: " << fallos << " (" << invalidadas
+            << " por cambios en las ventas)";
+        if (consultas > 0) out << ", tasa de aciertos " << (100.0 * aciertos / consultas) << "%";
+        out << "\nResultados guardados: " << entradas.size() << " (" << bytes << " bytes), desalojados: "
+            << desalojadas << "\n";
+    }
+} g_cacheConsultas;
+
+#endif // CACHECONSULTAS_H
@@ -0,0 +1,159 @@
+#ifndef CARGACSV_H
+#define CARGACSV_H
+
+#include <charconv>     // Para to_chars (floats con la menor cantidad de dígitos)
+#include <fstream>      // Para operaciones con archivos (ifstream)
+#include <sstream>      // Para manipulación de strings como streams (stringstream)
+#include <string>
+#include <vector>
+
+#include "Venta.h"
+#include "Lista.h"
+#include "Metricas.h"
+
+// Convierte una línea del CSV en una Venta. El archivo original usa fin de
+// línea CRLF, por lo que se descarta el '\r' final del último campo.
+Venta parsearLineaVenta(const string& linea) {
+    char delimitador = ',';
+    stringstream stream(linea);
+    string ID_Venta_str, Fecha, Pais, Ciudad, Cliente, Producto, Categoria,
+           Cantidad_str, Precio_Unitario_str, Monto_Total_str, Medio_Envio, Estado_Envio;
+
+    getline(stream, ID_Venta_str, delimitador);
+    getline(stream, Fecha, delimitador);
+    getline(stream, Pais, delimitador);
+    getline(stream, Ciudad, delimitador);
+    getline(stream, Cliente, delimitador);
+    getline(stream, Producto, delimitador);
+    getline(stream, Categoria, delimitador);
+    getline(stream, Cantidad_str, delimitador);
+    getline(stream, Precio_Unitario_str, delimitador);
+    getline(stream, Monto_Total_str, delimitador);
+    getline(stream, Medio_Envio, delimitador);
+    getline(stream, Estado_Envio, delimitador);
+
+    if (!Estado_Envio.empty() && Estado_Envio.back() == '\r') {
+        Estado_Envio.pop_back();
+    }
+
+    int cantidad = stoi(Cantidad_str);
+    float precioUnitario = stof(Precio_Unitario_str);
+    float montoTotal = stof(Monto_Total_str);
+
+    return Venta(ID_Venta_str, Fecha, Pais, Ciudad, Cliente, Producto, Categoria,
+                 cantidad, precioUnitario, montoTotal, Medio_Envio, Estado_Envio);
+}
+
+// Carga todas las ventas del archivo CSV al final de la lista.
+// Devuelve false si el archivo no se pudo abrir.
+// Las líneas se procesan en lotes para medir por separado lectura, parseo e
+// inserción sin tomar tiempos en cada fila. Esas subfases van en la categoría
+// "detalle": ya están dentro de carga/total.
+bool cargarVentasCSV(const string& nombreArchivo, Lista<Venta>& listaVentas) {
+    TemporizadorFase temporizadorTotal("carga/total", "carga");
+    const size_t TAMANIO_LOTE = 4096;
+
+    ifstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    AcumuladorFase lectura("carga/lectura", "detalle");
+    AcumuladorFase parseo("carga/parseo", "detalle");
+    AcumuladorFase insercion("carga/insercion", "detalle");
+    long long filas = 0;
+
+    vector<string> lineas(TAMANIO_LOTE);
+    vector<Venta> ventas;
+    ventas.reserve(TAMANIO_LOTE);
+
+    string linea;
+    getline(archivo, linea); // Saltear encabezado
+
+    bool quedanLineas = true;
+    while (quedanLineas) {
+        lectura.iniciar();
+        size_t enLote = 0;
+        while (enLote < TAMANIO_LOTE && getline(archivo, lineas[enLote])) {
+            enLote++;
+        }
+        quedanLineas = enLote == TAMANIO_LOTE;
+        lectura.detener();
+
+        parseo.iniciar();
+        ventas.clear();
+        for (size_t i = 0; i < enLote; ++i) {
+            ventas.push_back(parsearLineaVenta(lineas[i]));
+        }
+        parseo.detener();
+
+        insercion.iniciar();
+        for (const Venta& v : ventas) {
+            listaVentas.insertarUltimo(v);
+        }
+        insercion.detener();
+        filas += enLote;
+    }
+    archivo.close();
+
+    lectura.registrar(filas);
+    parseo.registrar(filas);
+    insercion.registrar(filas);
+    temporizadorTotal.setFilas(filas);
+    return true;
+}
+
+// Recorre las ventas del CSV sin guardarlas: llama a 'funcion' con cada una,
+// en el orden del archivo. Las líneas vacías se saltean. Devuelve false si el
+// archivo no se pudo abrir.
+template <class Funcion>
+bool recorrerVentasCSV(const string& nombreArchivo, Funcion funcion) {
+    ifstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    string linea;
+    getline(archivo, linea); // Saltear encabezado
+    while (getline(archivo, linea)) {
+        if (linea.empty() || linea == "\r") continue;
+        funcion(parsearLineaVenta(linea));
+    }
+    return true;
+}
+
+// Escribe un float con los dígitos justos para releerlo igual (66.74, no 66.7399979)
+void escribirFloatCSV(ostream& out, float valor) {
+    char texto[32];
+    to_chars_result r = to_chars(texto, texto + sizeof(texto), valor);
+    out.write(texto, r.ptr - texto);
+}
+
+// Guarda la lista con el mismo formato que el CSV original (encabezado y
+// fin de línea CRLF), de modo que cargarVentasCSV la lea sin cambios.
+// Devuelve false si el archivo no se pudo escribir.
+bool guardarVentasCSV(const string& nombreArchivo, const Lista<Venta>& listaVentas) {
+    // Lo llama el checkpoint, que ya se mide entero como wal/checkpoint
+    TemporizadorFase temporizador("carga/guardar", "detalle");
+    ofstream archivo(nombreArchivo, ios::binary);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    archivo << "ID_Venta,Fecha,Pais,Ciudad,Cliente,Producto,Categoria,Cantidad,"
+            << "Precio_Unitario,Monto_Total,Medio_Envio,Estado_Envio\r\n";
+    long long filas = 0;
+    for (Nodo<Venta>* nodo = listaVentas.getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+        Venta v = nodo->getDato();
+        archivo << v.idVenta << ',' << v.fecha << ',' << v.pais << ',' << v.ciudad << ','
+                << v.cliente << ',' << v.producto << ',' << v.categoria << ',' << v.cantidad << ',';
+        escribirFloatCSV(archivo, v.precioUnitario);
+        archivo << ',';
+        escribirFloatCSV(archivo, v.montoTotal);
+        archivo << ',' << v.medioEnvio << ',' << v.estadoEnvio << "\r\n";
+        filas++;
+    }
+    temporizador.setFilas(filas);
+    archivo.close();
+    return !archivo.fail();
+}
+
+#endif // CARGACSV_H
@@ -0,0 +1,979 @@
+#ifndef CONSULTAS_H
+#define CONSULTAS_H
+
+// Consultas dinámicas sobre la lista de ventas. Cada consulta tiene una
+// versión que recibe sus parámetros y escribe en un ostream (usada por el modo
+// batch), otra que entrega el resultado a un EscritorResultado (JSON/CSV) y
+// una versión interactiva que los pide por consola.
+//
+// Las consultas que agregan pasan por g_cacheConsultas (CacheConsultas.h):
+// repetir una con los mismos argumentos sobre las mismas ventas no vuelve a
+// recorrer la lista.
+
+#include "Analisis.h"
+#include "SalidaReporte.h"
+#include "CacheConsultas.h"
+
+// --- Funciones de Consultas Dinámicas ---
+
+// Recorre las ventas de una ciudad y llama a 'alEncontrar' con cada una.
+// Devuelve cuántas encontró. Los listados se escriben a medida que se
+// recorren, sin juntar las ventas en memoria.
+template <typename AlEncontrar>
+long long recorrerVentasPorCiudad(const Lista<Venta>& listaVentas, const string& ciudadBuscar, AlEncontrar alEncontrar) {
+    string ciudadBuscarNormalizada = normalizeString(ciudadBuscar);
+
+    TemporizadorFase temporizador("listarVentasPorCiudad", "consulta", listaVentas.getTamanio());
+
+    long long encontradas = 0;
+    // Recorre los nodos: con getDato(i) listar un millón de filas sería cuadrático
+    for (Nodo<Venta>* nodo = listaVentas.getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+        Venta ventaActual = nodo->getDato();
+        string ciudadVentaNormalizada = normalizeString(ventaActual.ciudad);
+
+        if (ciudadVentaNormalizada == ciudadBuscarNormalizada) { 
+            alEncontrar(ventaActual);
+            encontradas++;
+        }
+    }
+    return encontradas;
+}
+
+// Función para listar las ventas realizadas en una ciudad específica
+void listarVentasPorCiudad(const Lista<Venta>& listaVentas, const string& ciudadBuscar, ostream& salida) {
+    salida << "\nVentas en '" << ciudadBuscar << "':\n";
+    salida << "--------------------------------------------------\n";
+    long long encontradas = recorrerVentasPorCiudad(listaVentas, ciudadBuscar, [&salida](const Venta& venta) {
+        venta.mostrar(salida);
+        salida << "--------------------------------------------------\n";
+    });
+
+    if (encontradas == 0) { g_condCounters.listarVentasPorCiudad_ifs++; 
+        salida << "No se encontraron ventas en la ciudad '" << ciudadBuscar << "'.\n";
+    }
+}
+
+void listarVentasPorCiudad(const Lista<Venta>& listaVentas, const string& ciudadBuscar, EscritorResultado& escritor) {
+    escritor.comenzarReporte("city");
+    escritor.comenzarTabla("ventas", COLUMNAS_VENTA);
+    recorrerVentasPorCiudad(listaVentas, ciudadBuscar, [&escritor](const Venta& venta) {
+        escribirFilaVenta(escritor, venta);
+    });
+    escritor.terminarTabla();
+    escritor.terminarReporte();
+}
+
+// Versión interactiva: pide los parámetros por consola
+void listarVentasPorCiudad(const Lista<Venta>& listaVentas) {
+    g_condCounters.listarVentasPorCiudad_ifs = 0; // Reiniciar contador
+    cout << "\n--- LISTADO DE VENTAS POR CIUDAD ---\n";
+    cout << "Ingrese el nombre de la ciudad a buscar (o 'cancelar' para volver): ";
+    string ciudadBuscar;
+    getline(cin, ciudadBuscar);
+
+    if (ciudadBuscar == "cancelar") { g_condCounters.listarVentasPorCiudad_ifs++; 
+        cout << "Operacion de listado cancelada." << endl;
+        return;
+    }
+
+    ReporteBuffereado reporte(cout); // se vuelca entero al terminar la consulta
+    listarVentasPorCiudad(listaVentas, ciudadBuscar, cout);
+}
+
+struct RangoFechas {
+    int d_inicio, m_inicio, y_inicio;
+    int d_fin, m_fin, y_fin;
+};
+
+// Valida las dos fechas del rango; si no sirven, deja el motivo en 'error'
+bool leerRangoFechas(const string& fechaInicioStr, const string& fechaFinStr, RangoFechas& rango, string& error) {
+    if (!parseDate(fechaInicioStr, rango.d_inicio, rango.m_inicio, rango.y_inicio) ||
+        !parseDate(fechaFinStr, rango.d_fin, rango.m_fin, rango.y_fin)) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; 
+        error = "Fecha invalida. Use el formato DD/MM/AAAA.";
+        return false;
+    }
+
+    // Validar que la fecha de inicio no sea posterior a la fecha de fin
+    if (compareDates(rango.d_inicio, rango.m_inicio, rango.y_inicio, rango.d_fin, rango.m_fin, rango.y_fin) > 0) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; 
+        error = "La fecha de inicio no puede ser posterior a la fecha de fin. Operacion cancelada.";
+        return false;
+    }
+    return true;
+}
+
+// Recorre las ventas de un país dentro del rango y llama a 'alEncontrar' con
+// cada una. Devuelve cuántas encontró. El índice por país da las filas del
+// país; sólo de ésas se leen y comparan las fechas.
+template <typename AlEncontrar>
+long long recorrerVentasPorRangoFechasPorPais(const Lista<Venta>& listaVentas, const RangoFechas& rango, const string& paisBuscar, AlEncontrar alEncontrar) {
+    TemporizadorFase temporizador("listarVentasPorRangoFechasPorPais", "consulta", listaVentas.getTamanio());
+
+    shared_ptr<const IndiceVentas> indice = g_indicesVentas.obtener(listaVentas);
+    const BitmapRoaring* filasPais = indice->filas(INDICE_PAIS, paisBuscar);
+    if (filasPais == nullptr) return 0;
+
+    long long encontradas = 0;
+    indice->recorrer(*filasPais, [&](const Venta& ventaActual) {
+        int d_venta, m_venta, y_venta;
+        if (!parseDate(ventaActual.fecha, d_venta, m_venta, y_venta)) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; 
+            // Si la fecha de la venta es inválida, la saltamos
+            return;
+        }
+
+        // Comprobar si la fecha de la venta está dentro del rango
+        if (compareDates(d_venta, m_venta, y_venta, rango.d_inicio, rango.m_inicio, rango.y_inicio) >= 0 && // Venta es posterior o igual a fecha de inicio
+            compareDates(d_venta, m_venta, y_venta, rango.d_fin, rango.m_fin, rango.y_fin) <= 0) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; // Venta es anterior o igual a fecha de fin
+            alEncontrar(ventaActual);
+            encontradas++;
+        }
+    });
+    return encontradas;
+}
+
+// Función para listar ventas realizadas en un rango de fechas por país
+void listarVentasPorRangoFechasPorPais(const Lista<Venta>& listaVentas, const string& fechaInicioStr, const string& fechaFinStr, const string& paisBuscar, ostream& salida) {
+    RangoFechas rango;
+    string error;
+    if (!leerRangoFechas(fechaInicioStr, fechaFinStr, rango, error)) {
+        salida << error << "\n";
+        return;
+    }
+
+    salida << "\nVentas en " << paisBuscar << " entre " << fechaInicioStr << " y " << fechaFinStr << ":\n";
+    salida << "--------------------------------------------------\n";
+    long long encontradas = recorrerVentasPorRangoFechasPorPais(listaVentas, rango, paisBuscar, [&salida](const Venta& venta) {
+        venta.mostrar(salida);
+        salida << "--------------------------------------------------\n";
+    });
+
+    if (encontradas == 0) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; 
+        salida << "No se encontraron ventas para " << paisBuscar << " en el rango de fechas especificado.\n";
+    }
+}
+
+// Versión estructurada: un rango inválido es un error de la orden
+bool listarVentasPorRangoFechasPorPais(const Lista<Venta>& listaVentas, const string& fechaInicioStr, const string& fechaFinStr, const string& paisBuscar,
+                                       EscritorResultado& escritor, string& error) {
+    RangoFechas rango;
+    if (!leerRangoFechas(fechaInicioStr, fechaFinStr, rango, error)) return false;
+
+    escritor.comenzarReporte("range");
+    escritor.comenzarTabla("ventas", COLUMNAS_VENTA);
+    recorrerVentasPorRangoFechasPorPais(listaVentas, rango, paisBuscar, [&escritor](const Venta& venta) {
+        escribirFilaVenta(escritor, venta);
+    });
+    escritor.terminarTabla();
+    escritor.terminarReporte();
+    return true;
+}
+
+// Versión interactiva: pide los parámetros por consola
+void listarVentasPorRangoFechasPorPais(const Lista<Venta>& listaVentas) {
+    g_condCounters.listarVentasPorRangoFechasPorPais_ifs = 0; // Reiniciar contador
+
+    cout << "\n--- LISTADO DE VENTAS POR RANGO DE FECHAS Y PAIS ---\n";
+    
+    string fechaInicioStr, fechaFinStr, paisBuscar;
+    int d_inicio, m_inicio, y_inicio;
+    int d_fin, m_fin, y_fin;
+
+    // Pedir fecha de inicio
+    cout << "Ingrese la fecha de inicio (DD/MM/AAAA) o 'cancelar' para volver: ";
+    getline(cin, fechaInicioStr);
+    if (fechaInicioStr == "cancelar") { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; cout << "Operacion cancelada." << endl; return; } 
+    while (!parseDate(fechaInicioStr, d_inicio, m_inicio, y_inicio)) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; 
+        cout << "Fecha de inicio invalida. Ingrese en formato DD/MM/AAAA: ";
+        getline(cin, fechaInicioStr);
+        if (fechaInicioStr == "cancelar") { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; cout << "Operacion cancelada." << endl; return; } 
+    }
+
+    // Pedir fecha de fin
+    cout << "Ingrese la fecha de fin (DD/MM/AAAA) o 'cancelar' para volver: ";
+    getline(cin, fechaFinStr);
+    if (fechaFinStr == "cancelar") { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; cout << "Operacion cancelada." << endl; return; } 
+    while (!parseDate(fechaFinStr, d_fin, m_fin, y_fin)) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; 
+        cout << "Fecha de fin invalida. Ingrese en formato DD/MM/AAAA: ";
+        getline(cin, fechaFinStr);
+        if (fechaFinStr == "cancelar") { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; cout << "Operacion cancelada." << endl; return; } 
+    }
+
+    // Validar que la fecha de inicio no sea posterior a la fecha de fin
+    if (compareDates(d_inicio, m_inicio, y_inicio, d_fin, m_fin, y_fin) > 0) { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; 
+        cout << "La fecha de inicio no puede ser posterior a la fecha de fin. Operacion cancelada." << endl;
+        return;
+    }
+
+    // Pedir pais
+    cout << "Ingrese el pais a buscar (o 'cancelar' para volver): ";
+    getline(cin, paisBuscar);
+    if (paisBuscar == "cancelar") { g_condCounters.listarVentasPorRangoFechasPorPais_ifs++; cout << "Operacion cancelada." << endl; return; }
+
+    ReporteBuffereado reporte(cout);
+    listarVentasPorRangoFechasPorPais(listaVentas, fechaInicioStr, fechaFinStr, paisBuscar, cout);
+}
+
+// --- Totales por rango de fechas ---
+
+// Los totales salen de las series por día que mantiene el índice
+// (SerieDiaria.h): no se recorren las ventas ni se leen sus fechas. Las
+// fechas aceptan día y mes de uno o dos dígitos; las ventas con una fecha que
+// no es del calendario no entran en ningún rango.
+
+enum AgrupacionFechas { AGRUPAR_TOTAL, AGRUPAR_SEMANA, AGRUPAR_MES };
+
+// Totales de un período [desde, hasta]
+struct TotalesPeriodo {
+    long long desde, hasta;
+    TotalesDia totales;
+};
+
+struct ResultadoTotalesFechas {
+    string pais; // vacío: todos los países
+    long long desde = 0, hasta = 0;
+    AgrupacionFechas agrupacion = AGRUPAR_TOTAL;
+    TotalesDia total;
+    bool hayDiaMayor = false;
+    long long diaMayor = 0;
+    TotalesDia totalesDiaMayor;
+    vector<TotalesPeriodo> periodos; // por semana o por mes
+};
+
+bool calcularTotalesPorFechas(const Lista<Venta>& listaVentas, const string& fechaInicioStr, const string& fechaFinStr,
+                              const string& paisBuscar, AgrupacionFechas agrupacion,
+                              ResultadoTotalesFechas& resultado, string& error) {
+    if (!leerDia(fechaInicioStr, resultado.desde) || !leerDia(fechaFinStr, resultado.hasta)) {
+        error = "Fecha invalida. Use el formato D/M/AAAA.";
+        return false;
+    }
+    if (resultado.desde > resultado.hasta) {
+        error = "La fecha de inicio no puede ser posterior a la fecha de fin.";
+        return false;
+    }
+
+    TemporizadorFase temporizador("totalesPorFechas", "consulta", listaVentas.getTamanio());
+    shared_ptr<const IndiceVentas> indice = g_indicesVentas.obtener(listaVentas);
+    resultado.pais = paisBuscar;
+    resultado.agrupacion = agrupacion;
+    const SerieDiaria* serie = paisBuscar.empty() ? &indice->serieGlobal() : indice->seriePais(paisBuscar);
+    SerieDiaria vacia;
+    if (serie == nullptr) serie = &vacia;
+
+    resultado.total = serie->rango(resultado.desde, resultado.hasta);
+    resultado.hayDiaMayor = serie->diaMayor(resultado.desde, resultado.hasta, resultado.diaMayor, resultado.totalesDiaMayor);
+
+    if (agrupacion != AGRUPAR_TOTAL) {
+        long long inicio = agrupacion == AGRUPAR_SEMANA ? lunesDeLaSemana(resultado.desde) : primeroDelMes(resultado.desde);
+        while (inicio <= resultado.hasta) {
+            long long siguiente = agrupacion == AGRUPAR_SEMANA ? inicio + 7 : primeroDelMes(inicio + 31);
+            TotalesPeriodo periodo;
+            periodo.desde = max(inicio, resultado.desde);
+            periodo.hasta = min(siguiente - 1, resultado.hasta);
+            periodo.totales = serie->rango(periodo.desde, periodo.hasta);
+            resultado.periodos.push_back(periodo);
+            inicio = siguiente;
+        }
+    }
+    return true;
+}
+
+void mostrarTotalesPorFechas(const ResultadoTotalesFechas& r, ostream& salida) {
+    string donde = r.pais.empty() ? "todos los paises" : r.pais;
+    salida << "\nTotales de ventas en " << donde << " entre " << formatearDia(r.desde) << " y " << formatearDia(r.hasta) << ":\n";
+    salida << "--------------------------------------------------\n";
+    if (!r.periodos.empty()) {
+        salida << (r.agrupacion == AGRUPAR_SEMANA ? "Por semana:\n" : "Por mes:\n");
+        for (const TotalesPeriodo& p : r.periodos) {
+            salida << "  " << formatearDia(p.desde) << " - " << formatearDia(p.hasta) << ": "
+                   << p.totales.ventas << " ventas, " << p.totales.cantidad << " unidades, $" << fijo2(p.totales.monto) << "\n";
+        }
+        salida << "Total: ";
+    }
+    salida << r.total.ventas << " ventas, " << r.total.cantidad << " unidades, $" << fijo2(r.total.monto) << "\n";
+    if (r.hayDiaMayor) {
+        salida << "Dia de mayor monto: " << formatearDia(r.diaMayor) << " ($" << fijo2(r.totalesDiaMayor.monto) << ")\n";
+    } else {
+        salida << "No se encontraron ventas en el rango de fechas especificado.\n";
+    }
+    salida << "--------------------------------------------------\n";
+}
+
+void escribirTotalesPorFechas(const ResultadoTotalesFechas& r, EscritorResultado& escritor) {
+    escritor.comenzarReporte("totals");
+    escritor.comenzarTabla("periodos", {"desde", "hasta", "ventas", "cantidad", "monto"});
+    auto fila = [&escritor](long long desde, long long hasta, const TotalesDia& t) {
+        escritor.texto(formatearDia(desde));
+        escritor.texto(formatearDia(hasta));
+        escritor.entero(t.ventas);
+        escritor.entero(t.cantidad);
+        escritor.real(static_cast<float>(t.monto));
+        escritor.terminarFila();
+    };
+    for (const TotalesPeriodo& p : r.periodos) fila(p.desde, p.hasta, p.totales);
+    fila(r.desde, r.hasta, r.total);
+    escritor.terminarTabla();
+
+    escritor.comenzarTabla("dia_mayor", {"fecha", "monto"});
+    if (r.hayDiaMayor) {
+        escritor.texto(formatearDia(r.diaMayor));
+        escritor.real(static_cast<float>(r.totalesDiaMayor.monto));
+        escritor.terminarFila();
+    }
+    escritor.terminarTabla();
+    escritor.terminarReporte();
+}
+
+// Totales de ventas entre dos fechas, de un país o de todos (pais vacío)
+void totalesPorFechas(const Lista<Venta>& listaVentas, const string& fechaInicioStr, const string& fechaFinStr,
+                      const string& paisBuscar, AgrupacionFechas agrupacion, ostream& salida) {
+    ResultadoTotalesFechas resultado;
+    string error;
+    if (!calcularTotalesPorFechas(listaVentas, fechaInicioStr, fechaFinStr, paisBuscar, agrupacion, resultado, error)) {
+        salida << error << "\n";
+        return;
+    }
+    mostrarTotalesPorFechas(resultado, salida);
+}
+
+bool totalesPorFechas(const Lista<Venta>& listaVentas, const string& fechaInicioStr, const string& fechaFinStr,
+                      const string& paisBuscar, AgrupacionFechas agrupacion, EscritorResultado& escritor, string& error) {
+    ResultadoTotalesFechas resultado;
+    if (!calcularTotalesPorFechas(listaVentas, fechaInicioStr, fechaFinStr, paisBuscar, agrupacion, resultado, error)) return false;
+    escribirTotalesPorFechas(resultado, escritor);
+    return true;
+}
+
+// Versión interactiva: pide los parámetros por consola
+void totalesPorFechas(const Lista<Venta>& listaVentas) {
+    cout << "\n--- TOTALES DE VENTAS EN UN RANGO DE FECHAS ---\n";
+    string fechaInicioStr, fechaFinStr, paisBuscar, agrupacionStr;
+
+    cout << "Ingrese la fecha de inicio (D/M/AAAA) o 'cancelar' para volver: ";
+    getline(cin, fechaInicioStr);
+    if (fechaInicioStr == "cancelar") { cout << "Operacion cancelada." << endl; return; }
+
+    cout << "Ingrese la fecha de fin (D/M/AAAA) o 'cancelar' para volver: ";
+    getline(cin, fechaFinStr);
+    if (fechaFinStr == "cancelar") { cout << "Operacion cancelada." << endl; return; }
+
+    cout << "Ingrese el pais (vacio para todos) o 'cancelar' para volver: ";
+    getline(cin, paisBuscar);
+    if (paisBuscar == "cancelar") { cout << "Operacion cancelada." << endl; return; }
+
+    cout << "Agrupar por (total, semana, mes): ";
+    getline(cin, agrupacionStr);
+    AgrupacionFechas agrupacion = AGRUPAR_TOTAL;
+    if (agrupacionStr == "semana") agrupacion = AGRUPAR_SEMANA;
+    else if (agrupacionStr == "mes") agrupacion = AGRUPAR_MES;
+
+    ReporteBuffereado reporte(cout);
+    totalesPorFechas(listaVentas, fechaInicioStr, fechaFinStr, paisBuscar, agrupacion, cout);
+}
+
+struct ResultadoComparacionPaises {
+    string pais1, pais2;
+    float monto1, monto2;
+    vector<pair<string, float>> topProductos1, topProductos2; // vacío si el país no tiene ventas
+    pair<string, int> medioEnvio1, medioEnvio2;             // ("N/A", 0) si no tiene ventas
+};
+
+// 'gruposVisitados' suma los productos y medios de envío recorridos en el
+// cubo para elegir el mayor de cada país
+bool calcularComparacionPaises(const Lista<Venta>& listaVentas, const string& pais1_str, const string& pais2_str,
+                               ResultadoComparacionPaises& resultado, string& error, long long& gruposVisitados) {
+    string pais1Normalizado = normalizeString(pais1_str);
+    string pais2Normalizado = normalizeString(pais2_str);
+
+    if (pais1Normalizado == pais2Normalizado) { g_condCounters.compararDosPaises_ifs++; 
+        error = "Los paises ingresados son el mismo. Por favor, ingrese dos paises diferentes.";
+        return false;
+    }
+
+    shared_ptr<const IndiceVentas> indice = g_indicesVentas.obtener(listaVentas);
+    for (const string* pais : {&pais1_str, &pais2_str}) {
+        const ResumenPais* resumen = indice->resumenPais(*pais);
+        if (resumen != nullptr) gruposVisitados += resumen->productos.getGrupos().size() + resumen->medios.getGrupos().size();
+    }
+
+    resultado.pais1 = pais1_str;
+    resultado.pais2 = pais2_str;
+    resultado.monto1 = obtenerMontoTotalPais(listaVentas, pais1_str);
+    resultado.monto2 = obtenerMontoTotalPais(listaVentas, pais2_str);
+    resultado.topProductos1 = obtenerProductosMasVendidosPais(listaVentas, pais1_str, 1); 
+    resultado.topProductos2 = obtenerProductosMasVendidosPais(listaVentas, pais2_str, 1);
+    resultado.medioEnvio1 = obtenerMedioEnvioMasUsadoPais(listaVentas, pais1_str);
+    resultado.medioEnvio2 = obtenerMedioEnvioMasUsadoPais(listaVentas, pais2_str);
+    return true;
+}
+
+size_t bytesResultado(const ResultadoComparacionPaises& r) {
+    size_t bytes = sizeof(r) + r.pais1.size() + r.pais2.size() + r.medioEnvio1.first.size() + r.medioEnvio2.first.size();
+    for (const auto& p : r.topProductos1) bytes += sizeof(p) + p.first.size();
+    for (const auto& p : r.topProductos2) bytes += sizeof(p) + p.first.size();
+    return bytes;
+}
+
+// calcularComparacionPaises a través de la caché de consultas. El
+// temporizador mide también los aciertos, con 0 filas.
+bool obtenerComparacionPaises(const Lista<Venta>& listaVentas, const string& pais1_str, const string& pais2_str,
+                              ResultadoComparacionPaises& resultado, string& error) {
+    TemporizadorFase temporizador("compararDosPaises", "consulta");
+    long long visitados = 0;
+    string clave = claveConsulta("compare-countries", {normalizeString(pais1_str), normalizeString(pais2_str)});
+    bool ok = g_cacheConsultas.obtener(listaVentas, clave, resultado, [&](ResultadoComparacionPaises& r) {
+        return calcularComparacionPaises(listaVentas, pais1_str, pais2_str, r, error, visitados);
+    });
+    temporizador.setFilas(visitados);
+    if (!ok) return false;
+    // El guardado pudo pedirse con otras mayúsculas: se muestran las de ahora
+    resultado.pais1 = pais1_str;
+    resultado.pais2 = pais2_str;
+    return true;
+}
+
+void mostrarComparacionPaises(const ResultadoComparacionPaises& r, ostream& salida) {
+    const string& pais1_str = r.pais1;
+    const string& pais2_str = r.pais2;
+
+    salida << "\n--- Resultados de la comparacion entre " << pais1_str << " y " << pais2_str << " ---\n";
+
+    // a. Monto total de ventas
+    salida << "\n1. Monto total de ventas:\n";
+    salida << "   " << pais1_str << ": $" << fijo2(r.monto1) << "\n";
+    salida << "   " << pais2_str << ": $" << fijo2(r.monto2) << "\n";
+    if (r.monto1 > r.monto2) { g_condCounters.compararDosPaises_ifs++;
+        salida << "   " << pais1_str << " tiene un mayor monto total de ventas.\n";
+    } else if (r.monto2 > r.monto1) { g_condCounters.compararDosPaises_ifs++; 
+        salida << "   " << pais2_str << " tiene un mayor monto total de ventas.\n";
+    } else { g_condCounters.compararDosPaises_ifs++; 
+        salida << "   Ambos paises tienen el mismo monto total de ventas.\n";
+    }
+
+    // b. Producto mas vendido (solo el mas vendido)
+    salida << "\n2. Producto mas vendido (por monto):\n";
+
+    salida << "   -Producto mas vendido en " << pais1_str << ":\n";
+    if (r.topProductos1.empty()) { g_condCounters.compararDosPaises_ifs++; 
+        salida << "     No se encontraron productos para este pais.\n";
+    } else { g_condCounters.compararDosPaises_ifs++; 
+        salida << "     " << r.topProductos1[0].first << " ($" << fijo2(r.topProductos1[0].second) << ")\n";
+    }
+
+    salida << "   -Producto mas vendido en " << pais2_str << ":\n";
+    if (r.topProductos2.empty()) { g_condCounters.compararDosPaises_ifs++; 
+        salida << "    No se encontraron productos para este pais.\n";
+    } else { g_condCounters.compararDosPaises_ifs++; 
+        salida << "     " << r.topProductos2[0].first << " ($" << fijo2(r.topProductos2[0].second) << ")\n";
+    }
+
+    // c. Medio de envio mas usado
+    salida << "\n3. Medio de envio mas usado:\n";
+    const pair<string, int>& medioEnvio1 = r.medioEnvio1;
+    const pair<string, int>& medioEnvio2 = r.medioEnvio2;
+
+    salida << "   -Medio mas usado en " << pais1_str << ": " << medioEnvio1.first << " (" << medioEnvio1.second << " veces)\n";
+    salida << "   -Medio mas usado en " << pais2_str << ": " << medioEnvio2.first << " (" << medioEnvio2.second << " veces)\n";
+    if (medioEnvio1.second > medioEnvio2.second) { g_condCounters.compararDosPaises_ifs++; 
+        salida << "   " << pais1_str << " usa mas frecuentemente " << medioEnvio1.first << " que " << pais2_str << " usa " << medioEnvio2.first << ".\n";
+    } else if (medioEnvio2.second > medioEnvio1.second) { g_condCounters.compararDosPaises_ifs++; 
+        salida << "   " << pais2_str << " usa mas frecuentemente " << medioEnvio2.first << " que " << pais1_str << " usa " << medioEnvio1.first << ".\n";
+    } else if (medioEnvio1.second > 0) { g_condCounters.compararDosPaises_ifs++; 
+        salida << "   Ambos paises usan sus medios de envio mas frecuentes la misma cantidad de veces.\n";
+    } else { g_condCounters.compararDosPaises_ifs++; 
+        salida << "   No hay datos suficientes para comparar los medios de envio.\n";
+    }
+}
+
+void escribirComparacionPaises(const ResultadoComparacionPaises& r, EscritorResultado& escritor) {
+    escritor.comenzarReporte("compare-countries");
+
+    escritor.comenzarTabla("montos", {"pais", "monto"});
+    escritor.texto(r.pais1); escritor.real(r.monto1); escritor.terminarFila();
+    escritor.texto(r.pais2); escritor.real(r.monto2); escritor.terminarFila();
+    escritor.terminarTabla();
+
+    escritor.comenzarTabla("productos", {"pais", "producto", "monto"});
+    if (!r.topProductos1.empty()) {
+        escritor.texto(r.pais1); escritor.texto(r.topProductos1[0].first); escritor.real(r.topProductos1[0].second); escritor.terminarFila();
+    }
+    if (!r.topProductos2.empty()) {
+        escritor.texto(r.pais2); escritor.texto(r.topProductos2[0].first); escritor.real(r.topProductos2[0].second); escritor.terminarFila();
+    }
+    escritor.terminarTabla();
+
+    escritor.comenzarTabla("medios_envio", {"pais", "medio", "veces"});
+    if (r.medioEnvio1.second > 0) {
+        escritor.texto(r.pais1); escritor.texto(r.medioEnvio1.first); escritor.entero(r.medioEnvio1.second); escritor.terminarFila();
+    }
+    if (r.medioEnvio2.second > 0) {
+        escritor.texto(r.pais2); escritor.texto(r.medioEnvio2.first); escritor.entero(r.medioEnvio2.second); escritor.terminarFila();
+    }
+    escritor.terminarTabla();
+
+    escritor.terminarReporte();
+}
+
+// Función para comparar dos países
+void compararDosPaises(const Lista<Venta>& listaVentas, const string& pais1_str, const string& pais2_str, ostream& salida) {
+    ResultadoComparacionPaises resultado;
+    string error;
+    if (!obtenerComparacionPaises(listaVentas, pais1_str, pais2_str, resultado, error)) {
+        salida << error << "\n";
+        return;
+    }
+    mostrarComparacionPaises(resultado, salida);
+}
+
+bool compararDosPaises(const Lista<Venta>& listaVentas, const string& pais1_str, const string& pais2_str,
+                       EscritorResultado& escritor, string& error) {
+    ResultadoComparacionPaises resultado;
+    if (!obtenerComparacionPaises(listaVentas, pais1_str, pais2_str, resultado, error)) return false;
+    escribirComparacionPaises(resultado, escritor);
+    return true;
+}
+
+// Versión interactiva: pide los parámetros por consola
+void compararDosPaises(const Lista<Venta>& listaVentas) {
+    g_condCounters.compararDosPaises_ifs = 0; // Reiniciar contador
+    cout << "\n--- COMPARACION ENTRE DOS PAISES ---\n";
+    string pais1_str, pais2_str;
+
+    cout << "Ingrese el nombre del primer pais (o 'cancelar' para volver): ";
+    getline(cin, pais1_str);
+    if (pais1_str == "cancelar") { g_condCounters.compararDosPaises_ifs++; cout << "Operacion cancelada." << endl; return; } 
+
+    cout << "Ingrese el nombre del segundo pais (o 'cancelar' para volver): ";
+    getline(cin, pais2_str);
+    if (pais2_str == "cancelar") { g_condCounters.compararDosPaises_ifs++; cout << "Operacion cancelada." << endl; return; }
+
+    ReporteBuffereado reporte(cout);
+    compararDosPaises(listaVentas, pais1_str, pais2_str, cout);
+}
+
+// Un país donde se vendió al menos uno de los dos productos comparados
+struct ComparacionProductosPais {
+    string pais;
+    bool hayProd1 = false, hayProd2 = false;
+    int cantidad1 = 0, cantidad2 = 0;
+    float monto1 = 0.0f, monto2 = 0.0f;
+};
+
+struct ResultadoComparacionProductos {
+    string producto1, producto2;
+    bool hayVentas = false; // false: ninguno de los dos aparece en la lista
+    vector<ComparacionProductosPais> paises;
+};
+
+// 'gruposVisitados' cuenta los países recorridos en el corte por producto
+bool calcularComparacionProductos(const Lista<Venta>& listaVentas, const string& producto1_str, const string& producto2_str,
+                                  ResultadoComparacionProductos& resultado, string& error, long long& gruposVisitados) {
+    string prod1Normalizado = normalizeString(producto1_str);
+    string prod2Normalizado = normalizeString(producto2_str);
+
+    if (prod1Normalizado == prod2Normalizado) { g_condCounters.compararDosProductosPorPais_ifs++; 
+        error = "Los productos ingresados son el mismo. Por favor, ingrese dos productos diferentes.";
+        return false;
+    }
+
+    // Los totales de cada producto por país (tal como aparece en el CSV) salen
+    // del corte por producto del cubo (CuboVentas.h)
+    shared_ptr<const IndiceVentas> indice = g_indicesVentas.obtener(listaVentas);
+    const ResumenProducto* resumen1 = indice->resumenProducto(producto1_str);
+    const ResumenProducto* resumen2 = indice->resumenProducto(producto2_str);
+
+    // Países donde se vendió alguno de los dos, en el orden del HashMapList
+    // de TAMANIO_HASH_PAISES en que se agrupaban: por bucket y por la primera
+    // fila de cualquiera de los dos productos en el país
+    map<string, unsigned long long> primeraFila;
+    for (const ResumenProducto* r : {resumen1, resumen2}) {
+        if (r == nullptr) continue;
+        gruposVisitados += r->paises.getGrupos().size();
+        for (const TotalesGrupo& g : r->paises.getGrupos()) {
+            g_condCounters.compararDosProductosPorPais_ifs += g.ventas; // filas de alguno de los dos
+            auto it = primeraFila.find(g.clave);
+            if (it == primeraFila.end()) primeraFila[g.clave] = g.primeraSecuencia;
+            else it->second = min(it->second, g.primeraSecuencia);
+        }
+    }
+    vector<pair<pair<unsigned int, unsigned long long>, string>> paisesConDatos;
+    for (const auto& p : primeraFila) {
+        paisesConDatos.push_back({{stringHash(p.first) % TAMANIO_HASH_PAISES, p.second}, p.first});
+    }
+    sort(paisesConDatos.begin(), paisesConDatos.end());
+
+    resultado.producto1 = producto1_str;
+    resultado.producto2 = producto2_str;
+    resultado.hayVentas = !paisesConDatos.empty();
+
+    for (const auto& paisEntry : paisesConDatos) {
+        const string& pais = paisEntry.second;
+        const TotalesGrupo* statsProd1 = resumen1 == nullptr ? nullptr : resumen1->paises.buscar(pais);
+        const TotalesGrupo* statsProd2 = resumen2 == nullptr ? nullptr : resumen2->paises.buscar(pais);
+
+        // Solo se informa el pais si al menos uno de los dos productos tiene datos
+        if ((statsProd1 && (statsProd1->cantidad > 0 || statsProd1->monto > 0)) ||
+            (statsProd2 && (statsProd2->cantidad > 0 || statsProd2->monto > 0))) { g_condCounters.compararDosProductosPorPais_ifs++; // If for product stats existence
+            ComparacionProductosPais comparacion;
+            comparacion.pais = pais; // Nombre original del país
+            if (statsProd1) {
+                comparacion.hayProd1 = true;
+                comparacion.cantidad1 = statsProd1->cantidad;
+                comparacion.monto1 = statsProd1->monto;
+            }
+            if (statsProd2) {
+                comparacion.hayProd2 = true;
+                comparacion.cantidad2 = statsProd2->cantidad;
+                comparacion.monto2 = statsProd2->monto;
+            }
+            resultado.paises.push_back(comparacion);
+        }
+    }
+    return true;
+}
+
+size_t bytesResultado(const ResultadoComparacionProductos& r) {
+    size_t bytes = sizeof(r) + r.producto1.size() + r.producto2.size();
+    for (const ComparacionProductosPais& c : r.paises) bytes += sizeof(c) + c.pais.size();
+    return bytes;
+}
+
+// calcularComparacionProductos a través de la caché de consultas. El
+// temporizador mide también los aciertos, con 0 filas.
+bool obtenerComparacionProductos(const Lista<Venta>& listaVentas, const string& producto1_str, const string& producto2_str,
+                                 ResultadoComparacionProductos& resultado, string& error) {
+    TemporizadorFase temporizador("compararDosProductosPorPais", "consulta");
+    long long visitados = 0;
+    string clave = claveConsulta("compare-products", {normalizeString(producto1_str), normalizeString(producto2_str)});
+    bool ok = g_cacheConsultas.obtener(listaVentas, clave, resultado, [&](ResultadoComparacionProductos& r) {
+        return calcularComparacionProductos(listaVentas, producto1_str, producto2_str, r, error, visitados);
+    });
+    temporizador.setFilas(visitados);
+    if (!ok) return false;
+    resultado.producto1 = producto1_str;
+    resultado.producto2 = producto2_str;
+    return true;
+}
+
+void mostrarComparacionProductos(const ResultadoComparacionProductos& r, ostream& salida) {
+    const string& producto1_str = r.producto1;
+    const string& producto2_str = r.producto2;
+
+    if (!r.hayVentas) { g_condCounters.compararDosProductosPorPais_ifs++; 
+        salida << "No se encontraron ventas para los productos '" << producto1_str << "' o '" << producto2_str << "' en ningun pais.\n";
+        return;
+    }
+    g_condCounters.compararDosProductosPorPais_ifs++; 
+    salida << "\n--- Comparacion detallada por Pais ---\n";
+    for (const ComparacionProductosPais& c : r.paises) {
+        salida << "\nPais: " << c.pais << "\n";
+        salida << "----------------------------------------\n";
+
+        // a. Cantidad total vendida
+        salida << "  1. Cantidad total vendida:\n";
+        salida << "     " << producto1_str << ": " << c.cantidad1 << " unidades\n";
+        salida << "     " << producto2_str << ": " << c.cantidad2 << " unidades\n";
+        if (c.hayProd1 && c.hayProd2) { g_condCounters.compararDosProductosPorPais_ifs++; 
+            if (c.cantidad1 > c.cantidad2) { g_condCounters.compararDosProductosPorPais_ifs++; 
+            } else if (c.cantidad2 > c.cantidad1) { g_condCounters.compararDosProductosPorPais_ifs++; 
+                salida << "     " << producto2_str << " se vendio mas en cantidad en este pais.\n";
+            } else { g_condCounters.compararDosProductosPorPais_ifs++; 
+                salida << "     Ambos productos se vendieron la misma cantidad en este pais.\n";
+            }
+        } else if (c.hayProd1) { g_condCounters.compararDosProductosPorPais_ifs++;
+             salida << "     Solo " << producto1_str << " tiene ventas en este pais.\n";
+        } else if (c.hayProd2) { g_condCounters.compararDosProductosPorPais_ifs++; 
+             salida << "     Solo " << producto2_str << " tiene ventas en este pais.\n";
+        } else { g_condCounters.compararDosProductosPorPais_ifs++; 
+            salida << "     Ninguno de los productos tiene ventas en este pais.\n";
+        }
+
+
+        // b. Monto total
+        salida << "  2. Monto total vendido:\n";
+        salida << "     " << producto1_str << ": $" << fijo2(c.monto1) << "\n";
+        salida << "     " << producto2_str << ": $" << fijo2(c.monto2) << "\n";
+        if (c.hayProd1 && c.hayProd2) { g_condCounters.compararDosProductosPorPais_ifs++; 
+            if (c.monto1 > c.monto2) { g_condCounters.compararDosProductosPorPais_ifs++; 
+                salida << "     " << producto1_str << " genero mas monto en este pais.\n";
+            } else if (c.monto2 > c.monto1) { g_condCounters.compararDosProductosPorPais_ifs++; 
+                salida << "     " << producto2_str << " genero mas monto en este pais.\n";
+            } else { g_condCounters.compararDosProductosPorPais_ifs++; 
+                salida << "     Ambos productos generaron el mismo monto en este pais.\n";
+            }
+        } else if (c.hayProd1) { g_condCounters.compararDosProductosPorPais_ifs++; 
+            salida << "     Solo " << producto1_str << " tiene ventas (monto) en este pais.\n";
+        } else if (c.hayProd2) { g_condCounters.compararDosProductosPorPais_ifs++; 
+            salida << "     Solo " << producto2_str << " tiene ventas (monto) en este pais.\n";
+        } else { g_condCounters.compararDosProductosPorPais_ifs++; 
+            salida << "     Ninguno de los productos tiene ventas (monto) en este pais.\n";
+        }
+    }
+
+    if (r.paises.empty()) { g_condCounters.compararDosProductosPorPais_ifs++; 
+        salida << "Ninguno de los productos '" << producto1_str << "' o '" << producto2_str << "' tuvo ventas registradas en ningun pais.\n";
+    }
+}
+
+void escribirComparacionProductos(const ResultadoComparacionProductos& r, EscritorResultado& escritor) {
+    escritor.comenzarReporte("compare-products");
+    escritor.comenzarTabla("paises", {"pais", "producto", "cantidad", "monto"});
+    for (const ComparacionProductosPais& c : r.paises) {
+        if (c.hayProd1) {
+            escritor.texto(c.pais); escritor.texto(r.producto1); escritor.entero(c.cantidad1); escritor.real(c.monto1);
+            escritor.terminarFila();
+        }
+        if (c.hayProd2) {
+            escritor.texto(c.pais); escritor.texto(r.producto2); escritor.entero(c.cantidad2); escritor.real(c.monto2);
+            escritor.terminarFila();
+        }
+    }
+    escritor.terminarTabla();
+    escritor.terminarReporte();
+}
+
+// Función para comparar dos productos discriminado por todos los países
+void compararDosProductosPorPais(const Lista<Venta>& listaVentas, const string& producto1_str, const string& producto2_str, ostream& salida) {
+    ResultadoComparacionProductos resultado;
+    string error;
+    if (!obtenerComparacionProductos(listaVentas, producto1_str, producto2_str, resultado, error)) {
+        salida << error << "\n";
+        return;
+    }
+    mostrarComparacionProductos(resultado, salida);
+}
+
+bool compararDosProductosPorPais(const Lista<Venta>& listaVentas, const string& producto1_str, const string& producto2_str,
+                                 EscritorResultado& escritor, string& error) {
+    ResultadoComparacionProductos resultado;
+    if (!obtenerComparacionProductos(listaVentas, producto1_str, producto2_str, resultado, error)) return false;
+    escribirComparacionProductos(resultado, escritor);
+    return true;
+}
+
+// Versión interactiva: pide los parámetros por consola
+void compararDosProductosPorPais(const Lista<Venta>& listaVentas) {
+    g_condCounters.compararDosProductosPorPais_ifs = 0; // Reiniciar contador
+    cout << "\n--- COMPARACION ENTRE DOS PRODUCTOS DISCRIMINADO POR PAIS ---\n";
+    string producto1_str, producto2_str;
+
+    cout << "Ingrese el nombre del primer producto (o 'cancelar' para volver): ";
+    getline(cin, producto1_str);
+    if (producto1_str == "cancelar") { g_condCounters.compararDosProductosPorPais_ifs++; cout << "Operacion cancelada." << endl; return; } 
+
+    cout << "Ingrese el nombre del segundo producto (o 'cancelar' para volver): ";
+    getline(cin, producto2_str);
+    if (producto2_str == "cancelar") { g_condCounters.compararDosProductosPorPais_ifs++; cout << "Operacion cancelada." << endl; return; }
+
+    ReporteBuffereado reporte(cout);
+    compararDosProductosPorPais(listaVentas, producto1_str, producto2_str, cout);
+}
+
+// Producto que cumple la condición de umbral de buscarProductos*
+struct ProductoUmbral {
+    string producto;
+    float promedio;
+    int cantidad;
+    float monto;
+};
+
+struct ResultadoProductosUmbral {
+    string pais; // vacío en la búsqueda global
+    float umbral;
+    vector<ProductoUmbral> productos;
+};
+
+// Productos (de un país, o de todos si 'paisBuscar' es nullptr) con precio
+// promedio por debajo o por encima del umbral, de menor a mayor promedio. Los
+// promedios ya están ordenados en el cubo país x producto: el umbral se busca
+// por bisección y se copian los que quedan de su lado.
+vector<ProductoUmbral> filtrarProductosPorPromedio(const Lista<Venta>& listaVentas, const string* paisBuscar,
+                                                   float umbral, bool porEncima, int& contador) {
+    shared_ptr<const IndiceVentas> indice = g_indicesVentas.obtener(listaVentas);
+
+    vector<ProductoUmbral> resultado;
+    auto agregar = [&](const TotalesGrupo& stats, float promedio) {
+        contador++;
+        resultado.push_back({stats.clave, promedio, stats.cantidad, stats.monto});
+    };
+
+    if (paisBuscar != nullptr) {
+        const ResumenPais* resumen = indice->resumenPais(*paisBuscar);
+        if (resumen == nullptr) return resultado;
+        auto rango = porEncima ? resumen->promedios.mayoresA(umbral) : resumen->promedios.menoresA(umbral);
+        for (auto it = rango.first; it != rango.second; ++it) {
+            agregar(resumen->productos.getGrupos()[it->grupo], it->promedio);
+        }
+    } else {
+        const CuboPaisProducto& cubo = indice->getCubo();
+        const PromediosOrdenados& promedios = cubo.getPromediosProductos();
+        auto rango = porEncima ? promedios.mayoresA(umbral) : promedios.menoresA(umbral);
+        for (auto it = rango.first; it != rango.second; ++it) agregar(cubo.totales(*it), it->promedio);
+    }
+    return resultado;
+}
+
+size_t bytesResultado(const ResultadoProductosUmbral& r) {
+    size_t bytes = sizeof(r) + r.pais.size();
+    for (const ProductoUmbral& p : r.productos) bytes += sizeof(p) + p.producto.size();
+    return bytes;
+}
+
+void mostrarProductosUmbral(const vector<ProductoUmbral>& productos, ostream& salida) {
+    for (const ProductoUmbral& p : productos) {
+        salida << "  - Producto: " << p.producto
+             << ", Promedio: $" << fijo2(p.promedio)
+             << " (Cantidad total: " << p.cantidad
+             << ", Monto total: $" << p.monto << ")\n";
+    }
+}
+
+void escribirProductosUmbral(const ResultadoProductosUmbral& resultado, const string& reporte, EscritorResultado& escritor) {
+    escritor.comenzarReporte(reporte);
+    escritor.comenzarTabla("productos", {"producto", "promedio", "cantidad", "monto"});
+    for (const ProductoUmbral& p : resultado.productos) {
+        escritor.texto(p.producto);
+        escritor.real(p.promedio);
+        escritor.entero(p.cantidad);
+        escritor.real(p.monto);
+        escritor.terminarFila();
+    }
+    escritor.terminarTabla();
+    escritor.terminarReporte();
+}
+
+ResultadoProductosUmbral calcularProductosPorDebajoUmbralPorPais(const Lista<Venta>& listaVentas, const string& paisBuscar, float umbralMonto) {
+    ResultadoProductosUmbral resultado;
+    resultado.pais = paisBuscar;
+    resultado.umbral = umbralMonto;
+    resultado.productos = filtrarProductosPorPromedio(listaVentas, &paisBuscar, umbralMonto, false,
+                                                      g_condCounters.buscarProductosPorDebajoUmbralPorPais_ifs);
+    return resultado;
+}
+
+// calcularProductosPorDebajoUmbralPorPais a través de la caché de consultas.
+// Se recorren sólo los productos del rango de promedios, que son los del
+// resultado; un acierto de la caché cuenta 0 filas.
+ResultadoProductosUmbral obtenerProductosPorDebajoUmbralPorPais(const Lista<Venta>& listaVentas, const string& paisBuscar, float umbralMonto) {
+    TemporizadorFase temporizador("buscarProductosPorDebajoUmbralPorPais", "consulta");
+    ResultadoProductosUmbral resultado;
+    string clave = claveConsulta("below", {normalizeString(paisBuscar), claveUmbral(umbralMonto)});
+    g_cacheConsultas.obtener(listaVentas, clave, resultado, [&](ResultadoProductosUmbral& r) {
+        r = calcularProductosPorDebajoUmbralPorPais(listaVentas, paisBuscar, umbralMonto);
+        temporizador.setFilas(r.productos.size());
+        return true;
+    });
+    resultado.pais = paisBuscar;
+    return resultado;
+}
+
+void mostrarProductosPorDebajoUmbralPorPais(const ResultadoProductosUmbral& resultado, ostream& salida) {
+    salida << "\nProductos en " << resultado.pais << " con promedio de venta por debajo de $" << fijo2(resultado.umbral) << ":\n";
+    salida << "--------------------------------------------------\n";
+    mostrarProductosUmbral(resultado.productos, salida);
+    if (resultado.productos.empty()) { g_condCounters.buscarProductosPorDebajoUmbralPorPais_ifs++; 
+        salida << "No se encontraron productos que cumplan la condicion en " << resultado.pais << ".\n";
+    }
+    salida << "--------------------------------------------------\n";
+}
+
+void buscarProductosPorDebajoUmbralPorPais(const Lista<Venta>& listaVentas, const string& paisBuscar, float umbralMonto, ostream& salida) {
+    mostrarProductosPorDebajoUmbralPorPais(obtenerProductosPorDebajoUmbralPorPais(listaVentas, paisBuscar, umbralMonto), salida);
+}
+
+void buscarProductosPorDebajoUmbralPorPais(const Lista<Venta>& listaVentas, const string& paisBuscar, float umbralMonto, EscritorResultado& escritor) {
+    escribirProductosUmbral(obtenerProductosPorDebajoUmbralPorPais(listaVentas, paisBuscar, umbralMonto), "below", escritor);
+}
+
+// Versión interactiva: pide los parámetros por consola
+void buscarProductosPorDebajoUmbralPorPais(const Lista<Venta>& listaVentas) {
+    g_condCounters.buscarProductosPorDebajoUmbralPorPais_ifs = 0; // Reiniciar contador
+    cout << "\n--- BUSCAR PRODUCTOS POR DEBAJO DE UMBRAL POR PAIS ---\n";
+    string paisBuscar;
+    float umbralMonto;
+
+    cout << "Ingrese el pais a buscar (o 'cancelar' para volver): ";
+    getline(cin, paisBuscar);
+    if (paisBuscar == "cancelar") { g_condCounters.buscarProductosPorDebajoUmbralPorPais_ifs++; cout << "Operacion cancelada." << endl; return; }
+
+    cout << "Ingrese el monto umbral (ej. 500.00) o -1 para cancelar: ";
+    string umbralStr;
+    getline(cin, umbralStr);
+    if (umbralStr == "-1" || umbralStr == "cancelar") { g_condCounters.buscarProductosPorDebajoUmbralPorPais_ifs++; cout << "Operacion cancelada." << endl; return; } 
+    try {
+        umbralMonto = stof(umbralStr);
+    } catch (const invalid_argument& e) {
+        cout << "Umbral invalido. Operacion cancelada." << endl;
+        return;
+    } catch (const out_of_range& e) {
+        cout << "Umbral fuera de rango. Operacion cancelada." << endl;
+        return;
+    }
+
+    ReporteBuffereado reporte(cout);
+    buscarProductosPorDebajoUmbralPorPais(listaVentas, paisBuscar, umbralMonto, cout);
+}
+
+ResultadoProductosUmbral calcularProductosPorEncimaUmbral(const Lista<Venta>& listaVentas, float umbralMonto) {
+    ResultadoProductosUmbral resultado;
+    resultado.umbral = umbralMonto;
+    resultado.productos = filtrarProductosPorPromedio(listaVentas, nullptr, umbralMonto, true,
+                                                      g_condCounters.buscarProductosPorEncimaUmbral_ifs);
+    return resultado;
+}
+
+// calcularProductosPorEncimaUmbral a través de la caché de consultas, con las
+// filas contadas como en obtenerProductosPorDebajoUmbralPorPais
+ResultadoProductosUmbral obtenerProductosPorEncimaUmbral(const Lista<Venta>& listaVentas, float umbralMonto) {
+    TemporizadorFase temporizador("buscarProductosPorEncimaUmbral", "consulta");
+    ResultadoProductosUmbral resultado;
+    g_cacheConsultas.obtener(listaVentas, claveConsulta("above", {claveUmbral(umbralMonto)}), resultado,
+                             [&](ResultadoProductosUmbral& r) {
+                                 r = calcularProductosPorEncimaUmbral(listaVentas, umbralMonto);
+                                 temporizador.setFilas(r.productos.size());
+                                 return true;
+                             });
+    return resultado;
+}
+
+void mostrarProductosPorEncimaUmbral(const ResultadoProductosUmbral& resultado, ostream& salida) {
+    salida << "\nProductos (global) con promedio de venta por encima de $" << fijo2(resultado.umbral) << ":\n";
+    salida << "--------------------------------------------------\n";
+    mostrarProductosUmbral(resultado.productos, salida);
+    if (resultado.productos.empty()) { g_condCounters.buscarProductosPorEncimaUmbral_ifs++; 
+        salida << "No se encontraron productos que cumplan la condicion (global).\n";
+    }
+    salida << "--------------------------------------------------\n";
+}
+
+void buscarProductosPorEncimaUmbral(const Lista<Venta>& listaVentas, float umbralMonto, ostream& salida) {
+    mostrarProductosPorEncimaUmbral(obtenerProductosPorEncimaUmbral(listaVentas, umbralMonto), salida);
+}
+
+void buscarProductosPorEncimaUmbral(const Lista<Venta>& listaVentas, float umbralMonto, EscritorResultado& escritor) {
+    escribirProductosUmbral(obtenerProductosPorEncimaUmbral(listaVentas, umbralMonto), "above", escritor);
+}
+
+// Versión interactiva: pide los parámetros por consola
+void buscarProductosPorEncimaUmbral(const Lista<Venta>& listaVentas) {
+    g_condCounters.buscarProductosPorEncimaUmbral_ifs = 0; // Reiniciar contador
+    cout << "\n--- BUSCAR PRODUCTOS POR ENCIMA DE UMBRAL (GLOBAL) ---\n";
+    float umbralMonto;
+
+    cout << "Ingrese el monto umbral (ej. 500.00) o -1 para cancelar: ";
+    string umbralStr;
+    getline(cin, umbralStr);
+    if (umbralStr == "-1" || umbralStr == "cancelar") { g_condCounters.buscarProductosPorEncimaUmbral_ifs++; cout << "Operacion cancelada." << endl; return; } 
+    try {
+        umbralMonto = stof(umbralStr);
+    } catch (const invalid_argument& e) {
+        cout << "Umbral invalido. Operacion cancelada." << endl;
+        return;
+    } catch (const out_of_range& e) {
+        cout << "Umbral fuera de rango. Operacion cancelada." << endl;
+        return;
+    }
+
+    ReporteBuffereado reporte(cout);
+    buscarProductosPorEncimaUmbral(listaVentas, umbralMonto, cout);
+}
+
+#endif // CONSULTAS_H
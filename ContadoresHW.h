@@ -0,0 +1,173 @@
+#ifndef CONTADORESHW_H
+#define CONTADORESHW_H
+
+// Contadores de hardware (ciclos, instrucciones, fallos de caché y fallos de
+// predicción de saltos) leídos con perf_event_open alrededor de cada fase.
+//
+// Es opcional: se activa con la variable de entorno TP_CONTADORES_HW=1 y sólo
+// existe en Linux. Si el kernel no permite abrir los contadores (máquina
+// virtual sin PMU, perf_event_paranoid alto, contenedor), se informa una vez
+// por stderr y las fases se siguen midiendo sólo con tiempo y memoria.
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+using namespace std;
+
+// Cuentas del grupo tal como las da el kernel, con los tiempos que estuvo
+// habilitado y en ejecución (difieren si se multiplexaron los contadores)
+struct LecturaHW {
+    bool valida = false;
+    unsigned long long ciclos = 0;
+    unsigned long long instrucciones = 0;
+    unsigned long long fallosCache = 0;
+    unsigned long long fallosSalto = 0;
+    unsigned long long tiempoHabilitado = 0;
+    unsigned long long tiempoEjecucion = 0;
+};
+
+// Cuentas de la fase entre dos lecturas. La diferencia cruda se escala por
+// la proporción de la fase en que el grupo estuvo habilitado y en ejecución:
+// escalar cada lectura acumulada por su propia proporción puede dar una
+// diferencia negativa. Si el grupo no llegó a ejecutarse en la fase, la
+// lectura queda inválida.
+LecturaHW diferenciaHW(const LecturaHW& inicio, const LecturaHW& fin) {
+    LecturaHW d;
+    if (!inicio.valida || !fin.valida || fin.tiempoEjecucion <= inicio.tiempoEjecucion ||
+        fin.ciclos < inicio.ciclos || fin.instrucciones < inicio.instrucciones ||
+        fin.fallosCache < inicio.fallosCache || fin.fallosSalto < inicio.fallosSalto) {
+        return d;
+    }
+    d.tiempoHabilitado = fin.tiempoHabilitado - inicio.tiempoHabilitado;
+    d.tiempoEjecucion = fin.tiempoEjecucion - inicio.tiempoEjecucion;
+    double escala = 1.0;
+    if (d.tiempoEjecucion < d.tiempoHabilitado) escala = (double)d.tiempoHabilitado / d.tiempoEjecucion;
+    d.valida = true;
+    d.ciclos = (unsigned long long)((fin.ciclos - inicio.ciclos) * escala);
+    d.instrucciones = (unsigned long long)((fin.instrucciones - inicio.instrucciones) * escala);
+    d.fallosCache = (unsigned long long)((fin.fallosCache - inicio.fallosCache) * escala);
+    d.fallosSalto = (unsigned long long)((fin.fallosSalto - inicio.fallosSalto) * escala);
+    return d;
+}
+
+// Grupo de contadores del hilo actual. Se abre la primera vez que el hilo lo
+// usa y se mantiene habilitado; cada fase toma la diferencia entre dos
+// lecturas.
+class ContadoresHW {
+private:
+    static const int CANTIDAD = 4;
+    int fds[CANTIDAD];
+    bool abierto;
+
+#ifdef __linux__
+    static int abrirEvento(uint32_t tipo, uint64_t config, int lider) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = tipo;
+        attr.config = config;
+        attr.disabled = lider == -1 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return (int)syscall(__NR_perf_event_open, &attr, 0, -1, lider, 0);
+    }
+#endif
+
+public:
+    ContadoresHW() : abierto(false) {
+        for (int i = 0; i < CANTIDAD; ++i) fds[i] = -1;
+#ifdef __linux__
+        const uint64_t eventos[CANTIDAD] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+        };
+        for (int i = 0; i < CANTIDAD; ++i) {
+            fds[i] = abrirEvento(PERF_TYPE_HARDWARE, eventos[i], i == 0 ? -1 : fds[0]);
+            if (fds[i] == -1) {
+                cerrar();
+                return;
+            }
+        }
+        ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        abierto = true;
+#endif
+    }
+
+    ~ContadoresHW() {
+        cerrar();
+    }
+
+    void cerrar() {
+#ifdef __linux__
+        for (int i = CANTIDAD - 1; i >= 0; --i) {
+            if (fds[i] != -1) close(fds[i]);
+            fds[i] = -1;
+        }
+#endif
+        abierto = false;
+    }
+
+    bool disponible() const {
+        return abierto;
+    }
+
+    // Lee el grupo completo sin escalar: la escala se aplica a la diferencia
+    // de cada fase (diferenciaHW).
+    LecturaHW leer() {
+        LecturaHW l;
+#ifdef __linux__
+        if (!abierto) return l;
+        uint64_t datos[3 + CANTIDAD];
+        if (read(fds[0], datos, sizeof(datos)) != (ssize_t)sizeof(datos) || datos[0] != CANTIDAD) {
+            return l;
+        }
+        l.valida = true;
+        l.tiempoHabilitado = datos[1];
+        l.tiempoEjecucion = datos[2];
+        l.ciclos = datos[3];
+        l.instrucciones = datos[4];
+        l.fallosCache = datos[5];
+        l.fallosSalto = datos[6];
+#endif
+        return l;
+    }
+};
+
+// Indica si el usuario pidió los contadores (se evalúa una sola vez)
+bool contadoresHWSolicitados() {
+    static const bool solicitados = [] {
+        const char* valor = getenv("TP_CONTADORES_HW");
+        return valor != nullptr && strcmp(valor, "0") != 0;
+    }();
+    return solicitados;
+}
+
+// Contadores del hilo actual, o nullptr si no se pidieron o no están disponibles
+ContadoresHW* contadoresDelHilo() {
+    if (!contadoresHWSolicitados()) return nullptr;
+    thread_local ContadoresHW contadores;
+    // Cada hilo abre sus contadores, pero el aviso se da una vez por proceso
+    static atomic<bool> avisado(false);
+    if (!contadores.disponible()) {
+        if (!avisado.exchange(true)) {
+            cerr << "Aviso: contadores de hardware no disponibles (perf_event_open fallo); "
+                 << "se informan solo tiempos." << endl;
+        }
+        return nullptr;
+    }
+    return &contadores;
+}
+
+#endif // CONTADORESHW_H
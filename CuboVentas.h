@@ -0,0 +1,340 @@
+#ifndef CUBOVENTAS_H
+#define CUBOVENTAS_H
+
+// Cubo país x producto: cantidad, monto y cantidad de ventas de cada par,
+// con los totales por país y por producto.
+//
+// Las consultas que comparan países o productos, o que buscan productos por
+// umbral, acumulaban por producto recorriendo toda la lista. El cubo se arma
+// en la misma pasada que construye IndiceVentas, que lo guarda y lo mantiene
+// al día: una venta agregada al final suma a sus celdas; una baja o una
+// modificación recalcula sólo el país y el producto afectados, recorriendo
+// sus filas en orden. Así cada monto sale sumado (en float) en el mismo orden
+// que en un recorrido completo de la lista.
+//
+// Se guardan dos cortes del cubo, porque las consultas agrupan distinto:
+//   - por país (normalizado): monto total y, por cada producto y medio de
+//     envío tal como aparecen en el CSV, sus totales en ese país;
+//   - por producto (normalizado): los totales de cada variante del nombre del
+//     producto en todos los países, y los de cada país tal como aparece.
+//
+// Cada grupo recuerda la secuencia de su primera y su última fila (un número
+// que crece con cada venta agregada y no cambia con las bajas): con ellas
+// Analisis.h los ordena como los devolvía el HashMapList en que se
+// acumulaban antes.
+//
+// Para las búsquedas por umbral, cada país guarda sus productos ordenados por
+// precio promedio (monto / cantidad), y el cubo guarda lo mismo para todos
+// los nombres de producto: un umbral es una búsqueda binaria y los productos
+// que lo cumplen son un prefijo o un sufijo del arreglo. Un alta saca y
+// vuelve a insertar por búsqueda binaria sólo el producto que cambió (en su
+// país y en el arreglo global); una baja o modificación, que ya recalcula el
+// país entero, reordena ese país y reubica los nombres del producto tocado.
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Venta.h"
+
+using namespace std;
+
+// Totales de las ventas de un grupo (un producto en un país, un medio de
+// envío en un país, un producto en todos los países...)
+struct TotalesGrupo {
+    string clave;
+    int cantidad = 0;
+    float monto = 0.0f;
+    int ventas = 0;
+    unsigned long long primeraSecuencia = 0;
+    unsigned long long ultimaSecuencia = 0;
+};
+
+// Grupos en orden de primera aparición, con su posición por clave
+class GruposPorClave {
+private:
+    vector<TotalesGrupo> grupos;
+    unordered_map<string, size_t> posicion;
+
+public:
+    void agregar(const string& clave, const Venta& venta, unsigned long long secuencia) {
+        auto it = posicion.find(clave);
+        if (it == posicion.end()) {
+            it = posicion.emplace(clave, grupos.size()).first;
+            grupos.push_back(TotalesGrupo());
+            grupos.back().clave = clave;
+            grupos.back().primeraSecuencia = secuencia;
+        }
+        TotalesGrupo& g = grupos[it->second];
+        g.cantidad += venta.cantidad;
+        g.monto += venta.montoTotal;
+        g.ventas++;
+        g.ultimaSecuencia = secuencia;
+    }
+
+    // Posición de la clave en getGrupos(), o -1 si no tiene ventas
+    long long posicionDe(const string& clave) const {
+        auto it = posicion.find(clave);
+        return it == posicion.end() ? -1 : static_cast<long long>(it->second);
+    }
+
+    // Totales de la clave, o nullptr si no tiene ventas
+    const TotalesGrupo* buscar(const string& clave) const {
+        auto it = posicion.find(clave);
+        return it == posicion.end() ? nullptr : &grupos[it->second];
+    }
+
+    const vector<TotalesGrupo>& getGrupos() const {
+        return grupos;
+    }
+
+    size_t getBytes() const {
+        size_t total = grupos.capacity() * sizeof(TotalesGrupo) +
+                       posicion.size() * (sizeof(string) + sizeof(size_t) + sizeof(void*));
+        for (const TotalesGrupo& g : grupos) total += g.clave.capacity() * 2;
+        return total;
+    }
+};
+
+// Promedio de un grupo: 'grupo' es su posición en el GruposPorClave y
+// 'resumen' el código del producto al que pertenece (en el arreglo global)
+struct PromedioGrupo {
+    float promedio;
+    uint32_t resumen;
+    uint32_t grupo;
+};
+
+// Grupos con cantidad > 0 ordenados por promedio creciente (a igual promedio,
+// por nombre)
+class PromediosOrdenados {
+private:
+    vector<PromedioGrupo> orden;
+
+    template <class ClaveDe>
+    static bool antes(const PromedioGrupo& a, const PromedioGrupo& b, ClaveDe& claveDe) {
+        if (a.promedio != b.promedio) return a.promedio < b.promedio;
+        return claveDe(a) < claveDe(b);
+    }
+
+    // Inserta el grupo i en su lugar con búsqueda binaria
+    template <class ClaveDe>
+    void insertar(const GruposPorClave& grupos, uint32_t resumen, uint32_t i, ClaveDe& claveDe) {
+        const TotalesGrupo& g = grupos.getGrupos()[i];
+        if (g.cantidad <= 0) return;
+        PromedioGrupo p{g.monto / g.cantidad, resumen, i};
+        orden.insert(lower_bound(orden.begin(), orden.end(), p,
+                                 [&](const PromedioGrupo& a, const PromedioGrupo& b) { return antes(a, b, claveDe); }),
+                     p);
+    }
+
+public:
+    typedef vector<PromedioGrupo>::const_iterator Iterador;
+
+    void limpiar() {
+        orden.clear();
+    }
+
+    void agregar(const GruposPorClave& grupos, uint32_t resumen) {
+        const vector<TotalesGrupo>& g = grupos.getGrupos();
+        for (size_t i = 0; i < g.size(); ++i) {
+            if (g[i].cantidad > 0) orden.push_back({g[i].monto / g[i].cantidad, resumen, static_cast<uint32_t>(i)});
+        }
+    }
+
+    // claveDe(p) devuelve el nombre del grupo p, para desempatar
+    template <class ClaveDe>
+    void ordenar(ClaveDe claveDe) {
+        sort(orden.begin(), orden.end(), [&](const PromedioGrupo& a, const PromedioGrupo& b) {
+            return antes(a, b, claveDe);
+        });
+    }
+
+    // Después de que cambiaron los totales de los grupos de 'resumen' (o sólo
+    // del grupo 'grupo'), saca sus entradas y las vuelve a insertar en su
+    // lugar: O(log n) comparaciones más el corrimiento del arreglo, en lugar
+    // de reordenarlo entero
+    template <class ClaveDe>
+    void reubicar(const GruposPorClave& grupos, uint32_t resumen, ClaveDe claveDe) {
+        orden.erase(remove_if(orden.begin(), orden.end(), [resumen](const PromedioGrupo& p) { return p.resumen == resumen; }),
+                    orden.end());
+        for (size_t i = 0; i < grupos.getGrupos().size(); ++i) insertar(grupos, resumen, static_cast<uint32_t>(i), claveDe);
+    }
+
+    template <class ClaveDe>
+    void reubicarGrupo(const GruposPorClave& grupos, uint32_t resumen, uint32_t grupo, ClaveDe claveDe) {
+        auto it = find_if(orden.begin(), orden.end(),
+                          [&](const PromedioGrupo& p) { return p.resumen == resumen && p.grupo == grupo; });
+        if (it != orden.end()) orden.erase(it);
+        insertar(grupos, resumen, grupo, claveDe);
+    }
+
+    // [inicio, fin) de los grupos con promedio < umbral o > umbral
+    pair<Iterador, Iterador> menoresA(float umbral) const {
+        auto fin = lower_bound(orden.begin(), orden.end(), umbral,
+                               [](const PromedioGrupo& p, float u) { return p.promedio < u; });
+        return {orden.begin(), fin};
+    }
+
+    pair<Iterador, Iterador> mayoresA(float umbral) const {
+        auto inicio = upper_bound(orden.begin(), orden.end(), umbral,
+                                  [](float u, const PromedioGrupo& p) { return u < p.promedio; });
+        return {inicio, orden.end()};
+    }
+
+    size_t getBytes() const {
+        return orden.capacity() * sizeof(PromedioGrupo);
+    }
+};
+
+// Corte por país
+struct ResumenPais {
+    double monto = 0.0;
+    int ventas = 0;
+    GruposPorClave productos; // por producto tal como aparece
+    GruposPorClave medios;    // por medio de envío tal como aparece
+    PromediosOrdenados promedios; // productos por precio promedio
+
+    void ordenarPromedios() {
+        promedios.limpiar();
+        promedios.agregar(productos, 0);
+        promedios.ordenar([this](const PromedioGrupo& p) -> const string& {
+            return productos.getGrupos()[p.grupo].clave;
+        });
+    }
+
+    // Tras agregar una venta de 'producto': sólo cambió su grupo
+    void reubicarPromedio(const string& producto) {
+        long long grupo = productos.posicionDe(producto);
+        if (grupo < 0) return;
+        promedios.reubicarGrupo(productos, 0, static_cast<uint32_t>(grupo), [this](const PromedioGrupo& p) -> const string& {
+            return productos.getGrupos()[p.grupo].clave;
+        });
+    }
+
+    void agregar(const Venta& venta, unsigned long long secuencia) {
+        monto += venta.montoTotal;
+        ventas++;
+        productos.agregar(venta.producto, venta, secuencia);
+        medios.agregar(venta.medioEnvio, venta, secuencia);
+    }
+};
+
+// Corte por producto
+struct ResumenProducto {
+    GruposPorClave nombres; // por producto tal como aparece, en todos los países
+    GruposPorClave paises;  // por país tal como aparece
+
+    void agregar(const Venta& venta, unsigned long long secuencia) {
+        nombres.agregar(venta.producto, venta, secuencia);
+        paises.agregar(venta.pais, venta, secuencia);
+    }
+};
+
+class CuboPaisProducto {
+private:
+    vector<ResumenPais> paises;         // por código de país de IndiceVentas
+    vector<ResumenProducto> productos;  // por código de producto de IndiceVentas
+    PromediosOrdenados promediosProductos; // todos los nombres de producto por precio promedio
+
+    template <class T>
+    static T& celda(vector<T>& v, uint32_t codigo) {
+        if (codigo >= v.size()) v.resize(codigo + 1);
+        return v[codigo];
+    }
+
+public:
+    void agregar(uint32_t codigoPais, uint32_t codigoProducto, const Venta& venta, unsigned long long secuencia) {
+        agregarAPais(codigoPais, venta, secuencia);
+        agregarAProducto(codigoProducto, venta, secuencia);
+    }
+
+    void agregarAPais(uint32_t codigoPais, const Venta& venta, unsigned long long secuencia) {
+        celda(paises, codigoPais).agregar(venta, secuencia);
+    }
+
+    void agregarAProducto(uint32_t codigoProducto, const Venta& venta, unsigned long long secuencia) {
+        celda(productos, codigoProducto).agregar(venta, secuencia);
+    }
+
+    // Dejan el país o el producto vacío para volver a agregar sus filas
+    void reiniciarPais(uint32_t codigoPais) {
+        if (codigoPais < paises.size()) paises[codigoPais] = ResumenPais();
+    }
+
+    void reiniciarProducto(uint32_t codigoProducto) {
+        if (codigoProducto < productos.size()) productos[codigoProducto] = ResumenProducto();
+    }
+
+    // Tras agregar una venta: reubica el producto en los promedios del país y
+    // sus variantes de nombre en el arreglo global
+    void reubicarPromedios(uint32_t codigoPais, uint32_t codigoProducto, const string& producto) {
+        if (codigoPais < paises.size()) paises[codigoPais].reubicarPromedio(producto);
+        reubicarPromediosProducto(codigoProducto);
+    }
+
+    // Tras recalcular un producto (baja o modificación): sus grupos pueden
+    // haber cambiado de posición, así que se reubican todos los suyos
+    void reubicarPromediosProducto(uint32_t codigoProducto) {
+        if (codigoProducto >= productos.size()) return;
+        promediosProductos.reubicar(productos[codigoProducto].nombres, codigoProducto,
+                                    [this](const PromedioGrupo& p) -> const string& { return nombre(p); });
+    }
+
+    // Reordena por promedio los productos del país (tras recalcularlo entero)
+    void ordenarPromediosPais(uint32_t codigoPais) {
+        if (codigoPais < paises.size()) paises[codigoPais].ordenarPromedios();
+    }
+
+    void ordenarPromediosProductos() {
+        promediosProductos.limpiar();
+        for (size_t i = 0; i < productos.size(); ++i) {
+            promediosProductos.agregar(productos[i].nombres, static_cast<uint32_t>(i));
+        }
+        promediosProductos.ordenar([this](const PromedioGrupo& p) -> const string& {
+            return nombre(p);
+        });
+    }
+
+    void ordenarTodosLosPromedios() {
+        for (ResumenPais& r : paises) r.ordenarPromedios();
+        ordenarPromediosProductos();
+    }
+
+    const PromediosOrdenados& getPromediosProductos() const {
+        return promediosProductos;
+    }
+
+    // Totales de un nombre de producto de getPromediosProductos()
+    const TotalesGrupo& totales(const PromedioGrupo& p) const {
+        return productos[p.resumen].nombres.getGrupos()[p.grupo];
+    }
+
+    const string& nombre(const PromedioGrupo& p) const {
+        return totales(p).clave;
+    }
+
+    // nullptr si el código no tiene ventas registradas
+    const ResumenPais* pais(uint32_t codigoPais) const {
+        return codigoPais < paises.size() ? &paises[codigoPais] : nullptr;
+    }
+
+    const ResumenProducto* producto(uint32_t codigoProducto) const {
+        return codigoProducto < productos.size() ? &productos[codigoProducto] : nullptr;
+    }
+
+    const vector<ResumenProducto>& getProductos() const {
+        return productos;
+    }
+
+    size_t getBytes() const {
+        size_t total = paises.capacity() * sizeof(ResumenPais) + productos.capacity() * sizeof(ResumenProducto) +
+                       promediosProductos.getBytes();
+        for (const ResumenPais& r : paises) total += r.productos.getBytes() + r.medios.getBytes() + r.promedios.getBytes();
+        for (const ResumenProducto& r : productos) total += r.nombres.getBytes() + r.paises.getBytes();
+        return total;
+    }
+};
+
+#endif // CUBOVENTAS_H
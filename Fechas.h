@@ -0,0 +1,87 @@
+#ifndef FECHAS_H
+#define FECHAS_H
+
+// Fechas como número de día (días desde 1970-01-01), para agrupar y ordenar
+// ventas por día, semana o mes sin comparar strings.
+
+#include <cstdio>
+#include <string>
+
+using namespace std;
+
+// Días desde 1970-01-01 de una fecha civil (algoritmo de Howard Hinnant)
+inline long long diasDesdeCivil(int anio, int mes, int dia) {
+    anio -= mes <= 2;
+    long long era = (anio >= 0 ? anio : anio - 399) / 400;
+    unsigned yoe = (unsigned)(anio - era * 400);
+    unsigned doy = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (long long)doe - 719468;
+}
+
+inline void civilDesdeDias(long long z, int& anio, int& mes, int& dia) {
+    z += 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned doe = (unsigned)(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long y = (long long)yoe + era * 400;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    dia = doy - (153 * mp + 2) / 5 + 1;
+    mes = mp < 10 ? mp + 3 : mp - 9;
+    anio = (int)(y + (mes <= 2));
+}
+
+inline int diasDelMes(int anio, int mes) {
+    static const int dias[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool bisiesto = (anio % 4 == 0 && anio % 100 != 0) || anio % 400 == 0;
+    return mes == 2 && bisiesto ? 29 : dias[mes - 1];
+}
+
+// Lee D/M/AAAA con día y mes de uno o dos dígitos (el CSV trae "5/9/2024"
+// junto a "05/09/2024"). Devuelve false si no es una fecha del calendario
+// entre 1900 y 2100.
+inline bool leerDia(const string& fecha, long long& dia) {
+    int campos[3] = {0, 0, 0};
+    int digitos[3] = {0, 0, 0};
+    int campo = 0;
+    for (char c : fecha) {
+        if (c == '/') {
+            if (++campo > 2) return false;
+        } else if (c >= '0' && c <= '9') {
+            campos[campo] = campos[campo] * 10 + (c - '0');
+            if (++digitos[campo] > (campo == 2 ? 4 : 2)) return false;
+        } else {
+            return false;
+        }
+    }
+    if (campo != 2 || digitos[0] == 0 || digitos[1] == 0 || digitos[2] != 4) return false;
+    int d = campos[0], m = campos[1], a = campos[2];
+    if (a < 1900 || a > 2100 || m < 1 || m > 12 || d < 1 || d > diasDelMes(a, m)) return false;
+    dia = diasDesdeCivil(a, m, d);
+    return true;
+}
+
+// DD/MM/AAAA
+inline string formatearDia(long long dia) {
+    int a, m, d;
+    civilDesdeDias(dia, a, m, d);
+    char texto[40];
+    snprintf(texto, sizeof(texto), "%02d/%02d/%04d", d, m, a);
+    return texto;
+}
+
+// Lunes de la semana del día (1970-01-01 fue jueves)
+inline long long lunesDeLaSemana(long long dia) {
+    long long desdeLunes = ((dia + 3) % 7 + 7) % 7;
+    return dia - desdeLunes;
+}
+
+// Primer día del mes del día
+inline long long primeroDelMes(long long dia) {
+    int a, m, d;
+    civilDesdeDias(dia, a, m, d);
+    return dia - (d - 1);
+}
+
+#endif // FECHAS_H
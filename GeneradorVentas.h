@@ -0,0 +1,320 @@
+#ifndef GENERADORVENTAS_H
+#define GENERADORVENTAS_H
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+#include "Fechas.h"
+
+using namespace std;
+
+// Distribución discreta sobre un conjunto de valores. Se muestrea con una
+// búsqueda binaria sobre los pesos acumulados, sin depender de
+// std::discrete_distribution, para que la salida sea la misma con cualquier
+// biblioteca estándar dada la misma semilla.
+struct DistribucionDiscreta {
+    vector<string> valores;
+    vector<double> pesos;
+    vector<double> acumulados;
+
+    void agregar(const string& valor, double peso = 1.0) {
+        for (size_t i = 0; i < valores.size(); ++i) {
+            if (valores[i] == valor) {
+                pesos[i] += peso;
+                return;
+            }
+        }
+        valores.push_back(valor);
+        pesos.push_back(peso);
+    }
+
+    // Reemplaza los pesos aprendidos por una Zipf de parámetro s sobre el
+    // ranking de frecuencias (el valor más frecuente queda en el rango 1).
+    void aplicarZipf(double s) {
+        vector<size_t> orden(valores.size());
+        for (size_t i = 0; i < orden.size(); ++i) orden[i] = i;
+        stable_sort(orden.begin(), orden.end(), [&](size_t a, size_t b) { return pesos[a] > pesos[b]; });
+        for (size_t rango = 0; rango < orden.size(); ++rango) {
+            pesos[orden[rango]] = 1.0 / pow((double)(rango + 1), s);
+        }
+    }
+
+    void preparar() {
+        acumulados.resize(pesos.size());
+        double total = 0.0;
+        for (size_t i = 0; i < pesos.size(); ++i) {
+            total += pesos[i];
+            acumulados[i] = total;
+        }
+        for (double& a : acumulados) a /= total;
+    }
+
+    // u en [0, 1)
+    size_t muestrear(double u) const {
+        size_t pos = upper_bound(acumulados.begin(), acumulados.end(), u) - acumulados.begin();
+        return pos < valores.size() ? pos : valores.size() - 1;
+    }
+};
+
+// Rango de precios (en centavos) y categoría observados para un producto
+struct ModeloProducto {
+    string categoria;
+    long long minCentavos = 0;
+    long long maxCentavos = 0;
+};
+
+// Distribuciones aprendidas de un CSV de ventas
+struct ModeloVentas {
+    DistribucionDiscreta paises;
+    vector<DistribucionDiscreta> ciudadesPorPais; // mismo índice que paises
+    DistribucionDiscreta productos;
+    vector<ModeloProducto> detalleProductos;      // mismo índice que productos
+    DistribucionDiscreta clientes;
+    DistribucionDiscreta cantidades;
+    DistribucionDiscreta mediosEnvio;
+    DistribucionDiscreta estadosEnvio;
+    long long diaMin = 0; // días desde 1970-01-01
+    long long diaMax = 0;
+    long long filasAprendidas = 0;
+};
+
+// Cantidad de filas con sufijo opcional K, M o B (por ejemplo 500M o 1B)
+unsigned long long parsearCantidadFilas(const string& s) {
+    if (s.empty()) return 0;
+    double multiplicador = 1;
+    string numero = s;
+    char sufijo = (char)toupper(s.back());
+    if (sufijo == 'K') multiplicador = 1e3;
+    else if (sufijo == 'M') multiplicador = 1e6;
+    else if (sufijo == 'B') multiplicador = 1e9;
+    if (multiplicador > 1) numero = s.substr(0, s.size() - 1);
+    return (unsigned long long)(stod(numero) * multiplicador);
+}
+
+long long aCentavos(const string& s) {
+    return llround(stod(s) * 100.0);
+}
+
+// Recorre el CSV una vez y aprende las distribuciones de cada columna.
+// Devuelve false si el archivo no se pudo abrir o no tiene filas.
+bool aprenderModelo(const string& nombreArchivo, ModeloVentas& modelo) {
+    ifstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    unordered_map<string, size_t> indicePais, indiceProducto;
+    vector<unordered_map<string, int>> categoriasPorProducto;
+    bool hayFecha = false;
+
+    string linea;
+    getline(archivo, linea); // Saltear encabezado
+    while (getline(archivo, linea)) {
+        if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+        if (linea.empty()) continue;
+
+        vector<string> campos;
+        stringstream stream(linea);
+        string campo;
+        while (getline(stream, campo, ',')) campos.push_back(campo);
+        if (campos.size() < 12) continue;
+
+        const string& pais = campos[2];
+        if (indicePais.find(pais) == indicePais.end()) {
+            indicePais[pais] = modelo.ciudadesPorPais.size();
+            modelo.ciudadesPorPais.push_back(DistribucionDiscreta());
+        }
+        modelo.paises.agregar(pais);
+        modelo.ciudadesPorPais[indicePais[pais]].agregar(campos[3]);
+
+        const string& producto = campos[5];
+        long long centavos = aCentavos(campos[8]);
+        if (indiceProducto.find(producto) == indiceProducto.end()) {
+            indiceProducto[producto] = modelo.detalleProductos.size();
+            ModeloProducto mp;
+            mp.minCentavos = mp.maxCentavos = centavos;
+            modelo.detalleProductos.push_back(mp);
+            categoriasPorProducto.push_back(unordered_map<string, int>());
+        }
+        size_t ip = indiceProducto[producto];
+        modelo.productos.agregar(producto);
+        modelo.detalleProductos[ip].minCentavos = min(modelo.detalleProductos[ip].minCentavos, centavos);
+        modelo.detalleProductos[ip].maxCentavos = max(modelo.detalleProductos[ip].maxCentavos, centavos);
+        categoriasPorProducto[ip][campos[6]]++;
+
+        modelo.clientes.agregar(campos[4]);
+        modelo.cantidades.agregar(campos[7]);
+        modelo.mediosEnvio.agregar(campos[10]);
+        modelo.estadosEnvio.agregar(campos[11]);
+
+        int d, m, a;
+        if (sscanf(campos[1].c_str(), "%d/%d/%d", &d, &m, &a) == 3) {
+            long long dia = diasDesdeCivil(a, m, d);
+            if (!hayFecha || dia < modelo.diaMin) modelo.diaMin = dia;
+            if (!hayFecha || dia > modelo.diaMax) modelo.diaMax = dia;
+            hayFecha = true;
+        }
+        modelo.filasAprendidas++;
+    }
+
+    // Categoría más frecuente de cada producto
+    for (size_t i = 0; i < categoriasPorProducto.size(); ++i) {
+        int mejor = -1;
+        for (const auto& par : categoriasPorProducto[i]) {
+            if (par.second > mejor) {
+                mejor = par.second;
+                modelo.detalleProductos[i].categoria = par.first;
+            }
+        }
+    }
+    return modelo.filasAprendidas > 0 && hayFecha;
+}
+
+struct OpcionesGenerador {
+    unsigned long long semilla = 42;
+    double zipfProductos = 0.0; // 0 = usar las frecuencias aprendidas
+    double zipfCiudades = 0.0;
+    bool finDeLineaCRLF = true; // el CSV original usa CRLF
+};
+
+// Genera filas con el mismo esquema que el CSV original. Cada fila se escribe
+// en un buffer fijo que se vuelca al archivo al llenarse, por lo que la
+// memoria usada no depende de la cantidad de filas.
+class GeneradorVentas {
+private:
+    ModeloVentas modelo;
+    OpcionesGenerador opciones;
+    uint64_t estado;
+    vector<char> buffer;
+    size_t usado;
+
+    // splitmix64: rápido y con salida idéntica en cualquier plataforma
+    uint64_t siguienteAleatorio() {
+        uint64_t z = (estado += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    double uniforme() {
+        return (siguienteAleatorio() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    long long enteroEntre(long long a, long long b) {
+        return a + (long long)(siguienteAleatorio() % (uint64_t)(b - a + 1));
+    }
+
+    void escribir(const char* s, size_t n) {
+        memcpy(&buffer[usado], s, n);
+        usado += n;
+    }
+
+    void escribir(const string& s) {
+        escribir(s.data(), s.size());
+    }
+
+    void escribirEntero(unsigned long long v) {
+        char tmp[24];
+        int n = 0;
+        do { tmp[n++] = (char)('0' + v % 10); v /= 10; } while (v > 0);
+        while (n > 0) buffer[usado++] = tmp[--n];
+    }
+
+    void escribirCentavos(long long c) {
+        escribirEntero((unsigned long long)(c / 100));
+        buffer[usado++] = '.';
+        buffer[usado++] = (char)('0' + (c / 10) % 10);
+        buffer[usado++] = (char)('0' + c % 10);
+    }
+
+public:
+    GeneradorVentas(const ModeloVentas& m, const OpcionesGenerador& o)
+        : modelo(m), opciones(o), estado(o.semilla), buffer(1 << 20), usado(0) {
+        if (opciones.zipfProductos > 0) modelo.productos.aplicarZipf(opciones.zipfProductos);
+        modelo.paises.preparar();
+        for (DistribucionDiscreta& ciudades : modelo.ciudadesPorPais) {
+            if (opciones.zipfCiudades > 0) ciudades.aplicarZipf(opciones.zipfCiudades);
+            ciudades.preparar();
+        }
+        modelo.productos.preparar();
+        modelo.clientes.preparar();
+        modelo.cantidades.preparar();
+        modelo.mediosEnvio.preparar();
+        modelo.estadosEnvio.preparar();
+    }
+
+    // Escribe el encabezado y 'filas' ventas en 'salida'
+    void generar(FILE* salida, unsigned long long filas, bool mostrarProgreso) {
+        const char* fin = opciones.finDeLineaCRLF ? "\r\n" : "\n";
+        size_t largoFin = opciones.finDeLineaCRLF ? 2 : 1;
+        const size_t margen = 4096; // una fila nunca ocupa más que esto
+
+        string encabezado = "ID_Venta,Fecha,Pais,Ciudad,Cliente,Producto,Categoria,Cantidad,Precio_Unitario,Monto_Total,Medio_Envio,Estado_Envio";
+        escribir(encabezado);
+        escribir(fin, largoFin);
+
+        for (unsigned long long id = 1; id <= filas; ++id) {
+            size_t pais = modelo.paises.muestrear(uniforme());
+            const DistribucionDiscreta& ciudades = modelo.ciudadesPorPais[pais];
+            size_t producto = modelo.productos.muestrear(uniforme());
+            const ModeloProducto& detalle = modelo.detalleProductos[producto];
+            const string& cantidadStr = modelo.cantidades.valores[modelo.cantidades.muestrear(uniforme())];
+            long long cantidad = atoll(cantidadStr.c_str());
+            long long precio = enteroEntre(detalle.minCentavos, detalle.maxCentavos);
+            int anio, mes, dia;
+            civilDesdeDias(enteroEntre(modelo.diaMin, modelo.diaMax), anio, mes, dia);
+
+            escribirEntero(id);
+            buffer[usado++] = ',';
+            escribirEntero(dia);
+            buffer[usado++] = '/';
+            escribirEntero(mes);
+            buffer[usado++] = '/';
+            escribirEntero(anio);
+            buffer[usado++] = ',';
+            escribir(modelo.paises.valores[pais]);
+            buffer[usado++] = ',';
+            escribir(ciudades.valores[ciudades.muestrear(uniforme())]);
+            buffer[usado++] = ',';
+            escribir(modelo.clientes.valores[modelo.clientes.muestrear(uniforme())]);
+            buffer[usado++] = ',';
+            escribir(modelo.productos.valores[producto]);
+            buffer[usado++] = ',';
+            escribir(detalle.categoria);
+            buffer[usado++] = ',';
+            escribir(cantidadStr);
+            buffer[usado++] = ',';
+            escribirCentavos(precio);
+            buffer[usado++] = ',';
+            escribirCentavos(precio * cantidad);
+            buffer[usado++] = ',';
+            escribir(modelo.mediosEnvio.valores[modelo.mediosEnvio.muestrear(uniforme())]);
+            buffer[usado++] = ',';
+            escribir(modelo.estadosEnvio.valores[modelo.estadosEnvio.muestrear(uniforme())]);
+            escribir(fin, largoFin);
+
+            if (usado + margen > buffer.size()) {
+                fwrite(buffer.data(), 1, usado, salida);
+                usado = 0;
+            }
+            if (mostrarProgreso && id % 10000000 == 0) {
+                fprintf(stderr, "%llu filas generadas\n", id);
+            }
+        }
+        fwrite(buffer.data(), 1, usado, salida);
+        usado = 0;
+        fflush(salida);
+    }
+};
+
+#endif // GENERADORVENTAS_H
@@ -0,0 +1,408 @@
+#ifndef GESTION_H
+#define GESTION_H
+
+// Funciones de alta, baja y modificación de ventas. Las versiones
+// interactivas piden los datos por consola; las que reciben los datos ya
+// armados se usan desde el modo batch. Todas mantienen al día el índice de
+// la lista (IndiceVentas.h), si ya se había construido.
+
+#include "Analisis.h"
+
+// Recibe cada alta, baja y modificación ya aplicada sobre la lista (lo usa
+// el WAL para registrar los cambios). Bajas y modificaciones llevan la
+// posición de la fila afectada: los IDs pueden repetirse. Si
+// g_observadorGestion es nullptr no se notifica nada.
+class ObservadorGestion {
+public:
+    virtual ~ObservadorGestion() {}
+    virtual void ventaAgregada(const Venta& venta) = 0;
+    virtual void ventaEliminada(const string& idVenta, int posicion) = 0;
+    virtual void ventaModificada(const Venta& venta, int posicion) = 0;
+
+    // Espera a que los cambios notificados queden persistidos
+    virtual bool esperarDurable() {
+        return true;
+    }
+
+    // Consolida los cambios registrados en una nueva base
+    virtual bool checkpoint(const Lista<Venta>& /*listaVentas*/, string& error) {
+        error = "no hay un WAL configurado (use --wal)";
+        return false;
+    }
+};
+
+ObservadorGestion* g_observadorGestion = nullptr;
+
+// --- Funciones de Gestión de Datos ---
+
+// Agrega una venta ya construida al final de la lista
+void agregarVenta(Lista<Venta>& listaVentas, const Venta& nuevaVenta) {
+    TemporizadorFase temporizador("agregarVenta", "gestion", listaVentas.getTamanio());
+    unsigned long long version = listaVentas.getVersion();
+    listaVentas.insertarUltimo(nuevaVenta);
+    g_indicesVentas.ventaAgregada(listaVentas, version);
+    if (g_observadorGestion != nullptr) g_observadorGestion->ventaAgregada(nuevaVenta);
+}
+
+// Devuelve la posición de la venta con el ID dado, o -1 si no existe.
+// Recorre los nodos directamente para no pagar getDato(i) en cada paso.
+int buscarPosicionPorId(const Lista<Venta>& listaVentas, const string& idVenta) {
+    int posicion = 0;
+    for (Nodo<Venta>* nodo = listaVentas.getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+        if (nodo->getDato().idVenta == idVenta) {
+            return posicion;
+        }
+        posicion++;
+    }
+    return -1;
+}
+
+// Elimina la venta con el ID dado. Devuelve false si no existe.
+bool eliminarVentaPorId(Lista<Venta>& listaVentas, const string& idVenta, ostream& salida) {
+    int posicion;
+    {
+        TemporizadorFase temporizador("eliminarVenta/busqueda", "gestion", listaVentas.getTamanio());
+        posicion = buscarPosicionPorId(listaVentas, idVenta);
+    }
+    if (posicion == -1) {
+        salida << "Venta con ID '" << idVenta << "' no encontrada." << endl;
+        return false;
+    }
+    TemporizadorFase temporizador("eliminarVenta/remover", "gestion", posicion + 1);
+    unsigned long long version = listaVentas.getVersion();
+    listaVentas.remover(posicion);
+    g_indicesVentas.ventaEliminada(listaVentas, version, posicion);
+    if (g_observadorGestion != nullptr) g_observadorGestion->ventaEliminada(idVenta, posicion);
+    salida << "Venta con ID " << idVenta << " eliminada exitosamente." << endl;
+    return true;
+}
+
+// Aplica un cambio "campo=valor" sobre una venta. Los campos válidos son los
+// mismos que pide modificarVenta(); el monto total se recalcula aparte.
+// Devuelve false (y deja la venta igual) si el campo o el valor no son válidos.
+bool aplicarCambioVenta(Venta& venta, const string& campo, const string& valor, ostream& salida) {
+    if (campo == "fecha") venta.fecha = valor;
+    else if (campo == "pais") venta.pais = valor;
+    else if (campo == "ciudad") venta.ciudad = valor;
+    else if (campo == "cliente") venta.cliente = valor;
+    else if (campo == "producto") venta.producto = valor;
+    else if (campo == "categoria") venta.categoria = valor;
+    else if (campo == "medio") venta.medioEnvio = valor;
+    else if (campo == "estado") venta.estadoEnvio = valor;
+    else if (campo == "cantidad" || campo == "precio") {
+        try {
+            if (campo == "cantidad") venta.cantidad = stoi(valor);
+            else venta.precioUnitario = stof(valor);
+        } catch (const exception& e) {
+            salida << "Valor invalido para '" << campo << "': " << valor << endl;
+            return false;
+        }
+    } else {
+        salida << "Campo desconocido: '" << campo << "'. Campos validos: fecha, pais, ciudad, cliente, "
+               << "producto, categoria, cantidad, precio, medio, estado." << endl;
+        return false;
+    }
+    return true;
+}
+
+// Modifica la venta con el ID dado aplicando los cambios "campo=valor".
+// Si algún cambio es inválido no se modifica nada.
+bool modificarVentaPorId(Lista<Venta>& listaVentas, const string& idVenta,
+                         const vector<pair<string, string>>& cambios, ostream& salida) {
+    int posicion;
+    {
+        TemporizadorFase temporizador("modificarVenta/busqueda", "gestion");
+        posicion = buscarPosicionPorId(listaVentas, idVenta);
+        temporizador.setFilas(posicion == -1 ? listaVentas.getTamanio() : posicion + 1);
+    }
+    if (posicion == -1) {
+        salida << "Venta con ID '" << idVenta << "' no encontrada." << endl;
+        return false;
+    }
+
+    Venta ventaModificada = listaVentas.getDato(posicion);
+    for (const auto& cambio : cambios) {
+        if (!aplicarCambioVenta(ventaModificada, cambio.first, cambio.second, salida)) {
+            return false;
+        }
+    }
+    ventaModificada.montoTotal = ventaModificada.cantidad * ventaModificada.precioUnitario; // Recalcular monto total
+
+    TemporizadorFase temporizador("modificarVenta/reemplazo", "gestion", posicion + 1);
+    unsigned long long version = listaVentas.getVersion();
+    listaVentas.reemplazar(posicion, ventaModificada);
+    g_indicesVentas.ventaReemplazada(listaVentas, version, posicion);
+    if (g_observadorGestion != nullptr) g_observadorGestion->ventaModificada(ventaModificada, posicion);
+    salida << "Venta con ID '" << idVenta << "' modificada exitosamente." << endl;
+    return true;
+}
+
+// Versión interactiva: pide los datos de la venta por consola
+void agregarVenta(Lista<Venta>& listaVentas) {
+    cout << "\n--- AGREGAR NUEVA VENTA ---\n";
+
+    string idVenta, fecha, pais, ciudad, cliente, producto, categoria, medioEnvio, estadoEnvio;
+    int cantidad;
+    float precioUnitario, montoTotal;
+
+    cout << "ID de Venta: ";
+    cin >> idVenta;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    cout << "Fecha (DD/MM/AAAA): ";
+    getline(cin, fecha);
+
+    cout << "Pais: ";
+    getline(cin, pais);
+
+    cout << "Ciudad: ";
+    getline(cin, ciudad);
+
+    cout << "Cliente: ";
+    getline(cin, cliente);
+
+    cout << "Producto: ";
+    getline(cin, producto);
+
+    cout << "Categoria: ";
+    getline(cin, categoria);
+
+    cout << "Cantidad: ";
+    cin >> cantidad;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    cout << "Precio Unitario: ";
+    cin >> precioUnitario;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    montoTotal = cantidad * precioUnitario;
+    cout << "Monto Total (calculado): " << fijo2(montoTotal) << endl;
+
+    cout << "Medio de Envio: ";
+    getline(cin, medioEnvio);
+
+    cout << "Estado de Envio: ";
+    getline(cin, estadoEnvio);
+
+    Venta nuevaVenta(idVenta, fecha, pais, ciudad, cliente, producto, categoria,
+                     cantidad, precioUnitario, montoTotal, medioEnvio, estadoEnvio);
+
+    agregarVenta(listaVentas, nuevaVenta);
+    cout << "\nVenta agregada exitosamente:\n";
+    nuevaVenta.mostrar();
+}
+
+void eliminarVenta(Lista<Venta>& listaVentas) {
+    g_condCounters.eliminarVenta_ifs = 0; // Reiniciar contador
+    cout << "\n--- ELIMINAR VENTA ---\n";
+    cout << "Ingrese el pais o la ciudad para filtrar las ventas (o 'cancelar' para volver): ";
+    string filtro;
+    getline(cin, filtro);
+
+    string filtroNormalizado = normalizeString(filtro);
+
+    if (filtro == "cancelar") { g_condCounters.eliminarVenta_ifs++; 
+        cout << "Operacion de eliminacion cancelada." << endl;
+        return;
+    }
+
+    vector<pair<int, Venta>> ventasFiltradas;
+
+    {
+        TemporizadorFase temporizador("eliminarVenta/filtro", "gestion", listaVentas.getTamanio());
+        for (int i = 0; i < listaVentas.getTamanio(); ++i) {
+            Venta ventaActual = listaVentas.getDato(i);
+
+            string paisNormalizado = normalizeString(ventaActual.pais);
+            string ciudadNormalizada = normalizeString(ventaActual.ciudad);
+
+            if (paisNormalizado == filtroNormalizado || ciudadNormalizada == filtroNormalizado) { g_condCounters.eliminarVenta_ifs++; 
+                ventasFiltradas.push_back({i, ventaActual});
+            }
+        }
+    }
+
+    if (ventasFiltradas.empty()) { g_condCounters.eliminarVenta_ifs++;
+        cout << "No se encontraron ventas que coincidan con el filtro "<< filtro << "'." << endl;
+        return;
+    }
+
+    cout << "\nVentas encontradas para el filtro " << filtro << " :\n";
+    cout << "--------------------------------------------------\n";
+    for (size_t i = 0; i < ventasFiltradas.size(); ++i) {
+        cout << "[" << i + 1 << "] ID: " << ventasFiltradas[i].second.idVenta
+             << ", Fecha: " << ventasFiltradas[i].second.fecha
+             << ", Pais: " << ventasFiltradas[i].second.pais
+             << ", Ciudad: " << ventasFiltradas[i].second.ciudad
+             << ", Monto: $" << fijo2(ventasFiltradas[i].second.montoTotal) << endl;
+    }
+    cout << "--------------------------------------------------\n";
+
+    cout << "Ingrese el ID de la venta que desea eliminar (o escriba 'cancelar' para abortar): ";
+    string idAEliminar;
+    getline(cin, idAEliminar);
+
+    if (idAEliminar == "cancelar") { g_condCounters.eliminarVenta_ifs++; 
+        cout << "Operacion de eliminacion cancelada." << endl;
+        return;
+    }
+
+    int originalIndexToRemove = -1;
+    for (const auto& par : ventasFiltradas) {
+        if (par.second.idVenta == idAEliminar) { g_condCounters.eliminarVenta_ifs++; 
+            originalIndexToRemove = par.first;
+            break;
+        }
+    }
+
+    if (originalIndexToRemove != -1) { g_condCounters.eliminarVenta_ifs++; 
+        cout << "¿Esta seguro que desea eliminar la venta con ID " << idAEliminar << "? (s/n): ";
+        char confirm;
+        cin >> confirm;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+        if (tolower(confirm) == 's') { g_condCounters.eliminarVenta_ifs++; 
+            try {
+                TemporizadorFase temporizador("eliminarVenta/remover", "gestion", originalIndexToRemove + 1);
+                unsigned long long version = listaVentas.getVersion();
+                listaVentas.remover(originalIndexToRemove);
+                g_indicesVentas.ventaEliminada(listaVentas, version, originalIndexToRemove);
+                if (g_observadorGestion != nullptr) g_observadorGestion->ventaEliminada(idAEliminar, originalIndexToRemove);
+                cout << "Venta con ID "<<idAEliminar << " eliminada exitosamente." << endl;
+            } catch (int e) {
+                cout << "Error al intentar remover la venta. Codigo: " << e << endl;
+            } catch (const runtime_error& e) {
+                cout << "Error al intentar remover la venta: " << e.what() << endl;
+            }
+        } else { g_condCounters.eliminarVenta_ifs++; 
+            cout << "Eliminacion cancelada por el usuario." << endl;
+        }
+    } else { g_condCounters.eliminarVenta_ifs++;
+        cout << "El ID '" << idAEliminar << "' no se encontro en la lista de ventas filtradas. Asegurese de ingresar un ID valido de la lista mostrada." << endl;
+    }
+}
+
+void modificarVenta(Lista<Venta>& listaVentas) {
+    g_condCounters.modificarVenta_ifs = 0; // Reiniciar contador
+    cout << "\n--- MODIFICAR VENTA ---\n";
+    cout << "Ingrese el ID de la venta a modificar (o 'cancelar' para volver): ";
+    string idAModificar;
+    getline(cin, idAModificar);
+
+    if (idAModificar == "cancelar") { g_condCounters.modificarVenta_ifs++; 
+        cout << "Operacion de modificacion cancelada." << endl;
+        return;
+    }
+
+    int indexToModify = -1;
+    {
+        TemporizadorFase temporizador("modificarVenta/busqueda", "gestion");
+        for (int i = 0; i < listaVentas.getTamanio(); ++i) {
+            if (listaVentas.getDato(i).idVenta == idAModificar) { g_condCounters.modificarVenta_ifs++; 
+                indexToModify = i;
+                break;
+            }
+        }
+        temporizador.setFilas(indexToModify == -1 ? listaVentas.getTamanio() : indexToModify + 1);
+    }
+
+    if (indexToModify == -1) { g_condCounters.modificarVenta_ifs++; 
+        cout << "Venta con ID '" << idAModificar << "' no encontrada." << endl;
+        return;
+    }
+
+    Venta ventaOriginal = listaVentas.getDato(indexToModify);
+    cout << "\nVenta encontrada (ID: " << ventaOriginal.idVenta << "):" << endl;
+    ventaOriginal.mostrar();
+    cout << "\nIngrese nuevos valores (deje vacio y presione Enter para mantener el valor actual):\n";
+
+    string input;
+    string newFecha = ventaOriginal.fecha;
+    string newPais = ventaOriginal.pais;
+    string newCiudad = ventaOriginal.ciudad;
+    string newCliente = ventaOriginal.cliente;
+    string newProducto = ventaOriginal.producto;
+    string newCategoria = ventaOriginal.categoria;
+    int newCantidad = ventaOriginal.cantidad;
+    float newPrecioUnitario = ventaOriginal.precioUnitario;
+    string newMedioEnvio = ventaOriginal.medioEnvio;
+    string newEstadoEnvio = ventaOriginal.estadoEnvio;
+ 
+    cout << "Fecha (" << ventaOriginal.fecha << "): ";
+    getline(cin, input);
+    if (!input.empty()) { g_condCounters.modificarVenta_ifs++; newFecha = input; } 
+
+    cout << "Pais (" << ventaOriginal.pais << "): ";
+    getline(cin, input);
+    if (!input.empty()) { g_condCounters.modificarVenta_ifs++; newPais = input; } 
+
+    cout << "Ciudad (" << ventaOriginal.ciudad << "): ";
+    getline(cin, input);
+    if (!input.empty()) { g_condCounters.modificarVenta_ifs++; newCiudad = input; } 
+
+    cout << "Cliente (" << ventaOriginal.cliente << "): ";
+    getline(cin, input);
+    if (!input.empty()) { g_condCounters.modificarVenta_ifs++; newCliente = input; } 
+
+    cout << "Producto (" << ventaOriginal.producto << "): ";
+    getline(cin, input);
+    if (!input.empty()) { g_condCounters.modificarVenta_ifs++; newProducto = input; } 
+
+    cout << "Categoria (" << ventaOriginal.categoria << "): ";
+    getline(cin, input);
+    if (!input.empty()) { g_condCounters.modificarVenta_ifs++; newCategoria = input; } 
+
+    cout << "Cantidad (" << ventaOriginal.cantidad << "): ";
+    getline(cin, input);
+    if (!input.empty()) { g_condCounters.modificarVenta_ifs++; 
+        try {
+            newCantidad = stoi(input);
+        } catch (const invalid_argument& e) { 
+            cout << "Cantidad invalida. Se mantiene el valor original." << endl;
+        } catch (const out_of_range& e) { 
+            cout << "Cantidad fuera de rango. Se mantiene el valor original." << endl;
+        }
+    }
+
+    cout << "Precio Unitario (" << ventaOriginal.precioUnitario << "): ";
+    getline(cin, input);
+    if (!input.empty()) { g_condCounters.modificarVenta_ifs++; 
+        try {
+            newPrecioUnitario = stof(input);
+        } catch (const invalid_argument& e) { g_condCounters.modificarVenta_ifs++; 
+            cout << "Precio Unitario invalido. Se mantiene el valor original." << endl;
+        } catch (const out_of_range& e) { g_condCounters.modificarVenta_ifs++; 
+            cout << "Precio Unitario fuera de rango. Se mantiene el valor original." << endl;
+        }
+    }
+
+    float newMontoTotal = newCantidad * newPrecioUnitario; // Recalcular monto total
+
+    cout << "Medio de Envio (" << ventaOriginal.medioEnvio << "): ";
+    getline(cin, input);
+    if (!input.empty()) { g_condCounters.modificarVenta_ifs++; newMedioEnvio = input; } 
+
+    cout << "Estado de Envio (" << ventaOriginal.estadoEnvio << "): ";
+    getline(cin, input);
+    if (!input.empty()) { g_condCounters.modificarVenta_ifs++; newEstadoEnvio = input; } 
+
+    Venta ventaModificada(ventaOriginal.idVenta, newFecha, newPais, newCiudad, newCliente,
+                          newProducto, newCategoria, newCantidad, newPrecioUnitario,
+                          newMontoTotal, newMedioEnvio, newEstadoEnvio);
+
+    try {
+        TemporizadorFase temporizador("modificarVenta/reemplazo", "gestion", indexToModify + 1);
+        unsigned long long version = listaVentas.getVersion();
+        listaVentas.reemplazar(indexToModify, ventaModificada);
+        g_indicesVentas.ventaReemplazada(listaVentas, version, indexToModify);
+        if (g_observadorGestion != nullptr) g_observadorGestion->ventaModificada(ventaModificada, indexToModify);
+        cout << "\nVenta con ID '" << idAModificar << "' modificada exitosamente." << endl;
+        ventaModificada.mostrar();
+    } catch (int e) {
+        cout << "Error al intentar reemplazar la venta en la lista. Codigo: " << e << endl;
+    } catch (const runtime_error& e) {
+        cout << "Error al intentar reemplazar la venta en la lista: " << e.what() << endl;
+    }
+}
+
+#endif // GESTION_H
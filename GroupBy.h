@@ -0,0 +1,338 @@
+#ifndef GROUPBY_H
+#define GROUPBY_H
+
+// Agrupamiento genérico de ventas: GroupBy<Claves<...>, Agregados...>.
+//
+// Reemplaza a los HashMapList anidados que armaba cada análisis a mano
+// (HashMapList<pais, HashMapList<ciudad, X*>*> con new/delete y get/remove/put
+// por fila). Las columnas clave y los agregados se eligen en tiempo de
+// compilación, así que cada combinación genera su propio código sin punteros
+// a función ni tipos borrados. Una clave compuesta como (pais, ciudad) es una
+// sola entrada de una tabla plana:
+//
+//   GroupBy<Claves<ColumnaPais, ColumnaCiudad>, Suma<ColumnaMonto>> g;
+//   g.agregar(listaVentas);
+//   for (const auto& grupo : g.getGrupos())
+//       ... grupo.clave<0>(), grupo.clave<1>(), grupo.valor<0>() ...
+//
+// Los grupos se guardan contiguos en el orden en que aparecen por primera vez
+// y la tabla hash (direccionamiento abierto, sondeo lineal) sólo guarda su
+// posición. Al buscar se compara contra los campos de la venta sin copiarlos;
+// las claves se copian una vez, al crear el grupo.
+//
+// Agregados: Suma, Conteo, Promedio, Minimo, Maximo y ArgMax. Las sumas se
+// hacen en el tipo de la columna (float para montos) y en el orden de las
+// filas, igual que los análisis originales, para que den los mismos valores.
+// Suma y Conteo tienen además margen() (siempre cero), para que los análisis
+// usen en su lugar los agregados estimados sobre una muestra (Muestreo.h).
+//
+// getBytes() estima la memoria de la tabla, y agregar(venta, fila) y
+// agregarGrupo() permiten agrupar un archivo por partes y juntar grupos ya
+// agregados: los usa GroupByExterno (AgregacionExterna.h) para agrupar con un
+// presupuesto de memoria.
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Venta.h"
+#include "Lista.h"
+
+using namespace std;
+
+// --- Columnas ---
+// Cada columna expone su tipo y cómo leerla de una venta.
+
+struct ColumnaPais {
+    typedef string Tipo;
+    static const string& de(const Venta& v) { return v.pais; }
+};
+
+struct ColumnaCiudad {
+    typedef string Tipo;
+    static const string& de(const Venta& v) { return v.ciudad; }
+};
+
+struct ColumnaProducto {
+    typedef string Tipo;
+    static const string& de(const Venta& v) { return v.producto; }
+};
+
+struct ColumnaCategoria {
+    typedef string Tipo;
+    static const string& de(const Venta& v) { return v.categoria; }
+};
+
+struct ColumnaFecha {
+    typedef string Tipo;
+    static const string& de(const Venta& v) { return v.fecha; }
+};
+
+struct ColumnaMedioEnvio {
+    typedef string Tipo;
+    static const string& de(const Venta& v) { return v.medioEnvio; }
+};
+
+struct ColumnaMonto {
+    typedef float Tipo;
+    static float de(const Venta& v) { return v.montoTotal; }
+};
+
+struct ColumnaCantidad {
+    typedef int Tipo;
+    static int de(const Venta& v) { return v.cantidad; }
+};
+
+struct ColumnaPrecioUnitario {
+    typedef float Tipo;
+    static float de(const Venta& v) { return v.precioUnitario; }
+};
+
+// --- Agregados ---
+// agregar() recibe cada venta del grupo; valor() devuelve el resultado.
+
+template <class Columna>
+struct Suma {
+    typename Columna::Tipo total = typename Columna::Tipo();
+    void agregar(const Venta& v) { total += Columna::de(v); }
+    typename Columna::Tipo valor() const { return total; }
+    double margen() const { return 0.0; }
+};
+
+struct Conteo {
+    int veces = 0;
+    void agregar(const Venta&) { veces++; }
+    int valor() const { return veces; }
+    double margen() const { return 0.0; }
+};
+
+template <class Columna>
+struct Promedio {
+    double total = 0.0;
+    long long filas = 0;
+    void agregar(const Venta& v) { total += Columna::de(v); filas++; }
+    double valor() const { return filas > 0 ? total / filas : 0.0; }
+};
+
+template <class Columna>
+struct Minimo {
+    typename Columna::Tipo minimo = typename Columna::Tipo();
+    bool hay = false;
+    void agregar(const Venta& v) {
+        typename Columna::Tipo x = Columna::de(v);
+        if (!hay || x < minimo) { minimo = x; hay = true; }
+    }
+    typename Columna::Tipo valor() const { return minimo; }
+};
+
+template <class Columna>
+struct Maximo {
+    typename Columna::Tipo maximo = typename Columna::Tipo();
+    bool hay = false;
+    void agregar(const Venta& v) {
+        typename Columna::Tipo x = Columna::de(v);
+        if (!hay || x > maximo) { maximo = x; hay = true; }
+    }
+    typename Columna::Tipo valor() const { return maximo; }
+};
+
+// Valor de 'Resultado' en la venta con mayor 'Columna' (la primera, si empatan)
+template <class Columna, class Resultado>
+struct ArgMax {
+    typename Columna::Tipo maximo = typename Columna::Tipo();
+    typename Resultado::Tipo elegido = typename Resultado::Tipo();
+    bool hay = false;
+    void agregar(const Venta& v) {
+        typename Columna::Tipo x = Columna::de(v);
+        if (!hay || x > maximo) { maximo = x; elegido = Resultado::de(v); hay = true; }
+    }
+    const typename Resultado::Tipo& valor() const { return elegido; }
+};
+
+// --- GroupBy ---
+
+template <class... Columnas>
+struct Claves {};
+
+template <class ClavesGrupo, class... Agregados>
+class GroupBy;
+
+template <class... Columnas, class... Agregados>
+class GroupBy<Claves<Columnas...>, Agregados...> {
+public:
+    typedef tuple<typename Columnas::Tipo...> Clave;
+
+    struct Grupo {
+        Clave claves;
+        tuple<Agregados...> agregados;
+        size_t hashClave;
+        long long primeraFila; // filas numeradas desde 0 en el orden de agregar()
+        long long ultimaFila;
+
+        template <size_t I>
+        const typename tuple_element<I, Clave>::type& clave() const { return get<I>(claves); }
+
+        template <size_t I>
+        auto valor() const { return get<I>(agregados).valor(); }
+
+        // Margen del intervalo de confianza de valor<I>() (cero si es exacto)
+        template <size_t I>
+        double margen() const { return get<I>(agregados).margen(); }
+    };
+
+private:
+    static constexpr uint32_t VACIO = 0; // en 'indices', posición del grupo + 1
+
+    vector<Grupo> grupos;
+    vector<uint32_t> indices; // tamaño potencia de dos
+    long long filas = 0;
+    size_t bytesClaves = 0;   // texto de las claves fuera de los string
+
+    // Misma combinación que boost::hash_combine
+    static void combinarHash(size_t& h, size_t valor) {
+        h ^= valor + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+
+    template <size_t... I>
+    static size_t hashDeClave(const Clave& clave, index_sequence<I...>) {
+        size_t h = 0;
+        (combinarHash(h, hash<typename Columnas::Tipo>()(get<I>(clave))), ...);
+        return h;
+    }
+
+    // Bytes de un valor de la clave fuera del grupo: el texto de los string
+    // que no entra en el propio objeto
+    static size_t bytesFueraDelGrupo(const string& s) {
+        const char* datos = s.data();
+        const char* objeto = reinterpret_cast<const char*>(&s);
+        return datos >= objeto && datos < objeto + sizeof(string) ? 0 : s.capacity() + 1;
+    }
+
+    template <class T>
+    static size_t bytesFueraDelGrupo(const T&) {
+        return 0;
+    }
+
+    template <size_t... I>
+    static size_t bytesFueraDelGrupo(const Clave& clave, index_sequence<I...>) {
+        return (size_t(0) + ... + bytesFueraDelGrupo(get<I>(clave)));
+    }
+
+    template <size_t... I>
+    static bool coincide(const Grupo& g, const Venta& v, index_sequence<I...>) {
+        return ((get<I>(g.claves) == Columnas::de(v)) && ...);
+    }
+
+    template <size_t... I>
+    static void agregarEn(Grupo& g, const Venta& v, index_sequence<I...>) {
+        (get<I>(g.agregados).agregar(v), ...);
+    }
+
+    void reconstruirIndices(size_t capacidad) {
+        indices.assign(capacidad, VACIO);
+        size_t mascara = capacidad - 1;
+        for (size_t i = 0; i < grupos.size(); ++i) {
+            size_t pos = grupos[i].hashClave & mascara;
+            while (indices[pos] != VACIO) pos = (pos + 1) & mascara;
+            indices[pos] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+public:
+    explicit GroupBy(size_t capacidadInicial = 64) {
+        size_t capacidad = 16;
+        while (capacidad < capacidadInicial * 2) capacidad <<= 1;
+        indices.assign(capacidad, VACIO);
+    }
+
+    static size_t hashDe(const Venta& v) {
+        size_t h = 0;
+        (combinarHash(h, hash<typename Columnas::Tipo>()(Columnas::de(v))), ...);
+        return h;
+    }
+
+    // El mismo hashDe() de una venta con esa clave
+    static size_t hashDe(const Clave& clave) {
+        return hashDeClave(clave, index_sequence_for<Columnas...>());
+    }
+
+    void agregar(const Venta& v) {
+        agregar(v, filas);
+    }
+
+    // Agrega la venta como la fila 'fila' (su posición en el archivo cuando
+    // se agrupa una parte de las ventas)
+    void agregar(const Venta& v, long long fila) {
+        typedef index_sequence_for<Columnas...> SecuenciaClaves;
+        size_t h = hashDe(v);
+        size_t mascara = indices.size() - 1;
+        size_t pos = h & mascara;
+        while (indices[pos] != VACIO) {
+            Grupo& g = grupos[indices[pos] - 1];
+            if (g.hashClave == h && coincide(g, v, SecuenciaClaves())) {
+                agregarEn(g, v, index_sequence_for<Agregados...>());
+                g.ultimaFila = fila;
+                filas++;
+                return;
+            }
+            pos = (pos + 1) & mascara;
+        }
+
+        grupos.push_back(Grupo{Clave(Columnas::de(v)...), tuple<Agregados...>(), h, fila, fila});
+        agregarEn(grupos.back(), v, index_sequence_for<Agregados...>());
+        filas++;
+        bytesClaves += bytesFueraDelGrupo(grupos.back().claves, SecuenciaClaves());
+        indices[pos] = static_cast<uint32_t>(grupos.size());
+        // Factor de carga máximo 1/2
+        if (grupos.size() * 2 > indices.size()) reconstruirIndices(indices.size() * 2);
+    }
+
+    // Incorpora un grupo ya agregado en otra parte (por ejemplo, leído de
+    // disco), con su hashClave. Su clave no tiene que estar en la tabla.
+    void agregarGrupo(Grupo grupo) {
+        size_t mascara = indices.size() - 1;
+        size_t pos = grupo.hashClave & mascara;
+        while (indices[pos] != VACIO) pos = (pos + 1) & mascara;
+        grupos.push_back(move(grupo));
+        bytesClaves += bytesFueraDelGrupo(grupos.back().claves, index_sequence_for<Columnas...>());
+        indices[pos] = static_cast<uint32_t>(grupos.size());
+        if (grupos.size() * 2 > indices.size()) reconstruirIndices(indices.size() * 2);
+    }
+
+    // Agrega todas las ventas recorriendo los nodos (sin copiarlas)
+    void agregar(const Lista<Venta>& lista) {
+        for (Nodo<Venta>* nodo = lista.getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+            agregar(nodo->verDato());
+        }
+    }
+
+    // Grupos en el orden en que aparecieron por primera vez
+    const vector<Grupo>& getGrupos() const {
+        return grupos;
+    }
+
+    size_t getTamanio() const {
+        return grupos.size();
+    }
+
+    long long getFilas() const {
+        return filas;
+    }
+
+    // Memoria de la tabla: grupos, índice y texto de las claves
+    size_t getBytes() const {
+        return grupos.capacity() * sizeof(Grupo) + indices.capacity() * sizeof(uint32_t) + bytesClaves;
+    }
+
+    // Lo que llega a ocupar la tabla en su próximo crecimiento: mientras se
+    // copian, el vector de grupos y el índice conviven con los nuevos, del
+    // doble de tamaño
+    size_t getBytesAlCrecer() const {
+        return getBytes() + 2 * (grupos.capacity() * sizeof(Grupo) + indices.capacity() * sizeof(uint32_t));
+    }
+};
+
+#endif // GROUPBY_H
@@ -0,0 +1,811 @@
+#ifndef INDICEVENTAS_H
+#define INDICEVENTAS_H
+
+// Índices de bitmaps sobre las columnas de pocos valores (país, categoría,
+// producto, medio y estado de envío).
+//
+// Por cada valor de cada columna se guarda el conjunto de filas (posiciones
+// en la lista) que lo tienen, como un bitmap comprimido al estilo roaring: el
+// espacio de filas se parte en bloques de 65536 y cada bloque guarda sus
+// filas como un arreglo ordenado de uint16 (si son pocas) o como un bitmap de
+// 1024 palabras (si son muchas). Un filtro compuesto ("ventas de Peru por
+// Aereo en camino") es la intersección de los bitmaps de cada condición,
+// palabra a palabra, y recién después se visitan las filas que quedaron: el
+// índice guarda el nodo de cada fila, así que no se recorre la lista ni se
+// comparan strings.
+//
+// Los valores se comparan normalizados (en minúsculas), como hacen las
+// consultas con normalizeString.
+//
+// g_indicesVentas guarda el índice de cada lista y lo reconoce por la
+// identidad y la versión de la lista (Lista::getIdentidad/getVersion). Las
+// altas, bajas y modificaciones de Gestion.h lo actualizan en el lugar; si la
+// lista cambió por otro camino (carga, WAL) el índice deja de coincidir con
+// la versión y se reconstruye la próxima vez que se pide.
+//
+// El índice guarda además una copia columnar del monto total y la cantidad de
+// cada fila: junto con el código de cada columna indexada (codigoDeFila) son
+// arreglos contiguos sobre los que corren los kernels de KernelsColumnas.h
+// (sumar los montos de un país es comparar códigos de a 8 filas).
+//
+// También arma y mantiene el cubo país x producto de CuboVentas.h y las
+// series de ventas por día de SerieDiaria.h (con el día de cada fila, leído
+// una vez de su fecha), y un resumen de cuantiles (KLL, Sketches.h) del
+// monto de las ventas de cada país y de cada categoría. El KLL no admite
+// bajas: una baja o una modificación vuelve a armar el del país y la
+// categoría afectados con sus filas.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "Venta.h"
+#include "Lista.h"
+#include "Metricas.h"
+#include "CuboVentas.h"
+#include "SerieDiaria.h"
+#include "Sketches.h"
+
+using namespace std;
+
+// dst = a & b en 'n' palabras (n par); devuelve la cantidad de bits encendidos
+inline uint32_t interseccionPalabras(const uint64_t* a, const uint64_t* b, uint64_t* dst, size_t n) {
+#ifdef __SSE2__
+    for (size_t i = 0; i < n; i += 2) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_and_si128(x, y));
+    }
+#else
+    for (size_t i = 0; i < n; ++i) dst[i] = a[i] & b[i];
+#endif
+    uint32_t bits = 0;
+    for (size_t i = 0; i < n; ++i) bits += __builtin_popcountll(dst[i]);
+    return bits;
+}
+
+// --- BitmapRoaring ---
+
+class BitmapRoaring {
+public:
+    static const uint32_t MAXIMO_ARREGLO = 4096; // más valores: el bloque pasa a bitmap
+    static const size_t PALABRAS = 1024;         // 65536 bits por bloque
+
+private:
+    struct Contenedor {
+        uint16_t alto;             // 16 bits altos de todas sus filas
+        uint32_t cardinalidad = 0;
+        vector<uint16_t> arreglo;  // valores ordenados, si 'bits' está vacío
+        vector<uint64_t> bits;     // PALABRAS palabras, si el bloque es denso
+
+        explicit Contenedor(uint16_t a) : alto(a) {}
+
+        bool esDenso() const {
+            return !bits.empty();
+        }
+
+        bool contiene(uint16_t v) const {
+            if (esDenso()) return (bits[v >> 6] >> (v & 63)) & 1;
+            return binary_search(arreglo.begin(), arreglo.end(), v);
+        }
+
+        void aDenso() {
+            bits.assign(PALABRAS, 0);
+            for (uint16_t v : arreglo) bits[v >> 6] |= 1ULL << (v & 63);
+            vector<uint16_t>().swap(arreglo);
+        }
+
+        void aArreglo() {
+            arreglo.clear();
+            arreglo.reserve(cardinalidad);
+            recorrer(0, [this](uint32_t v) { arreglo.push_back(static_cast<uint16_t>(v)); });
+            vector<uint64_t>().swap(bits);
+        }
+
+        bool agregar(uint16_t v) {
+            if (esDenso()) {
+                uint64_t& palabra = bits[v >> 6];
+                uint64_t bit = 1ULL << (v & 63);
+                if (palabra & bit) return false;
+                palabra |= bit;
+            } else if (arreglo.empty() || arreglo.back() < v) {
+                arreglo.push_back(v); // caso común: filas agregadas en orden
+            } else {
+                auto it = lower_bound(arreglo.begin(), arreglo.end(), v);
+                if (*it == v) return false;
+                arreglo.insert(it, v);
+            }
+            cardinalidad++;
+            if (!esDenso() && cardinalidad > MAXIMO_ARREGLO) aDenso();
+            return true;
+        }
+
+        bool quitar(uint16_t v) {
+            if (esDenso()) {
+                uint64_t& palabra = bits[v >> 6];
+                uint64_t bit = 1ULL << (v & 63);
+                if (!(palabra & bit)) return false;
+                palabra &= ~bit;
+                cardinalidad--;
+                if (cardinalidad <= MAXIMO_ARREGLO) aArreglo();
+                return true;
+            }
+            auto it = lower_bound(arreglo.begin(), arreglo.end(), v);
+            if (it == arreglo.end() || *it != v) return false;
+            arreglo.erase(it);
+            cardinalidad--;
+            return true;
+        }
+
+        // Mayor valor (el contenedor no debe estar vacío)
+        uint16_t maximo() const {
+            if (!esDenso()) return arreglo.back();
+            size_t w = PALABRAS - 1;
+            while (bits[w] == 0) w--;
+            return static_cast<uint16_t>(w * 64 + 63 - __builtin_clzll(bits[w]));
+        }
+
+        // Los valores mayores que q bajan en uno (q no debe estar)
+        void correrDesde(uint16_t q) {
+            if (!esDenso()) {
+                for (auto it = upper_bound(arreglo.begin(), arreglo.end(), q); it != arreglo.end(); ++it) (*it)--;
+                return;
+            }
+            size_t w0 = q >> 6;
+            uint64_t bajos = (1ULL << (q & 63)) - 1; // bits de la primera palabra que no se mueven
+            for (size_t w = w0; w < PALABRAS; ++w) {
+                uint64_t siguiente = w + 1 < PALABRAS ? bits[w + 1] : 0;
+                uint64_t palabra = bits[w];
+                uint64_t fijos = w == w0 ? palabra & bajos : 0;
+                uint64_t movidos = w == w0 ? palabra & ~bajos : palabra;
+                bits[w] = fijos | (movidos >> 1) | (siguiente << 63);
+            }
+        }
+
+        template <class F>
+        void recorrer(uint32_t base, F f) const {
+            if (!esDenso()) {
+                for (uint16_t v : arreglo) f(base | v);
+                return;
+            }
+            for (size_t w = 0; w < PALABRAS; ++w) {
+                uint64_t palabra = bits[w];
+                while (palabra != 0) {
+                    f(base + static_cast<uint32_t>(w * 64 + __builtin_ctzll(palabra)));
+                    palabra &= palabra - 1;
+                }
+            }
+        }
+    };
+
+    vector<Contenedor> contenedores; // ordenados por 'alto'
+
+    // Posición del primer contenedor con alto >= a
+    size_t buscarContenedor(uint32_t a) const {
+        if (!contenedores.empty() && contenedores.back().alto < a) return contenedores.size();
+        size_t bajo = 0, alto = contenedores.size();
+        while (bajo < alto) {
+            size_t medio = (bajo + alto) / 2;
+            if (contenedores[medio].alto < a) bajo = medio + 1;
+            else alto = medio;
+        }
+        return bajo;
+    }
+
+public:
+    void agregar(uint32_t fila) {
+        uint16_t a = static_cast<uint16_t>(fila >> 16);
+        size_t i = buscarContenedor(a);
+        if (i == contenedores.size() || contenedores[i].alto != a) {
+            contenedores.insert(contenedores.begin() + i, Contenedor(a));
+        }
+        contenedores[i].agregar(static_cast<uint16_t>(fila & 0xFFFF));
+    }
+
+    bool quitar(uint32_t fila) {
+        uint16_t a = static_cast<uint16_t>(fila >> 16);
+        size_t i = buscarContenedor(a);
+        if (i == contenedores.size() || contenedores[i].alto != a) return false;
+        bool estaba = contenedores[i].quitar(static_cast<uint16_t>(fila & 0xFFFF));
+        if (contenedores[i].cardinalidad == 0) contenedores.erase(contenedores.begin() + i);
+        return estaba;
+    }
+
+    bool contiene(uint32_t fila) const {
+        uint16_t a = static_cast<uint16_t>(fila >> 16);
+        size_t i = buscarContenedor(a);
+        return i < contenedores.size() && contenedores[i].alto == a &&
+               contenedores[i].contiene(static_cast<uint16_t>(fila & 0xFFFF));
+    }
+
+    // Tras borrar la fila 'fila' de la lista: las filas posteriores bajan una
+    // posición. 'fila' ya no debe estar en el bitmap. Sólo se tocan los
+    // contenedores desde el bloque de 'fila', y nada si ninguna fila del bitmap
+    // es posterior (lo común al borrar cerca del final).
+    void correrDesde(uint32_t fila) {
+        uint16_t a = static_cast<uint16_t>(fila >> 16);
+        uint16_t bajo = static_cast<uint16_t>(fila & 0xFFFF);
+        size_t i = buscarContenedor(a);
+        if (i == contenedores.size()) return;
+        if (contenedores.back().alto == a && contenedores.back().maximo() < bajo) return;
+
+        for (size_t k = i; k < contenedores.size(); ++k) {
+            uint16_t alto = contenedores[k].alto;
+            if (alto > a && contenedores[k].contiene(0)) {
+                // La primera fila del bloque pasa a ser la última del anterior,
+                // que ya se corrió (o no existe y se crea)
+                contenedores[k].quitar(0);
+                if (k == 0 || contenedores[k - 1].alto != alto - 1) {
+                    contenedores.insert(contenedores.begin() + k, Contenedor(alto - 1));
+                    k++;
+                }
+                contenedores[k - 1].agregar(0xFFFF);
+            }
+            contenedores[k].correrDesde(alto == a ? bajo : 0);
+            if (contenedores[k].cardinalidad == 0) {
+                contenedores.erase(contenedores.begin() + k);
+                k--;
+            }
+        }
+    }
+
+    // Filas que están en los dos bitmaps
+    static BitmapRoaring interseccion(const BitmapRoaring& x, const BitmapRoaring& y) {
+        BitmapRoaring resultado;
+        size_t i = 0, j = 0;
+        while (i < x.contenedores.size() && j < y.contenedores.size()) {
+            const Contenedor& a = x.contenedores[i];
+            const Contenedor& b = y.contenedores[j];
+            if (a.alto < b.alto) { i++; continue; }
+            if (b.alto < a.alto) { j++; continue; }
+
+            Contenedor c(a.alto);
+            if (a.esDenso() && b.esDenso()) {
+                c.bits.resize(PALABRAS);
+                c.cardinalidad = interseccionPalabras(a.bits.data(), b.bits.data(), c.bits.data(), PALABRAS);
+                if (c.cardinalidad <= MAXIMO_ARREGLO) c.aArreglo();
+            } else if (a.esDenso() || b.esDenso()) {
+                const Contenedor& denso = a.esDenso() ? a : b;
+                const Contenedor& ralo = a.esDenso() ? b : a;
+                for (uint16_t v : ralo.arreglo) {
+                    if (denso.contiene(v)) c.arreglo.push_back(v);
+                }
+                c.cardinalidad = c.arreglo.size();
+            } else {
+                set_intersection(a.arreglo.begin(), a.arreglo.end(), b.arreglo.begin(), b.arreglo.end(),
+                                 back_inserter(c.arreglo));
+                c.cardinalidad = c.arreglo.size();
+            }
+            if (c.cardinalidad > 0) resultado.contenedores.push_back(move(c));
+            i++;
+            j++;
+        }
+        return resultado;
+    }
+
+    // Llama a f(fila) con cada fila, en orden creciente
+    template <class F>
+    void recorrer(F f) const {
+        for (const Contenedor& c : contenedores) c.recorrer(static_cast<uint32_t>(c.alto) << 16, f);
+    }
+
+    size_t getCardinalidad() const {
+        size_t total = 0;
+        for (const Contenedor& c : contenedores) total += c.cardinalidad;
+        return total;
+    }
+
+    size_t getBytes() const {
+        size_t total = contenedores.capacity() * sizeof(Contenedor);
+        for (const Contenedor& c : contenedores) {
+            total += c.arreglo.capacity() * sizeof(uint16_t) + c.bits.capacity() * sizeof(uint64_t);
+        }
+        return total;
+    }
+};
+
+// --- IndiceVentas ---
+
+enum ColumnaIndexada {
+    INDICE_PAIS,
+    INDICE_CATEGORIA,
+    INDICE_MEDIO_ENVIO,
+    INDICE_ESTADO_ENVIO,
+    INDICE_PRODUCTO,
+    CANTIDAD_COLUMNAS_INDEXADAS
+};
+
+inline const string& valorIndexado(const Venta& v, ColumnaIndexada columna) {
+    switch (columna) {
+        case INDICE_PAIS: return v.pais;
+        case INDICE_CATEGORIA: return v.categoria;
+        case INDICE_MEDIO_ENVIO: return v.medioEnvio;
+        case INDICE_ESTADO_ENVIO: return v.estadoEnvio;
+        default: return v.producto;
+    }
+}
+
+// Misma normalización que normalizeString (Analisis.h)
+inline string normalizarClaveIndice(string s) {
+    transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+
+// Condición de un filtro: columna = valor (sin distinguir mayúsculas)
+struct CondicionIndice {
+    ColumnaIndexada columna;
+    string valor;
+};
+
+class IndiceVentas {
+private:
+    struct IndiceColumna {
+        unordered_map<string, uint32_t> codigoPorClave; // valor normalizado -> código
+        unordered_map<string, uint32_t> codigoPorValor; // valor tal cual -> código (evita normalizar cada fila)
+        vector<BitmapRoaring> filas;                    // filas de cada código
+        vector<uint32_t> codigoDeFila;                  // código de cada fila
+        vector<string> valorDeCodigo;                   // primer valor tal cual de cada código
+    };
+
+    IndiceColumna columnas[CANTIDAD_COLUMNAS_INDEXADAS];
+    vector<Nodo<Venta>*> nodos; // nodo de cada fila, para visitarla sin recorrer la lista
+    vector<float> montos;       // montoTotal de cada fila
+    vector<int32_t> cantidades; // cantidad de cada fila
+    vector<unsigned long long> secuencias; // orden de llegada de cada fila (no cambia con las bajas)
+    unsigned long long siguienteSecuencia = 0;
+    CuboPaisProducto cubo;
+    vector<int32_t> diasDeFila; // día de la fecha de cada fila (SIN_DIA si no es válida)
+    SeriesDiarias series;
+    vector<ResumenCuantiles> cuantilesPais;      // montos por código de país
+    vector<ResumenCuantiles> cuantilesCategoria; // montos por código de categoría
+
+    static const int32_t SIN_DIA = INT32_MIN;
+
+    static int32_t diaDeVenta(const Venta& venta) {
+        long long dia;
+        return leerDia(venta.fecha, dia) ? static_cast<int32_t>(dia) : SIN_DIA;
+    }
+
+    // Suma (signo 1) o resta (signo -1) la fila en las series por día
+    void sumarASeries(size_t fila, int signo) {
+        if (diasDeFila[fila] == SIN_DIA) return;
+        series.sumar(columnas[INDICE_PAIS].codigoDeFila[fila], diasDeFila[fila],
+                     TotalesDia(signo * static_cast<double>(montos[fila]), signo * cantidades[fila], signo));
+    }
+
+    static uint32_t codificar(IndiceColumna& columna, const string& valor) {
+        auto it = columna.codigoPorValor.find(valor);
+        if (it != columna.codigoPorValor.end()) return it->second;
+        auto insertado = columna.codigoPorClave.emplace(normalizarClaveIndice(valor), columna.filas.size());
+        if (insertado.second) {
+            columna.filas.emplace_back();
+            columna.valorDeCodigo.push_back(valor);
+        }
+        uint32_t codigo = insertado.first->second;
+        columna.codigoPorValor.emplace(valor, codigo);
+        return codigo;
+    }
+
+    void indexarUltima(Nodo<Venta>* nodo) {
+        uint32_t fila = static_cast<uint32_t>(nodos.size());
+        nodos.push_back(nodo);
+        montos.push_back(nodo->verDato().montoTotal);
+        cantidades.push_back(nodo->verDato().cantidad);
+        secuencias.push_back(siguienteSecuencia++);
+        diasDeFila.push_back(diaDeVenta(nodo->verDato()));
+        for (int c = 0; c < CANTIDAD_COLUMNAS_INDEXADAS; ++c) {
+            IndiceColumna& columna = columnas[c];
+            uint32_t codigo = codificar(columna, valorIndexado(nodo->verDato(), static_cast<ColumnaIndexada>(c)));
+            columna.filas[codigo].agregar(fila);
+            columna.codigoDeFila.push_back(codigo);
+        }
+        sumarASeries(fila, 1);
+        agregarACuantiles(cuantilesPais, columnas[INDICE_PAIS].codigoDeFila.back(), montos.back());
+        agregarACuantiles(cuantilesCategoria, columnas[INDICE_CATEGORIA].codigoDeFila.back(), montos.back());
+        cubo.agregar(columnas[INDICE_PAIS].codigoDeFila.back(), columnas[INDICE_PRODUCTO].codigoDeFila.back(),
+                     nodo->verDato(), secuencias.back());
+    }
+
+    static void agregarACuantiles(vector<ResumenCuantiles>& cuantiles, uint32_t codigo, float monto) {
+        if (codigo >= cuantiles.size()) cuantiles.resize(codigo + 1);
+        cuantiles[codigo].agregar(monto);
+    }
+
+    // Vuelve a armar el resumen de cuantiles de un país o una categoría con
+    // los montos de sus filas. Devuelve las filas recorridas.
+    size_t recalcularCuantiles(vector<ResumenCuantiles>& cuantiles, ColumnaIndexada columna, uint32_t codigo) {
+        if (codigo >= cuantiles.size()) cuantiles.resize(codigo + 1);
+        cuantiles[codigo] = ResumenCuantiles();
+        const BitmapRoaring& filas = columnas[columna].filas[codigo];
+        filas.recorrer([&](uint32_t fila) { cuantiles[codigo].agregar(montos[fila]); });
+        return filas.getCardinalidad();
+    }
+
+    // Vuelven a sumar el país o el producto del cubo con sus filas, en el
+    // orden de la lista. Devuelven las filas recorridas.
+    size_t recalcularPais(uint32_t codigoPais) {
+        cubo.reiniciarPais(codigoPais);
+        const BitmapRoaring& filas = columnas[INDICE_PAIS].filas[codigoPais];
+        filas.recorrer([&](uint32_t fila) {
+            cubo.agregarAPais(codigoPais, nodos[fila]->verDato(), secuencias[fila]);
+        });
+        return filas.getCardinalidad();
+    }
+
+    size_t recalcularProducto(uint32_t codigoProducto) {
+        cubo.reiniciarProducto(codigoProducto);
+        const BitmapRoaring& filas = columnas[INDICE_PRODUCTO].filas[codigoProducto];
+        filas.recorrer([&](uint32_t fila) {
+            cubo.agregarAProducto(codigoProducto, nodos[fila]->verDato(), secuencias[fila]);
+        });
+        return filas.getCardinalidad();
+    }
+
+public:
+    explicit IndiceVentas(const Lista<Venta>& lista) {
+        nodos.reserve(lista.getTamanio());
+        montos.reserve(lista.getTamanio());
+        cantidades.reserve(lista.getTamanio());
+        secuencias.reserve(lista.getTamanio());
+        diasDeFila.reserve(lista.getTamanio());
+        for (Nodo<Venta>* nodo = lista.getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+            indexarUltima(nodo);
+        }
+        cubo.ordenarTodosLosPromedios();
+    }
+
+    // Copia de 'otro' para 'lista', que tiene las mismas ventas en el mismo
+    // orden pero en otros nodos (la copia de una versión de BaseVentas.h)
+    IndiceVentas(const IndiceVentas& otro, const Lista<Venta>& lista) : IndiceVentas(otro) {
+        size_t fila = 0;
+        for (Nodo<Venta>* nodo = lista.getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+            nodos[fila++] = nodo;
+        }
+    }
+
+    // Las actualizaciones devuelven las filas que tocaron: la agregada, o las
+    // que se recorrieron para recalcular el cubo y los cuantiles.
+
+    // La lista recibió una venta al final (insertarUltimo)
+    size_t agregarUltima(const Lista<Venta>& lista) {
+        indexarUltima(lista.getFin());
+        cubo.reubicarPromedios(columnas[INDICE_PAIS].codigoDeFila.back(), columnas[INDICE_PRODUCTO].codigoDeFila.back(),
+                               lista.getFin()->verDato().producto);
+        return 1;
+    }
+
+    // Se borró la fila 'fila' de la lista: las siguientes bajan una posición
+    size_t eliminar(int fila) {
+        sumarASeries(fila, -1);
+        uint32_t codigoPais = columnas[INDICE_PAIS].codigoDeFila[fila];
+        uint32_t codigoProducto = columnas[INDICE_PRODUCTO].codigoDeFila[fila];
+        uint32_t codigoCategoria = columnas[INDICE_CATEGORIA].codigoDeFila[fila];
+        for (IndiceColumna& columna : columnas) {
+            columna.filas[columna.codigoDeFila[fila]].quitar(fila);
+            for (BitmapRoaring& filas : columna.filas) filas.correrDesde(fila);
+            columna.codigoDeFila.erase(columna.codigoDeFila.begin() + fila);
+        }
+        nodos.erase(nodos.begin() + fila);
+        montos.erase(montos.begin() + fila);
+        cantidades.erase(cantidades.begin() + fila);
+        secuencias.erase(secuencias.begin() + fila);
+        diasDeFila.erase(diasDeFila.begin() + fila);
+        size_t recorridas = recalcularPais(codigoPais);
+        recorridas += recalcularProducto(codigoProducto);
+        recorridas += recalcularCuantiles(cuantilesPais, INDICE_PAIS, codigoPais);
+        recorridas += recalcularCuantiles(cuantilesCategoria, INDICE_CATEGORIA, codigoCategoria);
+        cubo.ordenarPromediosPais(codigoPais);
+        cubo.reubicarPromediosProducto(codigoProducto);
+        return recorridas;
+    }
+
+    // La fila 'fila' cambió de datos en el mismo nodo (reemplazar)
+    size_t reemplazar(int fila) {
+        const Venta& venta = nodos[fila]->verDato();
+        sumarASeries(fila, -1); // con el país, el día y los montos de antes
+        montos[fila] = venta.montoTotal;
+        cantidades[fila] = venta.cantidad;
+        diasDeFila[fila] = diaDeVenta(venta);
+        uint32_t paisAnterior = columnas[INDICE_PAIS].codigoDeFila[fila];
+        uint32_t productoAnterior = columnas[INDICE_PRODUCTO].codigoDeFila[fila];
+        uint32_t categoriaAnterior = columnas[INDICE_CATEGORIA].codigoDeFila[fila];
+        for (int c = 0; c < CANTIDAD_COLUMNAS_INDEXADAS; ++c) {
+            IndiceColumna& columna = columnas[c];
+            uint32_t nuevo = codificar(columna, valorIndexado(venta, static_cast<ColumnaIndexada>(c)));
+            uint32_t& anterior = columna.codigoDeFila[fila];
+            if (nuevo == anterior) continue;
+            columna.filas[anterior].quitar(fila);
+            columna.filas[nuevo].agregar(fila);
+            anterior = nuevo;
+        }
+        // Los montos o el medio pudieron cambiar aunque el país y el producto no
+        size_t recorridas = recalcularPais(paisAnterior);
+        uint32_t paisNuevo = columnas[INDICE_PAIS].codigoDeFila[fila];
+        if (paisNuevo != paisAnterior) recorridas += recalcularPais(paisNuevo);
+        recorridas += recalcularProducto(productoAnterior);
+        uint32_t productoNuevo = columnas[INDICE_PRODUCTO].codigoDeFila[fila];
+        if (productoNuevo != productoAnterior) recorridas += recalcularProducto(productoNuevo);
+        recorridas += recalcularCuantiles(cuantilesPais, INDICE_PAIS, paisAnterior);
+        if (paisNuevo != paisAnterior) recorridas += recalcularCuantiles(cuantilesPais, INDICE_PAIS, paisNuevo);
+        recorridas += recalcularCuantiles(cuantilesCategoria, INDICE_CATEGORIA, categoriaAnterior);
+        uint32_t categoriaNueva = columnas[INDICE_CATEGORIA].codigoDeFila[fila];
+        if (categoriaNueva != categoriaAnterior) {
+            recorridas += recalcularCuantiles(cuantilesCategoria, INDICE_CATEGORIA, categoriaNueva);
+        }
+        sumarASeries(fila, 1);
+        if (paisNuevo != paisAnterior) cubo.ordenarPromediosPais(paisAnterior);
+        cubo.ordenarPromediosPais(paisNuevo);
+        cubo.reubicarPromediosProducto(productoAnterior);
+        if (productoNuevo != productoAnterior) cubo.reubicarPromediosProducto(productoNuevo);
+        return recorridas;
+    }
+
+    // Código de 'valor' en la columna, o -1 si ninguna venta lo tuvo nunca
+    long long codigo(ColumnaIndexada columna, const string& valor) const {
+        const IndiceColumna& c = columnas[columna];
+        auto it = c.codigoPorClave.find(normalizarClaveIndice(valor));
+        return it == c.codigoPorClave.end() ? -1 : static_cast<long long>(it->second);
+    }
+
+    // Filas con columna = valor, o nullptr si ninguna venta lo tuvo nunca
+    const BitmapRoaring* filas(ColumnaIndexada columna, const string& valor) const {
+        long long c = codigo(columna, valor);
+        return c < 0 ? nullptr : &columnas[columna].filas[c];
+    }
+
+    // Filas que cumplen todas las condiciones (sin condiciones: ninguna)
+    BitmapRoaring filtrar(const vector<CondicionIndice>& condiciones) const {
+        vector<const BitmapRoaring*> conjuntos;
+        for (const CondicionIndice& condicion : condiciones) {
+            const BitmapRoaring* f = filas(condicion.columna, condicion.valor);
+            if (f == nullptr) return BitmapRoaring();
+            conjuntos.push_back(f);
+        }
+        if (conjuntos.empty()) return BitmapRoaring();
+        // Primero los más chicos: la intersección se achica antes
+        sort(conjuntos.begin(), conjuntos.end(), [](const BitmapRoaring* a, const BitmapRoaring* b) {
+            return a->getCardinalidad() < b->getCardinalidad();
+        });
+        BitmapRoaring resultado = *conjuntos[0];
+        for (size_t i = 1; i < conjuntos.size(); ++i) {
+            resultado = BitmapRoaring::interseccion(resultado, *conjuntos[i]);
+        }
+        return resultado;
+    }
+
+    // Llama a f(venta) con la venta de cada fila, en el orden de la lista
+    template <class F>
+    void recorrer(const BitmapRoaring& filas, F f) const {
+        filas.recorrer([&](uint32_t fila) { f(nodos[fila]->verDato()); });
+    }
+
+    size_t getFilas() const {
+        return nodos.size();
+    }
+
+    // Columnas contiguas, una posición por fila
+    const vector<uint32_t>& getCodigos(ColumnaIndexada columna) const {
+        return columnas[columna].codigoDeFila;
+    }
+
+    const vector<float>& getMontos() const {
+        return montos;
+    }
+
+    const vector<int32_t>& getCantidades() const {
+        return cantidades;
+    }
+
+    // Corte del cubo para el país o el producto (sin distinguir mayúsculas),
+    // o nullptr si no tiene ventas
+    const ResumenPais* resumenPais(const string& pais) const {
+        long long c = codigo(INDICE_PAIS, pais);
+        return c < 0 ? nullptr : cubo.pais(static_cast<uint32_t>(c));
+    }
+
+    const ResumenProducto* resumenProducto(const string& producto) const {
+        long long c = codigo(INDICE_PRODUCTO, producto);
+        return c < 0 ? nullptr : cubo.producto(static_cast<uint32_t>(c));
+    }
+
+    const CuboPaisProducto& getCubo() const {
+        return cubo;
+    }
+
+    // Serie por día de todas las ventas, o de las del país (sin distinguir
+    // mayúsculas; nullptr si no tiene ventas)
+    const SerieDiaria& serieGlobal() const {
+        return series.getGlobal();
+    }
+
+    const SerieDiaria* seriePais(const string& pais) const {
+        long long c = codigo(INDICE_PAIS, pais);
+        return c < 0 ? nullptr : series.pais(static_cast<uint32_t>(c));
+    }
+
+    // Cada país con su serie, con el nombre como apareció por primera vez
+    vector<pair<string, const SerieDiaria*>> seriesPorPais() const {
+        vector<pair<string, const SerieDiaria*>> resultado;
+        for (uint32_t c = 0; c < series.getCantidadPaises(); ++c) {
+            resultado.push_back({columnas[INDICE_PAIS].valorDeCodigo[c], series.pais(c)});
+        }
+        return resultado;
+    }
+
+    // Cada país (INDICE_PAIS) o categoría (INDICE_CATEGORIA) con su resumen
+    // de cuantiles de montos, con el nombre como apareció por primera vez
+    // (los que se quedaron sin ventas tienen el resumen vacío)
+    vector<pair<string, const ResumenCuantiles*>> cuantilesPor(ColumnaIndexada columna) const {
+        const vector<ResumenCuantiles>& cuantiles = columna == INDICE_PAIS ? cuantilesPais : cuantilesCategoria;
+        vector<pair<string, const ResumenCuantiles*>> resultado;
+        for (uint32_t c = 0; c < cuantiles.size(); ++c) {
+            resultado.push_back({columnas[columna].valorDeCodigo[c], &cuantiles[c]});
+        }
+        return resultado;
+    }
+
+    size_t getBytes() const {
+        size_t total = nodos.capacity() * sizeof(Nodo<Venta>*) + montos.capacity() * sizeof(float) +
+                       cantidades.capacity() * sizeof(int32_t) +
+                       secuencias.capacity() * sizeof(unsigned long long) + cubo.getBytes() +
+                       diasDeFila.capacity() * sizeof(int32_t) + series.getBytes();
+        for (const ResumenCuantiles& r : cuantilesPais) total += sizeof(ResumenCuantiles) + r.getBytes();
+        for (const ResumenCuantiles& r : cuantilesCategoria) total += sizeof(ResumenCuantiles) + r.getBytes();
+        for (const IndiceColumna& columna : columnas) {
+            total += columna.codigoDeFila.capacity() * sizeof(uint32_t);
+            for (const BitmapRoaring& f : columna.filas) total += f.getBytes();
+        }
+        return total;
+    }
+};
+
+// --- Registro de índices ---
+
+// Índice vigente de cada lista. Se guardan pocos: en modo servidor cada
+// escritura publica una lista nueva y los índices de las versiones viejas se
+// descartan solos. Quien obtuvo un índice lo conserva (shared_ptr) aunque se
+// descarte del registro.
+class RegistroIndices {
+private:
+    static const size_t MAXIMO_INDICES = 4;
+
+    struct Entrada {
+        unsigned long long identidad;
+        unsigned long long version;
+        shared_ptr<IndiceVentas> indice;
+        unsigned long long ultimoUso;
+    };
+
+    mutex mtx;
+    vector<Entrada> entradas;
+    unsigned long long reloj = 0;
+
+    // Requiere tener el mutex
+    Entrada* buscar(const Lista<Venta>& lista) {
+        for (Entrada& e : entradas) {
+            if (e.identidad == lista.getIdentidad()) return &e;
+        }
+        return nullptr;
+    }
+
+    // Aplica 'cambio' si el índice estaba al día antes de la modificación;
+    // si no, lo descarta para que se reconstruya al pedirlo. 'cambio' devuelve
+    // las filas que tocó.
+    template <class Cambio>
+    void actualizar(const Lista<Venta>& lista, unsigned long long versionAnterior, Cambio cambio) {
+        lock_guard<mutex> lock(mtx);
+        Entrada* e = buscar(lista);
+        if (e == nullptr) return;
+        if (e->version != versionAnterior) {
+            entradas.erase(entradas.begin() + (e - entradas.data()));
+            return;
+        }
+        // Si algún lector lo está usando, se modifica una copia
+        if (e->indice.use_count() > 1) e->indice = make_shared<IndiceVentas>(*e->indice);
+        TemporizadorFase temporizador("indice/actualizacion", "indice");
+        temporizador.setFilas(cambio(*e->indice));
+        e->version = lista.getVersion();
+    }
+
+    // Guarda 'indice' como el de 'lista' en su versión actual. Si no hay lugar
+    // se descarta el usado hace más tiempo. Requiere tener el mutex.
+    void registrar(const Lista<Venta>& lista, const shared_ptr<IndiceVentas>& indice) {
+        Entrada* e = buscar(lista);
+        if (e == nullptr) {
+            if (entradas.size() >= MAXIMO_INDICES) {
+                auto masViejo = min_element(entradas.begin(), entradas.end(), [](const Entrada& a, const Entrada& b) {
+                    return a.ultimoUso < b.ultimoUso;
+                });
+                entradas.erase(masViejo);
+            }
+            entradas.push_back(Entrada{lista.getIdentidad(), 0, nullptr, 0});
+            e = &entradas.back();
+        }
+        e->version = lista.getVersion();
+        e->indice = indice;
+        e->ultimoUso = ++reloj;
+    }
+
+public:
+    // Índice al día de 'lista'; lo construye si no hay uno
+    shared_ptr<const IndiceVentas> obtener(const Lista<Venta>& lista) {
+        {
+            lock_guard<mutex> lock(mtx);
+            Entrada* e = buscar(lista);
+            if (e != nullptr && e->version == lista.getVersion()) {
+                e->ultimoUso = ++reloj;
+                return e->indice;
+            }
+        }
+
+        // Se construye sin el mutex: otros hilos pueden seguir usando los suyos
+        shared_ptr<IndiceVentas> nuevo;
+        {
+            TemporizadorFase temporizador("indice/construccion", "indice", lista.getTamanio());
+            nuevo = make_shared<IndiceVentas>(lista);
+        }
+
+        lock_guard<mutex> lock(mtx);
+        registrar(lista, nuevo);
+        return nuevo;
+    }
+
+    // 'copia' acaba de copiarse de 'original' (copia en escritura de
+    // BaseVentas.h). Si 'original' tiene un índice al día, la copia recibe uno
+    // propio con sus nodos, de modo que los avisos de Gestion.h lo actualicen y
+    // la siguiente consulta no tenga que reconstruirlo. Copiar el índice es
+    // O(n), como copiar la lista, pero sin volver a codificar cada fila.
+    void heredar(const Lista<Venta>& original, const Lista<Venta>& copia) {
+        shared_ptr<IndiceVentas> indiceOriginal;
+        {
+            lock_guard<mutex> lock(mtx);
+            Entrada* e = buscar(original);
+            if (e == nullptr || e->version != original.getVersion()) return;
+            indiceOriginal = e->indice;
+        }
+
+        shared_ptr<IndiceVentas> nuevo;
+        {
+            TemporizadorFase temporizador("indice/copia", "indice", copia.getTamanio());
+            nuevo = make_shared<IndiceVentas>(*indiceOriginal, copia);
+        }
+
+        lock_guard<mutex> lock(mtx);
+        registrar(copia, nuevo);
+    }
+
+    // Olvida el índice de una lista que se descarta (una copia que no llegó a
+    // publicarse), para que no ocupe el lugar de otro
+    void descartar(const Lista<Venta>& lista) {
+        lock_guard<mutex> lock(mtx);
+        Entrada* e = buscar(lista);
+        if (e != nullptr) entradas.erase(entradas.begin() + (e - entradas.data()));
+    }
+
+    // Avisos de Gestion.h, con la versión que tenía la lista antes del cambio
+
+    void ventaAgregada(const Lista<Venta>& lista, unsigned long long versionAnterior) {
+        actualizar(lista, versionAnterior, [&lista](IndiceVentas& indice) { return indice.agregarUltima(lista); });
+    }
+
+    void ventaEliminada(const Lista<Venta>& lista, unsigned long long versionAnterior, int posicion) {
+        actualizar(lista, versionAnterior, [posicion](IndiceVentas& indice) { return indice.eliminar(posicion); });
+    }
+
+    void ventaReemplazada(const Lista<Venta>& lista, unsigned long long versionAnterior, int posicion) {
+        actualizar(lista, versionAnterior, [posicion](IndiceVentas& indice) { return indice.reemplazar(posicion); });
+    }
+};
+
+RegistroIndices g_indicesVentas;
+
+#endif // INDICEVENTAS_H
@@ -0,0 +1,261 @@
+#ifndef KERNELSCOLUMNAS_H
+#define KERNELSCOLUMNAS_H
+
+// Kernels de filtro y reducción sobre columnas numéricas contiguas.
+//
+// Cada kernel recorre una columna de valores (float o int32) junto a una
+// columna de códigos de diccionario (por ejemplo el código de país de cada
+// fila, el de IndiceVentas) y reduce las filas cuyo código coincide: suma,
+// conteo, mínimo/máximo. También hay comparaciones contra un umbral que
+// escriben una máscara de bits, una palabra de 64 bits cada 64 filas.
+//
+// No hay saltos por fila: la coincidencia se convierte en una máscara y la
+// fila suma cero si no coincide. Hay dos implementaciones con los mismos
+// resultados (salvo el orden de las sumas en double): una escalar, que
+// compila en cualquier plataforma, y una AVX2 que procesa 8 filas por
+// instrucción. kernelsColumnas() elige la AVX2 si el procesador la soporta;
+// con TP_SIMD=escalar se fuerza la escalar.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define KERNELS_AVX2 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+enum Comparacion { COMPARAR_MENOR, COMPARAR_MAYOR };
+
+// Mínimo y máximo de las filas que coinciden; sin filas, cantidad = 0 y
+// los extremos quedan en +inf/-inf
+struct MinMaxColumna {
+    float minimo;
+    float maximo;
+    size_t cantidad;
+};
+
+struct KernelsColumnas {
+    const char* nombre;
+    // Suma de valores[i] para las filas con codigos[i] == codigo
+    double (*sumaFloatSi)(const float* valores, const uint32_t* codigos, size_t n, uint32_t codigo);
+    long long (*sumaInt32Si)(const int32_t* valores, const uint32_t* codigos, size_t n, uint32_t codigo);
+    // Filas con codigos[i] == codigo
+    size_t (*contarSi)(const uint32_t* codigos, size_t n, uint32_t codigo);
+    MinMaxColumna (*minMaxFloatSi)(const float* valores, const uint32_t* codigos, size_t n, uint32_t codigo);
+    // Marca en 'mascara' (ceil(n / 64) palabras) las filas con valor < umbral
+    // (o > umbral) y devuelve cuántas son
+    size_t (*compararFloat)(const float* valores, size_t n, float umbral, Comparacion comparacion, uint64_t* mascara);
+    size_t (*compararInt32)(const int32_t* valores, size_t n, int32_t umbral, Comparacion comparacion, uint64_t* mascara);
+};
+
+inline size_t palabrasMascara(size_t n) {
+    return (n + 63) / 64;
+}
+
+// --- Escalar ---
+
+inline double sumaFloatSiEscalar(const float* valores, const uint32_t* codigos, size_t n, uint32_t codigo) {
+    double suma = 0.0;
+    for (size_t i = 0; i < n; ++i) suma += codigos[i] == codigo ? valores[i] : 0.0f;
+    return suma;
+}
+
+inline long long sumaInt32SiEscalar(const int32_t* valores, const uint32_t* codigos, size_t n, uint32_t codigo) {
+    long long suma = 0;
+    for (size_t i = 0; i < n; ++i) suma += valores[i] & -static_cast<int32_t>(codigos[i] == codigo);
+    return suma;
+}
+
+inline size_t contarSiEscalar(const uint32_t* codigos, size_t n, uint32_t codigo) {
+    size_t cantidad = 0;
+    for (size_t i = 0; i < n; ++i) cantidad += codigos[i] == codigo;
+    return cantidad;
+}
+
+inline MinMaxColumna minMaxFloatSiEscalar(const float* valores, const uint32_t* codigos, size_t n, uint32_t codigo) {
+    const float infinito = numeric_limits<float>::infinity();
+    MinMaxColumna r{infinito, -infinito, 0};
+    for (size_t i = 0; i < n; ++i) {
+        bool coincide = codigos[i] == codigo;
+        r.minimo = min(r.minimo, coincide ? valores[i] : infinito);
+        r.maximo = max(r.maximo, coincide ? valores[i] : -infinito);
+        r.cantidad += coincide;
+    }
+    return r;
+}
+
+template <class T>
+size_t compararEscalar(const T* valores, size_t n, T umbral, Comparacion comparacion, uint64_t* mascara) {
+    size_t cantidad = 0;
+    memset(mascara, 0, palabrasMascara(n) * sizeof(uint64_t));
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t cumple = comparacion == COMPARAR_MENOR ? valores[i] < umbral : valores[i] > umbral;
+        mascara[i / 64] |= cumple << (i % 64);
+        cantidad += cumple;
+    }
+    return cantidad;
+}
+
+inline size_t compararFloatEscalar(const float* valores, size_t n, float umbral, Comparacion comparacion, uint64_t* mascara) {
+    return compararEscalar(valores, n, umbral, comparacion, mascara);
+}
+
+inline size_t compararInt32Escalar(const int32_t* valores, size_t n, int32_t umbral, Comparacion comparacion, uint64_t* mascara) {
+    return compararEscalar(valores, n, umbral, comparacion, mascara);
+}
+
+inline const KernelsColumnas& kernelsEscalares() {
+    static const KernelsColumnas k = {"escalar", sumaFloatSiEscalar, sumaInt32SiEscalar, contarSiEscalar,
+                                      minMaxFloatSiEscalar, compararFloatEscalar, compararInt32Escalar};
+    return k;
+}
+
+// --- AVX2 ---
+// Se compilan con target("avx2") aunque el resto del programa no lo use;
+// sólo se llaman si el procesador lo soporta. Las últimas n % 8 filas van
+// por la versión escalar.
+
+#ifdef KERNELS_AVX2
+
+__attribute__((target("avx2"))) inline double sumaFloatSiAvx2(const float* valores, const uint32_t* codigos, size_t n,
+                                                               uint32_t codigo) {
+    const __m256i buscado = _mm256_set1_epi32(static_cast<int>(codigo));
+    __m256d bajo = _mm256_setzero_pd(), alto = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codigos + i));
+        __m256 coincide = _mm256_castsi256_ps(_mm256_cmpeq_epi32(c, buscado));
+        __m256 v = _mm256_and_ps(_mm256_loadu_ps(valores + i), coincide);
+        bajo = _mm256_add_pd(bajo, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        alto = _mm256_add_pd(alto, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+    double parciales[4];
+    _mm256_storeu_pd(parciales, _mm256_add_pd(bajo, alto));
+    return parciales[0] + parciales[1] + parciales[2] + parciales[3] +
+           sumaFloatSiEscalar(valores + i, codigos + i, n - i, codigo);
+}
+
+__attribute__((target("avx2"))) inline long long sumaInt32SiAvx2(const int32_t* valores, const uint32_t* codigos, size_t n,
+                                                                  uint32_t codigo) {
+    const __m256i buscado = _mm256_set1_epi32(static_cast<int>(codigo));
+    __m256i suma = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codigos + i));
+        __m256i v = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(valores + i)),
+                                     _mm256_cmpeq_epi32(c, buscado));
+        suma = _mm256_add_epi64(suma, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        suma = _mm256_add_epi64(suma, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    long long parciales[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(parciales), suma);
+    return parciales[0] + parciales[1] + parciales[2] + parciales[3] +
+           sumaInt32SiEscalar(valores + i, codigos + i, n - i, codigo);
+}
+
+__attribute__((target("avx2,popcnt"))) inline size_t contarSiAvx2(const uint32_t* codigos, size_t n, uint32_t codigo) {
+    const __m256i buscado = _mm256_set1_epi32(static_cast<int>(codigo));
+    size_t cantidad = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codigos + i));
+        cantidad += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(c, buscado))));
+    }
+    return cantidad + contarSiEscalar(codigos + i, n - i, codigo);
+}
+
+__attribute__((target("avx2,popcnt"))) inline MinMaxColumna minMaxFloatSiAvx2(const float* valores, const uint32_t* codigos,
+                                                                              size_t n, uint32_t codigo) {
+    const float infinito = numeric_limits<float>::infinity();
+    const __m256i buscado = _mm256_set1_epi32(static_cast<int>(codigo));
+    const __m256 masInfinito = _mm256_set1_ps(infinito), menosInfinito = _mm256_set1_ps(-infinito);
+    __m256 minimo = masInfinito, maximo = menosInfinito;
+    size_t cantidad = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codigos + i));
+        __m256 coincide = _mm256_castsi256_ps(_mm256_cmpeq_epi32(c, buscado));
+        __m256 v = _mm256_loadu_ps(valores + i);
+        minimo = _mm256_min_ps(minimo, _mm256_blendv_ps(masInfinito, v, coincide));
+        maximo = _mm256_max_ps(maximo, _mm256_blendv_ps(menosInfinito, v, coincide));
+        cantidad += __builtin_popcount(_mm256_movemask_ps(coincide));
+    }
+    float minimos[8], maximos[8];
+    _mm256_storeu_ps(minimos, minimo);
+    _mm256_storeu_ps(maximos, maximo);
+    MinMaxColumna r = minMaxFloatSiEscalar(valores + i, codigos + i, n - i, codigo);
+    for (int l = 0; l < 8; ++l) {
+        r.minimo = min(r.minimo, minimos[l]);
+        r.maximo = max(r.maximo, maximos[l]);
+    }
+    r.cantidad += cantidad;
+    return r;
+}
+
+// Las palabras completas (64 filas) se arman con 8 movemask; la última,
+// si está incompleta, la completa la versión escalar
+__attribute__((target("avx2,popcnt"))) inline size_t compararFloatAvx2(const float* valores, size_t n, float umbral,
+                                                                       Comparacion comparacion, uint64_t* mascara) {
+    const __m256 u = _mm256_set1_ps(umbral);
+    size_t completas = n / 64, cantidad = 0;
+    for (size_t w = 0; w < completas; ++w) {
+        uint64_t palabra = 0;
+        for (int b = 0; b < 8; ++b) {
+            __m256 v = _mm256_loadu_ps(valores + w * 64 + b * 8);
+            __m256 cumple = comparacion == COMPARAR_MENOR ? _mm256_cmp_ps(v, u, _CMP_LT_OQ) : _mm256_cmp_ps(v, u, _CMP_GT_OQ);
+            palabra |= static_cast<uint64_t>(_mm256_movemask_ps(cumple)) << (b * 8);
+        }
+        mascara[w] = palabra;
+        cantidad += __builtin_popcountll(palabra);
+    }
+    return cantidad + compararEscalar(valores + completas * 64, n - completas * 64, umbral, comparacion, mascara + completas);
+}
+
+__attribute__((target("avx2,popcnt"))) inline size_t compararInt32Avx2(const int32_t* valores, size_t n, int32_t umbral,
+                                                                       Comparacion comparacion, uint64_t* mascara) {
+    const __m256i u = _mm256_set1_epi32(umbral);
+    size_t completas = n / 64, cantidad = 0;
+    for (size_t w = 0; w < completas; ++w) {
+        uint64_t palabra = 0;
+        for (int b = 0; b < 8; ++b) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(valores + w * 64 + b * 8));
+            __m256i cumple = comparacion == COMPARAR_MENOR ? _mm256_cmpgt_epi32(u, v) : _mm256_cmpgt_epi32(v, u);
+            palabra |= static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(cumple))) << (b * 8);
+        }
+        mascara[w] = palabra;
+        cantidad += __builtin_popcountll(palabra);
+    }
+    return cantidad + compararEscalar(valores + completas * 64, n - completas * 64, umbral, comparacion, mascara + completas);
+}
+
+#endif // KERNELS_AVX2
+
+// Kernels AVX2, o nullptr si no se compilaron o el procesador no los soporta
+inline const KernelsColumnas* kernelsAvx2() {
+#ifdef KERNELS_AVX2
+    static const KernelsColumnas k = {"avx2", sumaFloatSiAvx2, sumaInt32SiAvx2, contarSiAvx2,
+                                      minMaxFloatSiAvx2, compararFloatAvx2, compararInt32Avx2};
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) return &k;
+#endif
+    return nullptr;
+}
+
+// Los kernels con los que corre el programa: se eligen una sola vez
+inline const KernelsColumnas& kernelsColumnas() {
+    static const KernelsColumnas* elegidos = []() {
+        const char* forzar = getenv("TP_SIMD");
+        const KernelsColumnas* avx2 = kernelsAvx2();
+        if (avx2 != nullptr && (forzar == nullptr || strcmp(forzar, "escalar") != 0)) return avx2;
+        return &kernelsEscalares();
+    }();
+    return *elegidos;
+}
+
+#endif // KERNELSCOLUMNAS_H
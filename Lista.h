@@ -1,9 +1,18 @@
 #ifndef U02_LISTAS_LISTA_LISTA_H_
 #define U02_LISTAS_LISTA_LISTA_H_
 
+#include <atomic>
 #include <iostream>
 #include "Nodo.h"
 
+/**
+ * Identidad única para cada lista que se construye (ver Lista::getIdentidad)
+ */
+inline unsigned long long siguienteIdentidadLista() {
+    static std::atomic<unsigned long long> secuencia(0);
+    return secuencia.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 /**
  * Clase que implementa una Lista Enlazada genérica, ya que puede
  * almacenar cualquier tipo de dato T
@@ -13,7 +22,10 @@ template <class T>
 class Lista {
     private:
         Nodo<T> *inicio;
-
+        Nodo<T> *fin;    // último nodo, para insertar al final en O(1)
+        int tamanio;     // cantidad de nodos, mantenida por cada operación
+        unsigned long long identidad; // distinta para cada lista, incluso copias
+        unsigned long long version;   // se incrementa con cada modificación
 
     public:
         Lista();
@@ -44,7 +56,10 @@ class Lista {
 
         void insertAfter2(int oldValue, int n, int newValue);
 
-        Nodo<T> *getInicio();
+        Nodo<T> *getInicio() const;
+        Nodo<T> *getFin() const;
+        unsigned long long getIdentidad() const;
+        unsigned long long getVersion() const;
 };
 
 /**
@@ -54,6 +69,10 @@ class Lista {
 template <class T>
 Lista<T>::Lista() {
     inicio = nullptr;
+    fin = nullptr;
+    tamanio = 0;
+    identidad = siguienteIdentidadLista();
+    version = 0;
 }
 
 /**
@@ -64,11 +83,22 @@ Lista<T>::Lista() {
 template <class T>
 Lista<T>::Lista(const Lista<T> &li) {
     inicio = nullptr;
+    Nodo<T> *ultimo = nullptr; // Se engancha al último copiado para que la copia sea O(n)
     Nodo<T> *aux = li.inicio;
     while(aux != nullptr) {
-        insertarUltimo(aux->getDato());
+        Nodo<T> *nuevo = new Nodo<T>(aux->getDato(), nullptr);
+        if (ultimo == nullptr) {
+            inicio = nuevo;
+        } else {
+            ultimo->setSiguiente(nuevo);
+        }
+        ultimo = nuevo;
         aux = aux->getSiguiente();
     }
+    fin = ultimo;
+    tamanio = li.tamanio;
+    identidad = siguienteIdentidadLista();
+    version = 0;
 }
 
 /**
@@ -98,14 +128,6 @@ bool Lista<T>::esVacia() {
  */
 template <class T>
 int Lista<T>::getTamanio() const { // <--- ¡Añade 'const' aquí también!
-    int tamanio = 0;
-    Nodo<T> *aux = inicio;
-
-    while(aux != nullptr) {
-        tamanio++;
-        aux = aux->getSiguiente();
-    }
-
     return tamanio;
 }
 
@@ -140,6 +162,8 @@ void Lista<T>::insertar(int pos, T dato) {
 
     nuevo->setSiguiente(aux->getSiguiente());
     aux->setSiguiente(nuevo);
+    tamanio++;
+    version++;
 }
 
 /**
@@ -150,7 +174,12 @@ void Lista<T>::insertar(int pos, T dato) {
 template <class T>
 void Lista<T>::insertarPrimero(T dato) {
     Nodo<T> *nuevo = new Nodo<T>(dato, inicio);
+    if (inicio == nullptr) {
+        fin = nuevo;
+    }
     inicio = nuevo;
+    tamanio++;
+    version++;
 }
 
 /**
@@ -164,15 +193,12 @@ void Lista<T>::insertarUltimo(T dato) {
 
     if (esVacia()) {
         inicio = nuevo;
-        return;
+    } else {
+        fin->setSiguiente(nuevo);
     }
-
-    Nodo<T> *aux = inicio;
-    while(aux->getSiguiente() != nullptr) {
-        aux = aux->getSiguiente();
-    }
-
-    aux->setSiguiente(nuevo);
+    fin = nuevo;
+    tamanio++;
+    version++;
 }
 
 /**
@@ -189,7 +215,12 @@ void Lista<T>::remover(int pos) {
     Nodo<T> *aBorrar = inicio;
     if (pos == 0) {
         inicio = inicio->getSiguiente();
+        if (inicio == nullptr) {
+            fin = nullptr;
+        }
         delete aBorrar;
+        tamanio--;
+        version++;
         return;
     }
 
@@ -199,7 +230,12 @@ void Lista<T>::remover(int pos) {
     }
     aBorrar = aux->getSiguiente();
     aux->setSiguiente(aBorrar->getSiguiente());
+    if (aBorrar == fin) {
+        fin = aux;
+    }
     delete aBorrar;
+    tamanio--;
+    version++;
 }
 
 /**
@@ -240,6 +276,7 @@ void Lista<T>::reemplazar(int pos, T dato) {
     }
 
     aux->setDato(dato);
+    version++;
 }
 
 /**
@@ -257,6 +294,9 @@ void Lista<T>::vaciar() {
     }
 
     inicio = nullptr;
+    fin = nullptr;
+    tamanio = 0;
+    version++;
 }
 
 /**
@@ -297,6 +337,11 @@ void Lista<T>::insertAfter2(int oldValue, int n, int newValue) {
             if (contador == n) {
                 Nodo<T> *nuevo = new Nodo<T>(newValue, aux->getSiguiente());
                 aux->setSiguiente(nuevo);
+                if (aux == fin) {
+                    fin = nuevo;
+                }
+                tamanio++;
+                version++;
                 return; // Se insertó el elemento, salir
             }
         }
@@ -308,9 +353,36 @@ void Lista<T>::insertAfter2(int oldValue, int n, int newValue) {
 }
 
 template <class T>
-Nodo<T> *Lista<T>::getInicio() {
+Nodo<T> *Lista<T>::getInicio() const {
     return inicio;
 }
 
+template <class T>
+Nodo<T> *Lista<T>::getFin() const {
+    return fin;
+}
+
+/**
+ * Identidad de la lista: no se repite entre listas, ni siquiera si una se
+ * construye en la dirección de memoria que dejó otra. Junto con getVersion()
+ * permite a quien guarda datos derivados (índices) saber si siguen valiendo.
+ * @tparam T
+ * @return identidad de la lista
+ */
+template <class T>
+unsigned long long Lista<T>::getIdentidad() const {
+    return identidad;
+}
+
+/**
+ * Función que devuelve la cantidad de modificaciones hechas sobre la lista
+ * @tparam T
+ * @return versión actual
+ */
+template <class T>
+unsigned long long Lista<T>::getVersion() const {
+    return version;
+}
+
 
 #endif // U02_LISTAS_LISTA_LISTA_H_
\ No newline at end of file
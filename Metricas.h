@@ -0,0 +1,263 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#include "ContadoresHW.h"
+
+using namespace std;
+
+// --- Conteo de memoria asignada ---
+// Se reemplaza el operator new global para llevar, por hilo, la cantidad de
+// bytes pedidos. Los temporizadores toman la diferencia entre el inicio y el
+// fin de la fase. Como todo el programa es un único .cpp, la definición en el
+// header no genera símbolos duplicados.
+
+thread_local unsigned long long g_bytesAsignados = 0;
+
+// noinline evita que GCC vea el par malloc/free a través del inlining y
+// advierta (erróneamente) que new y delete no coinciden.
+__attribute__((noinline)) void* operator new(size_t n) {
+    g_bytesAsignados += n;
+    void* p = malloc(n == 0 ? 1 : n);
+    if (p == nullptr) throw bad_alloc();
+    return p;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// Tiempo de CPU consumido por el hilo actual, en segundos
+double tiempoCPUHilo() {
+#ifdef __linux__
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+#else
+    return static_cast<double>(clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+// Valores acumulados de una fase a lo largo de todas sus llamadas
+struct MetricaFase {
+    string nombre;
+    string categoria; // carga, analisis, consulta, gestion, indice, detalle (subfases)...
+    long long llamadas = 0;
+    double paredSeg = 0.0;
+    double cpuSeg = 0.0;
+    long long filas = 0;
+    unsigned long long bytes = 0;
+    // Contadores de hardware (sólo de las llamadas en que estuvieron disponibles)
+    long long llamadasHW = 0;
+    long long filasHW = 0;
+    unsigned long long ciclos = 0;
+    unsigned long long instrucciones = 0;
+    unsigned long long fallosCache = 0;
+    unsigned long long fallosSalto = 0;
+};
+
+// Registro global de fases. Conserva el orden en que cada fase se registró
+// por primera vez para que la tabla y el JSON sean estables entre corridas.
+class RegistroMetricas {
+private:
+    mutex mtx;
+    vector<MetricaFase> fases;
+    unordered_map<string, size_t> indice;
+
+public:
+    void registrar(const string& nombre, const string& categoria, double paredSeg,
+                   double cpuSeg, long long filas, unsigned long long bytes,
+                   const LecturaHW& hw = LecturaHW()) {
+        lock_guard<mutex> lock(mtx);
+        auto it = indice.find(nombre);
+        if (it == indice.end()) {
+            it = indice.emplace(nombre, fases.size()).first;
+            MetricaFase m;
+            m.nombre = nombre;
+            m.categoria = categoria;
+            fases.push_back(m);
+        }
+        MetricaFase& m = fases[it->second];
+        m.llamadas++;
+        m.paredSeg += paredSeg;
+        m.cpuSeg += cpuSeg;
+        m.filas += filas;
+        m.bytes += bytes;
+        if (hw.valida) {
+            m.llamadasHW++;
+            m.filasHW += filas;
+            m.ciclos += hw.ciclos;
+            m.instrucciones += hw.instrucciones;
+            m.fallosCache += hw.fallosCache;
+            m.fallosSalto += hw.fallosSalto;
+        }
+    }
+
+    vector<MetricaFase> obtenerFases() {
+        lock_guard<mutex> lock(mtx);
+        return fases;
+    }
+
+    // Suma del tiempo de pared de todas las fases de una categoría
+    double totalCategoria(const string& categoria) {
+        lock_guard<mutex> lock(mtx);
+        double total = 0.0;
+        for (const MetricaFase& m : fases) {
+            if (m.categoria == categoria) total += m.paredSeg;
+        }
+        return total;
+    }
+
+    // IPC y fallos por fila de la fase 'prefijo' y sus subfases
+    // ("eliminarVenta" incluye "eliminarVenta/filtro"). Devuelve "" si no
+    // hubo lecturas de hardware.
+    string resumenHW(const string& prefijo) {
+        lock_guard<mutex> lock(mtx);
+        unsigned long long ciclos = 0, instrucciones = 0, fallosCache = 0, fallosSalto = 0;
+        long long filas = 0, llamadas = 0;
+        for (const MetricaFase& m : fases) {
+            if (m.nombre == prefijo || m.nombre.compare(0, prefijo.size() + 1, prefijo + "/") == 0) {
+                ciclos += m.ciclos;
+                instrucciones += m.instrucciones;
+                fallosCache += m.fallosCache;
+                fallosSalto += m.fallosSalto;
+                filas += m.filasHW;
+                llamadas += m.llamadasHW;
+            }
+        }
+        if (llamadas == 0 || ciclos == 0) return "";
+        double divisor = filas > 0 ? (double)filas : 1.0;
+        ostringstream out;
+        out << fixed << setprecision(2) << " | IPC " << (double)instrucciones / ciclos
+            << ", fallos de cache/fila " << fallosCache / divisor
+            << ", fallos de salto/fila " << fallosSalto / divisor;
+        return out.str();
+    }
+
+    void imprimirTabla(ostream& out) {
+        vector<MetricaFase> copia = obtenerFases();
+        out << "\n--- Metricas por fase ---\n";
+        out << left << setw(46) << "Fase" << right << setw(9) << "Llamadas" << setw(13) << "Pared (ms)"
+            << setw(13) << "CPU (ms)" << setw(12) << "Filas" << setw(14) << "Bytes asig." << "\n";
+        for (const MetricaFase& m : copia) {
+            out << left << setw(46) << m.nombre << right << setw(9) << m.llamadas
+                << fixed << setprecision(3) << setw(13) << m.paredSeg * 1000.0 << setw(13) << m.cpuSeg * 1000.0
+                << setw(12) << m.filas << setw(14) << m.bytes << "\n";
+        }
+        out << left;
+    }
+
+    bool escribirJSON(const string& nombreArchivo) {
+        vector<MetricaFase> copia = obtenerFases();
+        ofstream archivo(nombreArchivo);
+        if (!archivo.is_open()) {
+            return false;
+        }
+        archivo << "{\n  \"fases\": [\n";
+        for (size_t i = 0; i < copia.size(); ++i) {
+            const MetricaFase& m = copia[i];
+            archivo << "    {\"nombre\": \"" << m.nombre << "\", \"categoria\": \"" << m.categoria
+                    << "\", \"llamadas\": " << m.llamadas << fixed << setprecision(9)
+                    << ", \"pared_seg\": " << m.paredSeg << ", \"cpu_seg\": " << m.cpuSeg
+                    << ", \"filas\": " << m.filas << ", \"bytes_asignados\": " << m.bytes;
+            if (m.llamadasHW > 0) {
+                archivo << ", \"llamadas_hw\": " << m.llamadasHW << ", \"ciclos\": " << m.ciclos
+                        << ", \"instrucciones\": " << m.instrucciones << ", \"fallos_cache\": " << m.fallosCache
+                        << ", \"fallos_salto\": " << m.fallosSalto;
+            }
+            archivo << "}" << (i + 1 < copia.size() ? ",\n" : "\n");
+        }
+        archivo << "  ]\n}\n";
+        return true;
+    }
+} g_metricas;
+
+// Temporizador RAII: mide tiempo de pared (steady_clock), tiempo de CPU del
+// hilo y bytes asignados desde su construcción hasta su destrucción, y lo
+// registra en g_metricas. Si se pidieron contadores de hardware
+// (TP_CONTADORES_HW=1) y están disponibles, también toma su diferencia.
+class TemporizadorFase {
+private:
+    const char* nombre;
+    const char* categoria;
+    long long filas;
+    chrono::steady_clock::time_point inicioPared;
+    double inicioCPU;
+    unsigned long long inicioBytes;
+    ContadoresHW* contadores;
+    LecturaHW inicioHW;
+
+public:
+    TemporizadorFase(const char* n, const char* c, long long f = 0)
+        : nombre(n), categoria(c), filas(f), contadores(contadoresDelHilo()) {
+        if (contadores != nullptr) inicioHW = contadores->leer();
+        inicioPared = chrono::steady_clock::now();
+        inicioCPU = tiempoCPUHilo();
+        inicioBytes = g_bytesAsignados;
+    }
+
+    void setFilas(long long f) {
+        filas = f;
+    }
+
+    ~TemporizadorFase() {
+        LecturaHW hw;
+        if (contadores != nullptr && inicioHW.valida) hw = diferenciaHW(inicioHW, contadores->leer());
+        double pared = chrono::duration<double>(chrono::steady_clock::now() - inicioPared).count();
+        double cpu = tiempoCPUHilo() - inicioCPU;
+        g_metricas.registrar(nombre, categoria, pared, cpu, filas, g_bytesAsignados - inicioBytes, hw);
+    }
+};
+
+// Acumulador para fases que se intercalan dentro de un mismo bucle (por
+// ejemplo parseo e inserción de cada lote del CSV). Se registra una sola
+// vez al llamar a registrar().
+class AcumuladorFase {
+private:
+    const char* nombre;
+    const char* categoria;
+    double paredSeg = 0.0;
+    double cpuSeg = 0.0;
+    unsigned long long bytes = 0;
+    chrono::steady_clock::time_point inicioPared;
+    double inicioCPU = 0.0;
+    unsigned long long inicioBytes = 0;
+
+public:
+    AcumuladorFase(const char* n, const char* c) : nombre(n), categoria(c) {}
+
+    void iniciar() {
+        inicioPared = chrono::steady_clock::now();
+        inicioCPU = tiempoCPUHilo();
+        inicioBytes = g_bytesAsignados;
+    }
+
+    void detener() {
+        paredSeg += chrono::duration<double>(chrono::steady_clock::now() - inicioPared).count();
+        cpuSeg += tiempoCPUHilo() - inicioCPU;
+        bytes += g_bytesAsignados - inicioBytes;
+    }
+
+    void registrar(long long filas) {
+        g_metricas.registrar(nombre, categoria, paredSeg, cpuSeg, filas, bytes);
+    }
+};
+
+#endif // METRICAS_H
@@ -0,0 +1,402 @@
+#ifndef MODOBATCH_H
+#define MODOBATCH_H
+
+// Modo batch: ejecuta análisis, consultas y operaciones de gestión sin menús,
+// a partir de un script (una orden por línea) o de una orden pasada por línea
+// de comandos. El dataset se carga una sola vez y se mide la latencia de cada
+// orden ejecutada.
+//
+// Órdenes aceptadas (los argumentos con espacios van entre comillas dobles,
+// y '#' inicia un comentario hasta el fin de la línea):
+//
+//   analyze all|top5|producto-pais|categoria-pais|envio-pais|envio-categoria|dia|producto|percentiles
+//   analyze top5-aprox|producto-aprox|clientes-aprox   (con resúmenes de memoria
+//                         acotada, ver AnalisisAproximado.h; no entran en "all")
+//   query city <ciudad>
+//   query range <DD/MM/AAAA> <DD/MM/AAAA> <pais>
+//   query compare-countries <pais1> <pais2>
+//   query compare-products <producto1> <producto2>
+//   query below <pais> <umbral>
+//   query above <umbral>
+//   query totals|weekly|monthly <D/M/AAAA> <D/M/AAAA> [<pais>]
+//   add <id> <fecha> <pais> <ciudad> <cliente> <producto> <categoria> <cantidad> <precio> <medio> <estado>
+//   delete <id>
+//   modify <id> <campo>=<valor> [<campo>=<valor> ...]
+//   checkpoint            (con --wal: consolida el log en una nueva base)
+//
+// Con --formato json|csv, analyze y query responden en ese formato (ver
+// Resultados.h); las órdenes de gestión siguen respondiendo en texto.
+//
+// Con --approx la lista es una muestra (Muestreo.h) y sólo se aceptan los
+// analyze de Analisis.h, que informan estimaciones con su margen. Con
+// --memoria la lista queda vacía: sólo se aceptan esos mismos analyze, que
+// leen el CSV con un presupuesto de memoria (AgregacionExterna.h).
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Analisis.h"
+#include "AnalisisAproximado.h"
+#include "Gestion.h"
+#include "Consultas.h"
+#include "SalidaReporte.h"
+
+using namespace std;
+
+// Divide una línea en palabras. Respeta comillas dobles y descarta lo que
+// sigue a un '#' fuera de comillas.
+vector<string> tokenizarOrden(const string& linea) {
+    vector<string> tokens;
+    string actual;
+    bool enComillas = false;
+    bool hayToken = false;
+    for (char c : linea) {
+        if (enComillas) {
+            if (c == '"') enComillas = false;
+            else actual += c;
+        } else if (c == '"') {
+            enComillas = true;
+            hayToken = true;
+        } else if (c == '#') {
+            break;
+        } else if (isspace(static_cast<unsigned char>(c))) {
+            if (hayToken) {
+                tokens.push_back(actual);
+                actual.clear();
+                hayToken = false;
+            }
+        } else {
+            actual += c;
+            hayToken = true;
+        }
+    }
+    if (hayToken) tokens.push_back(actual);
+    return tokens;
+}
+
+// Une los tokens desde 'desde' con un espacio, para permitir nombres de
+// ciudad sin comillas ("query city Buenos Aires").
+string unirTokens(const vector<string>& tokens, size_t desde) {
+    string resultado;
+    for (size_t i = desde; i < tokens.size(); ++i) {
+        if (i > desde) resultado += ' ';
+        resultado += tokens[i];
+    }
+    return resultado;
+}
+
+bool leerUmbralOrden(const string& texto, float& umbral, string& error) {
+    try {
+        size_t usados;
+        umbral = stof(texto, &usados);
+        if (usados != texto.size()) throw invalid_argument(texto);
+    } catch (const exception& e) {
+        error = "umbral invalido: '" + texto + "'";
+        return false;
+    }
+    return true;
+}
+
+// Ejecuta una orden de lectura (analyze/query). Devuelve false y completa
+// 'error' si la orden o sus argumentos no son válidos. 'clave' identifica la
+// orden en los resúmenes de latencia ("query city", "add", ...). Con
+// 'escritor', el resultado sale en ese formato en lugar del texto; los
+// parámetros que el texto rechaza con un mensaje pasan a ser errores.
+bool ejecutarLectura(const Lista<Venta>& listaVentas, const vector<string>& t, ostream& salida,
+                     string& clave, string& error, EscritorResultado* escritor = nullptr) {
+    const string& verbo = t[0];
+    clave = verbo;
+
+    if (verbo == "analyze") {
+        if (t.size() != 2) { error = "uso: analyze <all|top5|producto-pais|categoria-pais|envio-pais|envio-categoria|dia|producto|percentiles|top5-aprox|producto-aprox|clientes-aprox>"; return false; }
+        clave = verbo + " " + t[1];
+        if (t[1] == "all") {
+            if (escritor != nullptr) realizarTodosLosAnalisis(listaVentas, *escritor);
+            else realizarTodosLosAnalisis(listaVentas, salida);
+            return true;
+        }
+        for (const AnalisisDisponible& analisis : ANALISIS_DISPONIBLES) {
+            if (t[1] != analisis.nombre) continue;
+            if (escritor != nullptr) analisis.estructurado(listaVentas, *escritor);
+            else analisis.texto(listaVentas, salida);
+            return true;
+        }
+        for (const AnalisisDisponible& analisis : ANALISIS_APROXIMADOS) {
+            if (t[1] != analisis.nombre) continue;
+            if (g_muestraVentas != nullptr) { error = "'" + t[1] + "' necesita todas las ventas (sin --approx)"; return false; }
+            if (g_fuenteEnDisco != nullptr) { error = "'" + t[1] + "' necesita las ventas cargadas (sin --memoria)"; return false; }
+            if (escritor != nullptr) analisis.estructurado(listaVentas, *escritor);
+            else analisis.texto(listaVentas, salida);
+            return true;
+        }
+        error = "analisis desconocido: '" + t[1] + "'";
+        return false;
+    }
+
+    if (verbo == "query") {
+        if (t.size() < 2) { error = "falta el tipo de consulta"; return false; }
+        const string& tipo = t[1];
+        clave = verbo + " " + tipo;
+        if (tipo == "city") {
+            if (t.size() < 3) { error = "uso: query city <ciudad>"; return false; }
+            if (escritor != nullptr) listarVentasPorCiudad(listaVentas, unirTokens(t, 2), *escritor);
+            else listarVentasPorCiudad(listaVentas, unirTokens(t, 2), salida);
+        } else if (tipo == "range") {
+            if (t.size() != 5) { error = "uso: query range <DD/MM/AAAA> <DD/MM/AAAA> <pais>"; return false; }
+            if (escritor != nullptr) return listarVentasPorRangoFechasPorPais(listaVentas, t[2], t[3], t[4], *escritor, error);
+            listarVentasPorRangoFechasPorPais(listaVentas, t[2], t[3], t[4], salida);
+        } else if (tipo == "compare-countries") {
+            if (t.size() != 4) { error = "uso: query compare-countries <pais1> <pais2>"; return false; }
+            if (escritor != nullptr) return compararDosPaises(listaVentas, t[2], t[3], *escritor, error);
+            compararDosPaises(listaVentas, t[2], t[3], salida);
+        } else if (tipo == "compare-products") {
+            if (t.size() != 4) { error = "uso: query compare-products <producto1> <producto2>"; return false; }
+            if (escritor != nullptr) return compararDosProductosPorPais(listaVentas, t[2], t[3], *escritor, error);
+            compararDosProductosPorPais(listaVentas, t[2], t[3], salida);
+        } else if (tipo == "below") {
+            float umbral;
+            if (t.size() != 4) { error = "uso: query below <pais> <umbral>"; return false; }
+            if (!leerUmbralOrden(t[3], umbral, error)) return false;
+            if (escritor != nullptr) buscarProductosPorDebajoUmbralPorPais(listaVentas, t[2], umbral, *escritor);
+            else buscarProductosPorDebajoUmbralPorPais(listaVentas, t[2], umbral, salida);
+        } else if (tipo == "above") {
+            float umbral;
+            if (t.size() != 3) { error = "uso: query above <umbral>"; return false; }
+            if (!leerUmbralOrden(t[2], umbral, error)) return false;
+            if (escritor != nullptr) buscarProductosPorEncimaUmbral(listaVentas, umbral, *escritor);
+            else buscarProductosPorEncimaUmbral(listaVentas, umbral, salida);
+        } else if (tipo == "totals" || tipo == "weekly" || tipo == "monthly") {
+            if (t.size() != 4 && t.size() != 5) { error = "uso: query " + tipo + " <D/M/AAAA> <D/M/AAAA> [<pais>]"; return false; }
+            AgrupacionFechas agrupacion = tipo == "weekly" ? AGRUPAR_SEMANA : tipo == "monthly" ? AGRUPAR_MES : AGRUPAR_TOTAL;
+            string pais = t.size() == 5 ? t[4] : "";
+            if (escritor != nullptr) return totalesPorFechas(listaVentas, t[2], t[3], pais, agrupacion, *escritor, error);
+            totalesPorFechas(listaVentas, t[2], t[3], pais, agrupacion, salida);
+        } else {
+            error = "consulta desconocida: '" + tipo + "'";
+            return false;
+        }
+        return true;
+    }
+
+    error = "orden desconocida: '" + verbo + "'";
+    return false;
+}
+
+// Igual que la anterior, eligiendo el escritor según el formato pedido
+bool ejecutarLectura(const Lista<Venta>& listaVentas, const vector<string>& t, ostream& salida,
+                     string& clave, string& error, FormatoResultado formato) {
+    if (formato == FORMATO_JSON) {
+        EscritorJSON escritor(salida);
+        return ejecutarLectura(listaVentas, t, salida, clave, error, &escritor);
+    }
+    if (formato == FORMATO_CSV) {
+        EscritorCSV escritor(salida);
+        return ejecutarLectura(listaVentas, t, salida, clave, error, &escritor);
+    }
+    return ejecutarLectura(listaVentas, t, salida, clave, error);
+}
+
+// Ejecuta una orden de gestión (add/delete/modify/checkpoint). 'cambio' indica si la
+// lista quedó modificada (por ejemplo, es false si el ID no existe).
+bool ejecutarEscritura(Lista<Venta>& listaVentas, const vector<string>& t, ostream& salida,
+                       string& clave, string& error, bool& cambio) {
+    const string& verbo = t[0];
+    clave = verbo;
+    cambio = false;
+
+    if (verbo == "add") {
+        if (t.size() != 12) { error = "uso: add <id> <fecha> <pais> <ciudad> <cliente> <producto> <categoria> <cantidad> <precio> <medio> <estado>"; return false; }
+        Venta nuevaVenta(t[1], t[2], t[3], t[4], t[5], t[6], t[7], 0, 0.0f, 0.0f, t[10], t[11]);
+        if (!aplicarCambioVenta(nuevaVenta, "cantidad", t[8], salida) ||
+            !aplicarCambioVenta(nuevaVenta, "precio", t[9], salida)) {
+            error = "cantidad o precio invalidos";
+            return false;
+        }
+        nuevaVenta.montoTotal = nuevaVenta.cantidad * nuevaVenta.precioUnitario;
+        agregarVenta(listaVentas, nuevaVenta);
+        cambio = true;
+        salida << "Venta con ID " << nuevaVenta.idVenta << " agregada exitosamente." << endl;
+        return true;
+    }
+
+    if (verbo == "delete") {
+        if (t.size() != 2) { error = "uso: delete <id>"; return false; }
+        cambio = eliminarVentaPorId(listaVentas, t[1], salida);
+        return true;
+    }
+
+    if (verbo == "modify") {
+        if (t.size() < 3) { error = "uso: modify <id> <campo>=<valor> [...]"; return false; }
+        vector<pair<string, string>> cambios;
+        for (size_t i = 2; i < t.size(); ++i) {
+            size_t igual = t[i].find('=');
+            if (igual == string::npos) { error = "cambio sin '=': '" + t[i] + "'"; return false; }
+            cambios.push_back({t[i].substr(0, igual), t[i].substr(igual + 1)});
+        }
+        cambio = modificarVentaPorId(listaVentas, t[1], cambios, salida);
+        return true;
+    }
+
+    if (verbo == "checkpoint") {
+        if (t.size() != 1) { error = "uso: checkpoint"; return false; }
+        if (g_observadorGestion == nullptr) { error = "no hay un WAL configurado (use --wal)"; return false; }
+        if (!g_observadorGestion->checkpoint(listaVentas, error)) return false;
+        salida << "Checkpoint completo: " << listaVentas.getTamanio() << " ventas en la nueva base." << endl;
+        return true;
+    }
+
+    error = "orden desconocida: '" + verbo + "'";
+    return false;
+}
+
+// Las órdenes de gestión modifican la lista; el resto sólo la leen.
+// checkpoint no la modifica pero se serializa con las escrituras.
+bool esOrdenDeEscritura(const vector<string>& t) {
+    return !t.empty() && (t[0] == "add" || t[0] == "delete" || t[0] == "modify" || t[0] == "checkpoint");
+}
+
+// Ejecuta cualquier orden directamente sobre la lista (modo batch). Las
+// órdenes de gestión responden siempre en texto.
+bool ejecutarOrden(Lista<Venta>& listaVentas, const vector<string>& t, ostream& salida,
+                   string& clave, string& error, FormatoResultado formato = FORMATO_TEXTO) {
+    if (g_muestraVentas != nullptr && t[0] != "analyze") {
+        // Las consultas listarían sólo la muestra y los cambios la romperían
+        clave = t[0];
+        error = "con --approx solo se aceptan ordenes analyze";
+        return false;
+    }
+    if (g_fuenteEnDisco != nullptr && t[0] != "analyze") {
+        // Las ventas no están cargadas: no hay qué consultar ni modificar
+        clave = t[0];
+        error = "con --memoria solo se aceptan ordenes analyze";
+        return false;
+    }
+    if (esOrdenDeEscritura(t)) {
+        bool cambio;
+        return ejecutarEscritura(listaVentas, t, salida, clave, error, cambio);
+    }
+    return ejecutarLectura(listaVentas, t, salida, clave, error, formato);
+}
+
+// Latencias de todas las ejecuciones de una misma orden ("query city", "add", ...)
+struct LatenciasOrden {
+    string orden;
+    vector<double> milisegundos;
+};
+
+class EjecutorBatch {
+private:
+    Lista<Venta>& listaVentas;
+    ostream& salida;
+    SumideroReporte* sumidero; // destino de cada reporte; nullptr: el streambuf de 'salida'
+    FormatoResultado formato = FORMATO_TEXTO;
+    vector<LatenciasOrden> latencias;
+    unordered_map<string, size_t> indiceLatencias;
+    ofstream detalle; // una fila por orden ejecutada (opcional)
+    long long ejecutadas = 0;
+    long long errores = 0;
+
+    void registrarLatencia(const string& clave, double ms, long long numeroLinea) {
+        auto it = indiceLatencias.find(clave);
+        if (it == indiceLatencias.end()) {
+            it = indiceLatencias.emplace(clave, latencias.size()).first;
+            latencias.push_back({clave, {}});
+        }
+        latencias[it->second].milisegundos.push_back(ms);
+        if (detalle.is_open()) {
+            detalle << numeroLinea << ',' << clave << ',' << fixed << setprecision(6) << ms << '\n';
+        }
+    }
+
+public:
+    EjecutorBatch(Lista<Venta>& lista, ostream& s, SumideroReporte* sum = nullptr)
+        : listaVentas(lista), salida(s), sumidero(sum) {}
+
+    void setFormato(FormatoResultado f) {
+        formato = f;
+    }
+
+    // Guarda la latencia de cada orden en un CSV (linea,orden,ms)
+    bool abrirDetalleLatencias(const string& nombreArchivo) {
+        detalle.open(nombreArchivo);
+        if (!detalle.is_open()) return false;
+        detalle << "linea,orden,ms\n";
+        return true;
+    }
+
+    // Ejecuta una orden. Los errores se informan por stderr con el número de
+    // línea y no detienen el script.
+    bool ejecutar(const vector<string>& tokens, long long numeroLinea) {
+        if (tokens.empty()) return true;
+        string clave, error;
+        bool ok;
+        auto inicio = chrono::steady_clock::now();
+        {
+            // La latencia incluye volcar el reporte de la orden
+            ReporteBuffereado reporte(salida, sumidero);
+            try {
+                ok = ejecutarOrden(listaVentas, tokens, salida, clave, error, formato);
+            } catch (const exception& e) {
+                ok = false;
+                error = e.what();
+            } catch (int codigo) {
+                ok = false;
+                error = "codigo " + to_string(codigo);
+            }
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+        if (!ok) {
+            errores++;
+            cerr << "Error (linea " << numeroLinea << "): " << error << endl;
+            return false;
+        }
+        ejecutadas++;
+        registrarLatencia(clave, ms, numeroLinea);
+        return true;
+    }
+
+    // Ejecuta todas las órdenes de un script. Devuelve la cantidad de errores.
+    long long ejecutarScript(istream& entrada) {
+        string linea;
+        long long numeroLinea = 0;
+        while (getline(entrada, linea)) {
+            numeroLinea++;
+            if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+            ejecutar(tokenizarOrden(linea), numeroLinea);
+        }
+        return errores;
+    }
+
+    long long getErrores() const {
+        return errores;
+    }
+
+    // Resumen de latencias por orden: cantidad, p50, p95, p99, máximo y total
+    void imprimirLatencias(ostream& out) {
+        out << "\n--- Latencia por orden (" << ejecutadas << " ejecutadas, " << errores << " con error) ---\n";
+        out << left << setw(28) << "Orden" << right << setw(9) << "Cantidad" << setw(12) << "p50 (ms)"
+            << setw(12) << "p95 (ms)" << setw(12) << "p99 (ms)" << setw(12) << "max (ms)" << setw(13) << "total (ms)" << "\n";
+        for (LatenciasOrden& l : latencias) {
+            vector<double>& v = l.milisegundos;
+            sort(v.begin(), v.end());
+            auto percentil = [&v](double p) {
+                size_t i = static_cast<size_t>(p * (v.size() - 1) + 0.5);
+                return v[i];
+            };
+            double total = 0.0;
+            for (double x : v) total += x;
+            out << left << setw(28) << l.orden << right << setw(9) << v.size() << fixed << setprecision(3)
+                << setw(12) << percentil(0.50) << setw(12) << percentil(0.95) << setw(12) << percentil(0.99)
+                << setw(12) << v.back() << setw(13) << total << "\n";
+        }
+        out << left;
+    }
+};
+
+#endif // MODOBATCH_H
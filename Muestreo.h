@@ -0,0 +1,308 @@
+#ifndef MUESTREO_H
+#define MUESTREO_H
+
+// Modo aproximado por muestreo (--approx). En lugar de cargar todas las
+// ventas, mientras se lee el CSV se guarda una muestra aleatoria simple de
+// tamaño fijo en un reservorio (algoritmo R de Vitter): uniforme sobre todo
+// el archivo o estratificada por país, con un reservorio por país. Sólo se
+// parsean las líneas que quedan en la muestra.
+//
+// Los análisis de Analisis.h corren sobre la muestra con el mismo código de
+// agrupamiento: en lugar de Suma y Conteo (GroupBy.h) usan SumaEstimada y
+// ConteoEstimado, que escalan cada venta por N_h / n_h (ventas leídas y
+// guardadas de su estrato h) y dan el margen del intervalo de confianza del
+// 95% del total (estimador de Horvitz-Thompson, muestreo sin reposición):
+//
+//   total     = sum_h N_h / n_h * s_h
+//   varianza  = sum_h N_h^2 * (1 - n_h / N_h) * S2_h / n_h
+//   margen    = 1,96 * sqrt(varianza)
+//
+// con s_h la suma del valor sobre las ventas del grupo en la muestra del
+// estrato y S2_h la varianza muestral del valor en el estrato (las ventas de
+// otros grupos cuentan como cero). Un estrato guardado entero no aporta
+// error: con una muestra más grande que el archivo el margen es cero, pero
+// los totales pueden diferir en centavos de los del modo exacto, porque acá
+// se suman en double y en el modo exacto en float.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Venta.h"
+#include "Lista.h"
+#include "GroupBy.h"
+#include "CargaCSV.h"   // parsearLineaVenta
+#include "Metricas.h"
+
+using namespace std;
+
+#define TAMANIO_MUESTRA 10000                 // Ventas por estrato por defecto (1% de 1M de filas)
+#define Z_CONFIANZA 1.96                      // Intervalos del 95%
+#define SEMILLA_MUESTRA 0x2545f4914f6cdd1dULL // Misma muestra en cada corrida
+
+enum EstratificacionMuestra {
+    MUESTRA_UNIFORME,
+    MUESTRA_POR_PAIS
+};
+
+bool leerEstratificacionMuestra(const string& texto, EstratificacionMuestra& estratificacion) {
+    if (texto == "uniforme") estratificacion = MUESTRA_UNIFORME;
+    else if (texto == "pais") estratificacion = MUESTRA_POR_PAIS;
+    else return false;
+    return true;
+}
+
+const char* nombreEstratificacion(EstratificacionMuestra estratificacion) {
+    return estratificacion == MUESTRA_POR_PAIS ? "por pais" : "uniforme";
+}
+
+// Total estimado y la mitad del ancho de su intervalo de confianza
+struct Estimacion {
+    double valor = 0.0;
+    double margen = 0.0;
+};
+
+class MuestraVentas {
+private:
+    struct Estrato {
+        long long poblacion = 0;                    // ventas leídas (N_h)
+        long long muestra = 0;                      // ventas guardadas (n_h)
+        vector<pair<long long, string>> reservorio; // (línea del archivo, texto), hasta 'capacidad'
+    };
+
+    EstratificacionMuestra estratificacion;
+    size_t capacidad; // por estrato
+    mt19937_64 azar;
+    vector<Estrato> estratos;
+    unordered_map<string, uint32_t> estratoPorPais;
+    long long lineas = 0;
+    long long guardadas = 0;
+    Lista<Venta> ventas; // la muestra, en el orden del archivo
+
+    // Tercer campo de la línea, sin parsear el resto
+    static string paisDeLinea(const string& linea) {
+        size_t inicio = linea.find(',');
+        if (inicio != string::npos) inicio = linea.find(',', inicio + 1);
+        if (inicio == string::npos) return "";
+        size_t fin = linea.find(',', inicio + 1);
+        return linea.substr(inicio + 1, fin == string::npos ? string::npos : fin - inicio - 1);
+    }
+
+    uint32_t estratoDeLinea(const string& linea) {
+        if (estratificacion == MUESTRA_UNIFORME) return 0;
+        auto it = estratoPorPais.find(paisDeLinea(linea));
+        if (it != estratoPorPais.end()) return it->second;
+        estratos.emplace_back();
+        return estratoPorPais.emplace(paisDeLinea(linea), static_cast<uint32_t>(estratos.size() - 1)).first->second;
+    }
+
+public:
+    MuestraVentas(EstratificacionMuestra e, size_t capacidadPorEstrato, uint64_t semilla = SEMILLA_MUESTRA)
+        : estratificacion(e), capacidad(max<size_t>(1, capacidadPorEstrato)), azar(semilla) {
+        if (estratificacion == MUESTRA_UNIFORME) estratos.emplace_back();
+    }
+
+    // Ofrece una línea de datos del CSV: la k-ésima línea de su estrato
+    // reemplaza a una de la muestra con probabilidad capacidad / k
+    void ofrecer(const string& linea) {
+        Estrato& estrato = estratos[estratoDeLinea(linea)];
+        long long fila = lineas++;
+        estrato.poblacion++;
+        if (estrato.reservorio.size() < capacidad) {
+            estrato.reservorio.push_back({fila, linea});
+            return;
+        }
+        // El sesgo del módulo sobre 2^64 es despreciable
+        uint64_t posicion = azar() % static_cast<uint64_t>(estrato.poblacion);
+        if (posicion < capacidad) {
+            estrato.reservorio[posicion].first = fila;
+            estrato.reservorio[posicion].second = linea;
+        }
+    }
+
+    // Parsea las líneas guardadas y arma la lista en el orden del archivo
+    void terminar() {
+        vector<pair<long long, const string*>> orden;
+        for (const Estrato& estrato : estratos) {
+            for (const auto& guardada : estrato.reservorio) orden.push_back({guardada.first, &guardada.second});
+        }
+        sort(orden.begin(), orden.end());
+        for (const auto& o : orden) ventas.insertarUltimo(parsearLineaVenta(*o.second));
+        guardadas = static_cast<long long>(orden.size());
+        for (Estrato& estrato : estratos) {
+            estrato.muestra = static_cast<long long>(estrato.reservorio.size());
+            vector<pair<long long, string>>().swap(estrato.reservorio);
+        }
+    }
+
+    uint32_t estrato(const Venta& v) const {
+        return estratificacion == MUESTRA_UNIFORME ? 0 : estratoPorPais.at(v.pais);
+    }
+
+    long long getPoblacion(uint32_t estrato) const {
+        return estratos[estrato].poblacion;
+    }
+
+    long long getTamanio(uint32_t estrato) const {
+        return estratos[estrato].muestra;
+    }
+
+    // Ventas que representa cada una de la muestra en el estrato
+    double peso(uint32_t estrato) const {
+        return static_cast<double>(getPoblacion(estrato)) / getTamanio(estrato);
+    }
+
+    long long getPoblacion() const {
+        return lineas;
+    }
+
+    long long getTamanio() const {
+        return guardadas;
+    }
+
+    size_t getCantidadEstratos() const {
+        return estratos.size();
+    }
+
+    EstratificacionMuestra getEstratificacion() const {
+        return estratificacion;
+    }
+
+    Lista<Venta>& getVentas() {
+        return ventas;
+    }
+};
+
+// Lee el CSV guardando sólo la muestra. Devuelve false si el archivo no se
+// pudo abrir.
+bool cargarMuestraCSV(const string& nombreArchivo, MuestraVentas& muestra) {
+    TemporizadorFase temporizador("carga/muestra", "carga");
+    ifstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    string linea;
+    getline(archivo, linea); // Saltear encabezado
+    while (getline(archivo, linea)) {
+        if (linea.empty() || linea == "\r") continue;
+        muestra.ofrecer(linea);
+    }
+    muestra.terminar();
+    temporizador.setFilas(muestra.getPoblacion());
+    return true;
+}
+
+// Muestra sobre la que corren los análisis con --approx (nullptr: exactos)
+const MuestraVentas* g_muestraVentas = nullptr;
+
+// Sumas por estrato de un valor sobre las ventas de un grupo de la muestra
+class EstimadorTotal {
+private:
+    struct SumasEstrato {
+        uint32_t estrato;
+        double suma;
+        double cuadrados;
+    };
+    vector<SumasEstrato> sumas; // pocos estratos por grupo: búsqueda lineal
+
+public:
+    void agregar(uint32_t estrato, double x) {
+        for (SumasEstrato& s : sumas) {
+            if (s.estrato == estrato) {
+                s.suma += x;
+                s.cuadrados += x * x;
+                return;
+            }
+        }
+        sumas.push_back({estrato, x, x * x});
+    }
+
+    Estimacion estimar(const MuestraVentas& muestra) const {
+        Estimacion e;
+        double varianza = 0.0;
+        for (const SumasEstrato& s : sumas) {
+            double N = static_cast<double>(muestra.getPoblacion(s.estrato));
+            double n = static_cast<double>(muestra.getTamanio(s.estrato));
+            e.valor += N / n * s.suma;
+            if (n > 1 && n < N) {
+                double varianzaMuestral = max(0.0, (s.cuadrados - s.suma * s.suma / n) / (n - 1));
+                varianza += N * N * (1.0 - n / N) * varianzaMuestral / n;
+            }
+        }
+        e.margen = Z_CONFIANZA * sqrt(varianza);
+        return e;
+    }
+};
+
+template <class T>
+T redondearEstimacion(double x) {
+    return is_integral<T>::value ? static_cast<T>(llround(x)) : static_cast<T>(x);
+}
+
+// Margen de un cociente de dos totales estimados (por ejemplo, monto por
+// unidad). Suma los errores relativos en cuadratura sin la covarianza, que
+// entre monto y cantidad es positiva: el intervalo queda más ancho que el real.
+double margenCociente(double numerador, double margenNumerador, double denominador, double margenDenominador) {
+    if (numerador == 0.0 || denominador == 0.0) return 0.0;
+    double relativoNumerador = margenNumerador / numerador;
+    double relativoDenominador = margenDenominador / denominador;
+    return fabs(numerador / denominador) * sqrt(relativoNumerador * relativoNumerador + relativoDenominador * relativoDenominador);
+}
+
+// --- Agregados estimados ---
+// Mismo uso que Suma y Conteo, sobre las ventas de g_muestraVentas.
+
+template <class Columna>
+struct SumaEstimada {
+    EstimadorTotal estimador;
+    void agregar(const Venta& v) { estimador.agregar(g_muestraVentas->estrato(v), Columna::de(v)); }
+    typename Columna::Tipo valor() const {
+        return redondearEstimacion<typename Columna::Tipo>(estimador.estimar(*g_muestraVentas).valor);
+    }
+    double margen() const { return estimador.estimar(*g_muestraVentas).margen; }
+};
+
+struct ConteoEstimado {
+    EstimadorTotal estimador;
+    void agregar(const Venta& v) { estimador.agregar(g_muestraVentas->estrato(v), 1.0); }
+    int valor() const { return redondearEstimacion<int>(estimador.estimar(*g_muestraVentas).valor); }
+    double margen() const { return estimador.estimar(*g_muestraVentas).margen; }
+};
+
+// Datos de la muestra que acompañan a un resultado estimado
+struct ResumenMuestra {
+    bool estimado = false;   // false: resultado exacto
+    long long ventas = 0;    // tamaño de la muestra
+    long long poblacion = 0; // ventas leídas
+    string estratificacion;
+};
+
+// Agregados con que se calculan los análisis de Analisis.h: los exactos de
+// GroupBy.h o los estimados sobre g_muestraVentas
+struct AgregacionExacta {
+    template <class Columna> using Suma = ::Suma<Columna>;
+    typedef ::Conteo Conteo;
+    static ResumenMuestra resumen() { return ResumenMuestra(); }
+};
+
+struct AgregacionMuestral {
+    template <class Columna> using Suma = SumaEstimada<Columna>;
+    typedef ConteoEstimado Conteo;
+    static ResumenMuestra resumen() {
+        ResumenMuestra r;
+        r.estimado = true;
+        r.ventas = g_muestraVentas->getTamanio();
+        r.poblacion = g_muestraVentas->getPoblacion();
+        r.estratificacion = nombreEstratificacion(g_muestraVentas->getEstratificacion());
+        return r;
+    }
+};
+
+#endif // MUESTREO_H
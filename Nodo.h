@@ -14,6 +14,11 @@ class Nodo {
             return dato;
         }
 
+        // Acceso sin copia, para recorridos de solo lectura
+        const T& verDato() const {
+            return dato;
+        }
+
         void setDato(T d) {
             dato = d;
         }
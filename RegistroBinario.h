@@ -0,0 +1,119 @@
+#ifndef REGISTROBINARIO_H
+#define REGISTROBINARIO_H
+
+// Registros binarios de ventas: los textos van como largo (u32) + bytes y los
+// números con su representación en memoria. Los usan el WAL (WAL.h) y las
+// particiones que la agregación en disco escribe a archivos temporales
+// (AgregacionExterna.h).
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <unistd.h>
+
+#include "Venta.h"
+
+using namespace std;
+
+void agregarU32(string& destino, uint32_t v) {
+    destino.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+void agregarTexto(string& destino, const string& s) {
+    agregarU32(destino, (uint32_t)s.size());
+    destino += s;
+}
+
+// Un valor que se copia byte a byte (números, agregados de GroupBy.h)
+template <class T>
+void agregarBytes(string& destino, const T& v) {
+    static_assert(is_trivially_copyable<T>::value, "agregarBytes solo copia tipos trivialmente copiables");
+    destino.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+void agregarVentaWAL(string& destino, const Venta& v) {
+    agregarTexto(destino, v.idVenta);
+    agregarTexto(destino, v.fecha);
+    agregarTexto(destino, v.pais);
+    agregarTexto(destino, v.ciudad);
+    agregarTexto(destino, v.cliente);
+    agregarTexto(destino, v.producto);
+    agregarTexto(destino, v.categoria);
+    destino.append(reinterpret_cast<const char*>(&v.cantidad), sizeof(v.cantidad));
+    destino.append(reinterpret_cast<const char*>(&v.precioUnitario), sizeof(v.precioUnitario));
+    destino.append(reinterpret_cast<const char*>(&v.montoTotal), sizeof(v.montoTotal));
+    agregarTexto(destino, v.medioEnvio);
+    agregarTexto(destino, v.estadoEnvio);
+}
+
+// Lee campos del contenido de un registro; 'ok' queda en false si se pasa del final
+class LectorRegistroWAL {
+private:
+    const string& datos;
+    size_t pos = 0;
+
+public:
+    bool ok = true;
+
+    explicit LectorRegistroWAL(const string& d) : datos(d) {}
+
+    template <class T>
+    T leer() {
+        T v{};
+        if (pos + sizeof(T) > datos.size()) {
+            ok = false;
+            return v;
+        }
+        memcpy(&v, datos.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return v;
+    }
+
+    string leerTexto() {
+        uint32_t n = leer<uint32_t>();
+        if (!ok || pos + n > datos.size()) {
+            ok = false;
+            return "";
+        }
+        string s = datos.substr(pos, n);
+        pos += n;
+        return s;
+    }
+
+    Venta leerVenta() {
+        Venta v;
+        v.idVenta = leerTexto();
+        v.fecha = leerTexto();
+        v.pais = leerTexto();
+        v.ciudad = leerTexto();
+        v.cliente = leerTexto();
+        v.producto = leerTexto();
+        v.categoria = leerTexto();
+        v.cantidad = leer<int>();
+        v.precioUnitario = leer<float>();
+        v.montoTotal = leer<float>();
+        v.medioEnvio = leerTexto();
+        v.estadoEnvio = leerTexto();
+        return v;
+    }
+
+    bool alFinal() const {
+        return pos == datos.size();
+    }
+};
+
+bool escribirTodoFd(int fd, const char* datos, size_t n) {
+    while (n > 0) {
+        ssize_t escritos = write(fd, datos, n);
+        if (escritos < 0 && errno == EINTR) continue;
+        if (escritos <= 0) return false;
+        datos += escritos;
+        n -= escritos;
+    }
+    return true;
+}
+
+#endif // REGISTROBINARIO_H
@@ -0,0 +1,229 @@
+#ifndef RESULTADOS_H
+#define RESULTADOS_H
+
+// Escritura de resultados en formatos para máquinas (JSON y CSV).
+//
+// Cada análisis o consulta calcula primero su resultado y después lo entrega
+// a un EscritorResultado como uno o más tablas de filas. Los escritores van
+// escribiendo a medida que reciben las filas, sin armar el documento en
+// memoria, así que un listado de un millón de ventas ocupa lo mismo que uno
+// de diez. El texto de siempre lo siguen generando las funciones mostrar*.
+//
+// JSON: JSON Lines, un objeto por reporte en una sola línea, con una
+// propiedad por tabla, para que una corrida con varios reportes se pueda leer
+// línea por línea:
+//   {"reporte":"top5","ciudades":[{"pais":"Peru","posicion":1,"ciudad":"Lima","monto":158377.2},...]}
+//
+// CSV: por cada tabla, la fila de encabezados, las filas y una línea vacía.
+//
+// Los montos se escriben con los dígitos justos para releer el mismo float
+// (no redondeados a dos decimales como en el texto).
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Venta.h"
+#include "CargaCSV.h"   // escribirFloatCSV
+
+using namespace std;
+
+enum FormatoResultado {
+    FORMATO_TEXTO,
+    FORMATO_JSON,
+    FORMATO_CSV
+};
+
+bool leerFormatoResultado(const string& texto, FormatoResultado& formato) {
+    if (texto == "texto" || texto == "text") formato = FORMATO_TEXTO;
+    else if (texto == "json") formato = FORMATO_JSON;
+    else if (texto == "csv") formato = FORMATO_CSV;
+    else return false;
+    return true;
+}
+
+class EscritorResultado {
+public:
+    virtual ~EscritorResultado() {}
+
+    virtual void comenzarReporte(const string& nombre) = 0;
+    virtual void comenzarTabla(const string& nombre, const vector<string>& columnas) = 0;
+
+    // Campos de la fila actual, en el orden de las columnas
+    virtual void texto(const string& valor) = 0;
+    virtual void entero(long long valor) = 0;
+    virtual void real(float valor) = 0;
+
+    virtual void terminarFila() = 0;
+    virtual void terminarTabla() = 0;
+    virtual void terminarReporte() = 0;
+};
+
+class EscritorJSON : public EscritorResultado {
+private:
+    ostream& salida;
+    vector<string> columnas;
+    size_t campo = 0;
+    bool primeraFila = true;
+
+    void escribirCadena(const string& valor) {
+        salida << '"';
+        for (char c : valor) {
+            if (c == '"' || c == '\\') {
+                salida << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                const char* hex = "0123456789abcdef";
+                salida << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+            } else {
+                salida << c;
+            }
+        }
+        salida << '"';
+    }
+
+    void nombreCampo() {
+        salida << (campo == 0 ? (primeraFila ? "{" : ",{") : ",");
+        escribirCadena(campo < columnas.size() ? columnas[campo] : "columna" + to_string(campo));
+        salida << ':';
+        campo++;
+    }
+
+public:
+    explicit EscritorJSON(ostream& s) : salida(s) {}
+
+    void comenzarReporte(const string& nombre) override {
+        salida << "{\"reporte\":";
+        escribirCadena(nombre);
+    }
+
+    void comenzarTabla(const string& nombre, const vector<string>& cols) override {
+        columnas = cols;
+        campo = 0;
+        primeraFila = true;
+        salida << ',';
+        escribirCadena(nombre);
+        salida << ":[";
+    }
+
+    void texto(const string& valor) override {
+        nombreCampo();
+        escribirCadena(valor);
+    }
+
+    void entero(long long valor) override {
+        nombreCampo();
+        salida << valor;
+    }
+
+    void real(float valor) override {
+        nombreCampo();
+        if (isfinite(valor)) escribirFloatCSV(salida, valor);
+        else salida << "null";
+    }
+
+    void terminarFila() override {
+        if (campo == 0) nombreCampo(); // fila sin campos: igual se abre el objeto
+        salida << '}';
+        campo = 0;
+        primeraFila = false;
+    }
+
+    void terminarTabla() override {
+        salida << ']';
+    }
+
+    void terminarReporte() override {
+        salida << "}\n";
+    }
+};
+
+class EscritorCSV : public EscritorResultado {
+private:
+    ostream& salida;
+    bool primerCampo = true;
+
+    void separador() {
+        if (!primerCampo) salida << ',';
+        primerCampo = false;
+    }
+
+    // Entre comillas sólo si hace falta (RFC 4180)
+    void escribirCampo(const string& valor) {
+        if (valor.find_first_of(",\"\r\n") == string::npos) {
+            salida << valor;
+            return;
+        }
+        salida << '"';
+        for (char c : valor) {
+            if (c == '"') salida << '"';
+            salida << c;
+        }
+        salida << '"';
+    }
+
+public:
+    explicit EscritorCSV(ostream& s) : salida(s) {}
+
+    void comenzarReporte(const string&) override {}
+
+    void comenzarTabla(const string&, const vector<string>& columnas) override {
+        primerCampo = true;
+        for (const string& c : columnas) {
+            separador();
+            escribirCampo(c);
+        }
+        salida << '\n';
+        primerCampo = true;
+    }
+
+    void texto(const string& valor) override {
+        separador();
+        escribirCampo(valor);
+    }
+
+    void entero(long long valor) override {
+        separador();
+        salida << valor;
+    }
+
+    void real(float valor) override {
+        separador();
+        escribirFloatCSV(salida, valor);
+    }
+
+    void terminarFila() override {
+        salida << '\n';
+        primerCampo = true;
+    }
+
+    void terminarTabla() override {
+        salida << '\n';
+    }
+
+    void terminarReporte() override {}
+};
+
+// Columnas de una venta completa (listados)
+const vector<string> COLUMNAS_VENTA = {
+    "id", "fecha", "pais", "ciudad", "cliente", "producto", "categoria",
+    "cantidad", "precio_unitario", "monto_total", "medio_envio", "estado_envio"
+};
+
+void escribirFilaVenta(EscritorResultado& escritor, const Venta& v) {
+    escritor.texto(v.idVenta);
+    escritor.texto(v.fecha);
+    escritor.texto(v.pais);
+    escritor.texto(v.ciudad);
+    escritor.texto(v.cliente);
+    escritor.texto(v.producto);
+    escritor.texto(v.categoria);
+    escritor.entero(v.cantidad);
+    escritor.real(v.precioUnitario);
+    escritor.real(v.montoTotal);
+    escritor.texto(v.medioEnvio);
+    escritor.texto(v.estadoEnvio);
+    escritor.terminarFila();
+}
+
+#endif // RESULTADOS_H
@@ -0,0 +1,200 @@
+#ifndef SALIDAREPORTE_H
+#define SALIDAREPORTE_H
+
+// Salida buffereada para los reportes (análisis, consultas y listados).
+//
+// Los reportes escriben con endl en cada línea; sobre cout o un ofstream eso
+// es un flush, y con él una llamada al sistema, por línea. ReporteBuffereado
+// redirige el ostream del reporte a un buffer grande que ignora esos flush y
+// vuelca todo junto al sumidero cuando se llena o cuando termina el reporte.
+// El formato del ostream (fixed, precisión, etc.) no cambia, así que la salida
+// es la misma byte a byte.
+//
+// Sumideros: SumideroFd escribe en un descriptor (stdout o un socket) y
+// SumideroStream en el streambuf que el ostream tenía antes (un archivo, un
+// ostringstream, ...).
+
+#include <cerrno>
+#include <charconv>
+#include <iostream>
+#include <streambuf>
+#include <vector>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+class SumideroReporte {
+public:
+    virtual ~SumideroReporte() {}
+
+    // Escribe n bytes; devuelve false si el destino dejó de aceptar datos
+    virtual bool escribir(const char* datos, size_t n) = 0;
+
+    // Se llama al terminar cada reporte
+    virtual void sincronizar() {}
+};
+
+// Escribe directamente en un descriptor. En sockets usa MSG_NOSIGNAL para
+// que un cliente que cortó no mate al proceso con SIGPIPE.
+class SumideroFd : public SumideroReporte {
+private:
+    int fd;
+    bool esSocket;
+
+public:
+    explicit SumideroFd(int f) : fd(f), esSocket(false) {
+        struct stat info;
+        if (fstat(fd, &info) == 0) esSocket = S_ISSOCK(info.st_mode);
+    }
+
+    bool escribir(const char* datos, size_t n) override {
+        size_t escritos = 0;
+        while (escritos < n) {
+            ssize_t r = esSocket ? send(fd, datos + escritos, n - escritos, MSG_NOSIGNAL)
+                                 : write(fd, datos + escritos, n - escritos);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) return false;
+            escritos += r;
+        }
+        return true;
+    }
+};
+
+// Escribe en otro streambuf (el del archivo o el del ostringstream)
+class SumideroStream : public SumideroReporte {
+private:
+    streambuf* destino;
+
+public:
+    explicit SumideroStream(streambuf* d) : destino(d) {}
+
+    bool escribir(const char* datos, size_t n) override {
+        return destino->sputn(datos, n) == static_cast<streamsize>(n);
+    }
+
+    void sincronizar() override {
+        destino->pubsync();
+    }
+};
+
+// streambuf de capacidad fija que sólo vuelca al sumidero cuando se llena o
+// cuando se llama a volcar(). sync() (lo que dispara endl) no hace nada.
+class BufferReporte : public streambuf {
+private:
+    SumideroReporte& sumidero;
+    vector<char> buffer;
+    bool fallo = false;
+
+    void drenar() {
+        size_t n = pptr() - pbase();
+        if (n > 0 && !fallo) fallo = !sumidero.escribir(pbase(), n);
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+protected:
+    int overflow(int c) override {
+        drenar();
+        if (c != traits_type::eof()) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return fallo ? traits_type::eof() : traits_type::not_eof(c);
+    }
+
+    streamsize xsputn(const char* s, streamsize n) override {
+        if (n <= epptr() - pptr()) {
+            traits_type::copy(pptr(), s, n);
+            pbump(static_cast<int>(n));
+            return n;
+        }
+        drenar();
+        if (static_cast<size_t>(n) >= buffer.size()) {
+            // No entra ni con el buffer vacío: va directo
+            if (!fallo) fallo = !sumidero.escribir(s, n);
+        } else {
+            traits_type::copy(pptr(), s, n);
+            pbump(static_cast<int>(n));
+        }
+        return fallo ? 0 : n;
+    }
+
+    int sync() override {
+        return 0;
+    }
+
+public:
+    BufferReporte(SumideroReporte& s, size_t capacidad) : sumidero(s), buffer(capacidad) {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    // Vuelca lo pendiente. Devuelve false si alguna escritura falló.
+    bool volcar() {
+        drenar();
+        sumidero.sincronizar();
+        return !fallo;
+    }
+};
+
+// Mientras existe, todo lo que se escribe en 'salida' pasa por un buffer de
+// 'capacidad' bytes; al destruirse lo vuelca y devuelve a 'salida' su
+// streambuf original. Sin sumidero, se escribe en ese streambuf original.
+class ReporteBuffereado {
+private:
+    static const size_t CAPACIDAD_POR_DEFECTO = 1 << 20;
+
+    ostream& salida;
+    streambuf* anterior;
+    SumideroStream sumideroPropio;
+    BufferReporte buffer;
+
+public:
+    ReporteBuffereado(ostream& s, SumideroReporte* sumidero = nullptr,
+                      size_t capacidad = CAPACIDAD_POR_DEFECTO)
+        : salida(s.flush()), anterior(s.rdbuf()), sumideroPropio(anterior),
+          buffer(sumidero != nullptr ? *sumidero : sumideroPropio, capacidad) {
+        salida.rdbuf(&buffer);
+    }
+
+    ~ReporteBuffereado() {
+        terminar();
+        salida.rdbuf(anterior);
+    }
+
+    ReporteBuffereado(const ReporteBuffereado&) = delete;
+    ReporteBuffereado& operator=(const ReporteBuffereado&) = delete;
+
+    // Vuelca lo escrito hasta ahora (fin de un reporte)
+    bool terminar() {
+        return buffer.volcar();
+    }
+};
+
+// Monto con dos decimales: reemplaza a 'fixed << setprecision(2) << valor'.
+// Formatea con to_chars y deja el stream en fixed/2 igual que los
+// manipuladores, porque lo que se imprime después puede depender de eso.
+struct Fijo2 {
+    double valor;
+};
+
+inline Fijo2 fijo2(double valor) {
+    return Fijo2{valor};
+}
+
+inline ostream& operator<<(ostream& salida, const Fijo2& f) {
+    salida.setf(ios::fixed, ios::floatfield);
+    salida.precision(2);
+    char texto[64];
+    to_chars_result r = to_chars(texto, texto + sizeof(texto), f.valor, chars_format::fixed, 2);
+    streamsize largo = r.ptr - texto;
+    if (r.ec != errc() || salida.width() > largo || (salida.flags() & ios::showpos)) {
+        return salida << f.valor; // casos raros: que lo resuelva el stream
+    }
+    salida.width(0);
+    salida.write(texto, largo);
+    return salida;
+}
+
+#endif // SALIDAREPORTE_H
@@ -0,0 +1,363 @@
+#ifndef SEGUIMIENTO_H
+#define SEGUIMIENTO_H
+
+// Modo seguimiento (tp --seguir): carga el CSV y se queda vigilándolo con
+// inotify. Cada vez que el archivo crece se leen sólo los bytes nuevos, se
+// parsean las líneas completas (una línea a medio escribir espera a la
+// próxima notificación), se agregan al final de la lista y se actualizan los
+// agregados por país/ciudad, fecha y producto.
+//
+// Mientras tanto se aceptan órdenes por stdin con la sintaxis de ModoBatch.h.
+// "analyze top5", "analyze dia" y "analyze producto" se responden desde los
+// agregados, sin recorrer la lista, así que tardan lo mismo con mil ventas que
+// con millones; el resto de las lecturas recorre la lista completa. "status"
+// muestra cuántas ventas se leyeron. Las órdenes de gestión no se aceptan:
+// el CSV es la única fuente de cambios.
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+#include "Venta.h"
+#include "Lista.h"
+#include "CargaCSV.h"
+#include "Metricas.h"
+#include "ModoBatch.h"
+
+using namespace std;
+
+// Lo pone en true el manejador de SIGINT/SIGTERM
+volatile sig_atomic_t g_detenerSeguimiento = 0;
+
+void manejarSenialSeguimiento(int) {
+    g_detenerSeguimiento = 1;
+}
+
+// Totales que usan los análisis de top 5 de ciudades, día de mayor venta y
+// producto más/menos vendido. Se actualizan con cada venta en O(1) y se
+// consultan en tiempo proporcional a la cantidad de claves distintas.
+// Agrupan con los mismos GroupBy y arman el resultado con las mismas
+// funciones que los análisis de Analisis.h, así que los montos y el orden de
+// países y ciudades coinciden con los del modo batch.
+class AgregadosVentas {
+private:
+    GroupBy<Claves<ColumnaPais, ColumnaCiudad>, Suma<ColumnaMonto>> montoPorPaisCiudad;
+    SerieDiaria montoPorDia;
+    unordered_map<string, pair<string, SerieDiaria>> montoPorDiaPorPais; // país normalizado -> (primer nombre, serie)
+    GroupBy<Claves<ColumnaProducto>, Suma<ColumnaCantidad>> cantidadPorProducto;
+    long long ventas = 0;
+
+public:
+    void agregar(const Venta& v) {
+        montoPorPaisCiudad.agregar(v);
+        long long dia;
+        if (leerDia(v.fecha, dia)) {
+            TotalesDia totales(v.montoTotal, v.cantidad, 1);
+            montoPorDia.sumar(dia, totales);
+            auto it = montoPorDiaPorPais.find(normalizarClaveIndice(v.pais));
+            if (it == montoPorDiaPorPais.end()) {
+                it = montoPorDiaPorPais.emplace(normalizarClaveIndice(v.pais), make_pair(v.pais, SerieDiaria())).first;
+            }
+            it->second.second.sumar(dia, totales);
+        }
+        cantidadPorProducto.agregar(v);
+        ventas++;
+    }
+
+    long long getVentas() const {
+        return ventas;
+    }
+
+    // Mismos resultados que calcularTop5CiudadesPorPais, etc., así que se
+    // muestran y se escriben en JSON/CSV con las funciones de Analisis.h.
+    ResultadoTop5Ciudades top5Ciudades() const {
+        return resultadoTop5Ciudades(montoPorPaisCiudad);
+    }
+
+    ResultadoDiaMayorVentas diaMayorVentas() const {
+        vector<pair<string, const SerieDiaria*>> paises;
+        for (const auto& par : montoPorDiaPorPais) paises.push_back({par.second.first, &par.second.second});
+        return resultadoDiaMayorVentas(montoPorDia, paises);
+    }
+
+    ResultadoProductoMasYMenosVendido productoMasYMenosVendido() const {
+        return resultadoProductoMasYMenosVendido(cantidadPorProducto);
+    }
+};
+
+// Pasa a 'lineas' las líneas completas de 'buffer' (sin el '\n') y deja en el
+// buffer sólo el resto que todavía no terminó
+void extraerLineas(string& buffer, vector<string>& lineas) {
+    size_t inicio = 0;
+    size_t fin;
+    while ((fin = buffer.find('\n', inicio)) != string::npos) {
+        lineas.emplace_back(buffer, inicio, fin - inicio);
+        inicio = fin + 1;
+    }
+    buffer.erase(0, inicio);
+}
+
+// Lee incrementalmente un CSV que sólo crece por el final
+class SeguidorCSV {
+private:
+    string archivo;
+    int fd = -1;
+    int fdInotify = -1;
+    int vigilancia = -1;
+    off_t desplazamiento = 0;      // bytes ya consumidos del archivo
+    string pendiente;              // línea todavía sin '\n'
+    bool encabezadoPendiente = true;
+    long long lineasInvalidas = 0;
+
+public:
+    explicit SeguidorCSV(const string& a) : archivo(a) {}
+
+    ~SeguidorCSV() {
+        if (fdInotify != -1) close(fdInotify);
+        if (fd != -1) close(fd);
+    }
+
+    SeguidorCSV(const SeguidorCSV&) = delete;
+    SeguidorCSV& operator=(const SeguidorCSV&) = delete;
+
+    bool iniciar(string& error) {
+        fd = open(archivo.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            error = "no se pudo abrir " + archivo + ": " + strerror(errno);
+            return false;
+        }
+        fdInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fdInotify == -1) {
+            error = string("inotify_init1: ") + strerror(errno);
+            return false;
+        }
+        vigilancia = inotify_add_watch(fdInotify, archivo.c_str(), IN_MODIFY | IN_MOVE_SELF | IN_DELETE_SELF);
+        if (vigilancia == -1) {
+            error = "no se pudo vigilar " + archivo + ": " + strerror(errno);
+            return false;
+        }
+        return true;
+    }
+
+    int getFdInotify() const {
+        return fdInotify;
+    }
+
+    bool sigueVigilando() const {
+        return vigilancia != -1;
+    }
+
+    long long getLineasInvalidas() const {
+        return lineasInvalidas;
+    }
+
+    // Consume los eventos pendientes de inotify. Si el archivo se movió o se
+    // borró se deja de vigilar (lo ya cargado sigue disponible).
+    void descartarEventos() {
+        alignas(inotify_event) char eventos[4096];
+        ssize_t leidos;
+        while ((leidos = read(fdInotify, eventos, sizeof(eventos))) > 0) {
+            for (char* p = eventos; p < eventos + leidos;) {
+                inotify_event* evento = reinterpret_cast<inotify_event*>(p);
+                if (evento->mask & (IN_MOVE_SELF | IN_DELETE_SELF | IN_IGNORED)) {
+                    if (vigilancia != -1) {
+                        cerr << "Seguimiento: " << archivo << " fue movido o borrado; se deja de vigilar." << endl;
+                        inotify_rm_watch(fdInotify, vigilancia);
+                        vigilancia = -1;
+                    }
+                }
+                p += sizeof(inotify_event) + evento->len;
+            }
+        }
+    }
+
+    // Lee lo agregado desde la última llamada y entrega cada venta de las
+    // líneas completas a 'alLeerVenta'. Devuelve la cantidad de ventas nuevas.
+    template <class AlLeerVenta>
+    long long leerNuevas(AlLeerVenta alLeerVenta) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size < desplazamiento) {
+            // Truncado: lo ya cargado no se puede deshacer, se sigue desde el nuevo fin
+            cerr << "Seguimiento: " << archivo << " se acorto; se ignora hasta que vuelva a crecer." << endl;
+            desplazamiento = info.st_size;
+            pendiente.clear();
+            return 0;
+        }
+
+        TemporizadorFase temporizador("seguimiento/lectura", "seguimiento");
+        long long nuevas = 0;
+        vector<string> lineas;
+        char bloque[65536];
+        while (true) {
+            ssize_t leidos = pread(fd, bloque, sizeof(bloque), desplazamiento);
+            if (leidos < 0 && errno == EINTR) continue;
+            if (leidos <= 0) break;
+            desplazamiento += leidos;
+            pendiente.append(bloque, leidos);
+
+            lineas.clear();
+            extraerLineas(pendiente, lineas);
+            for (const string& linea : lineas) {
+                if (encabezadoPendiente) {
+                    encabezadoPendiente = false;
+                    continue;
+                }
+                if (linea.empty() || linea == "\r") continue;
+                try {
+                    alLeerVenta(parsearLineaVenta(linea));
+                    nuevas++;
+                } catch (const exception& e) {
+                    lineasInvalidas++;
+                    cerr << "Seguimiento: linea invalida ignorada: " << linea << endl;
+                }
+            }
+        }
+        temporizador.setFilas(nuevas);
+        return nuevas;
+    }
+};
+
+// Resuelve una orden leída por stdin en modo seguimiento
+void atenderOrdenSeguimiento(const string& linea, const Lista<Venta>& listaVentas,
+                             const AgregadosVentas& agregados, const SeguidorCSV& seguidor,
+                             ostream& salida, FormatoResultado formato) {
+    vector<string> tokens = tokenizarOrden(linea);
+    if (tokens.empty()) return;
+
+    auto inicio = chrono::steady_clock::now();
+    string clave, error;
+    bool ok = true;
+    ReporteBuffereado reporte(salida);
+    EscritorJSON escritorJSON(salida);
+    EscritorCSV escritorCSV(salida);
+    EscritorResultado* escritor = formato == FORMATO_JSON ? static_cast<EscritorResultado*>(&escritorJSON)
+                                : formato == FORMATO_CSV ? static_cast<EscritorResultado*>(&escritorCSV)
+                                : nullptr;
+    if (tokens[0] == "status") {
+        clave = "status";
+        salida << "Ventas cargadas: " << listaVentas.getTamanio()
+               << ", lineas invalidas: " << seguidor.getLineasInvalidas()
+               << (seguidor.sigueVigilando() ? "" : " (ya no se vigila el archivo)") << "\n";
+    } else if (tokens[0] == "analyze" && tokens.size() == 2 &&
+               (tokens[1] == "top5" || tokens[1] == "dia" || tokens[1] == "producto")) {
+        clave = "analyze " + tokens[1];
+        if (tokens[1] == "top5") {
+            TemporizadorFase temporizador("seguimiento/top5", "seguimiento", agregados.getVentas());
+            ResultadoTop5Ciudades resultado = agregados.top5Ciudades();
+            if (escritor != nullptr) escribirTop5CiudadesPorPais(resultado, *escritor);
+            else mostrarTop5CiudadesPorPais(resultado, salida);
+        } else if (tokens[1] == "dia") {
+            TemporizadorFase temporizador("seguimiento/dia", "seguimiento", agregados.getVentas());
+            ResultadoDiaMayorVentas resultado = agregados.diaMayorVentas();
+            if (escritor != nullptr) escribirDiaMayorVentas(resultado, *escritor);
+            else mostrarDiaMayorVentas(resultado, salida);
+        } else {
+            TemporizadorFase temporizador("seguimiento/producto", "seguimiento", agregados.getVentas());
+            ResultadoProductoMasYMenosVendido resultado = agregados.productoMasYMenosVendido();
+            if (escritor != nullptr) escribirProductoMasYMenosVendido(resultado, *escritor);
+            else mostrarProductoMasYMenosVendido(resultado, salida);
+        }
+    } else if (esOrdenDeEscritura(tokens)) {
+        ok = false;
+        error = "en modo seguimiento los cambios llegan solo por el CSV";
+    } else {
+        try {
+            ok = ejecutarLectura(listaVentas, tokens, salida, clave, error, escritor);
+        } catch (const exception& e) {
+            ok = false;
+            error = e.what();
+        } catch (int codigo) {
+            ok = false;
+            error = "codigo " + to_string(codigo);
+        }
+    }
+    reporte.terminar();
+
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+    if (ok) {
+        cerr << "[" << clave << ": " << fixed << setprecision(3) << ms << " ms]" << endl;
+    } else {
+        cerr << "Error: " << error << endl;
+    }
+}
+
+// Carga 'archivo', lo sigue y atiende órdenes por stdin hasta fin de entrada,
+// "quit", SIGINT o SIGTERM. Devuelve false si no se pudo empezar a vigilar.
+bool ejecutarSeguimiento(const string& archivo, Lista<Venta>& listaVentas, ostream& salida,
+                         FormatoResultado formato = FORMATO_TEXTO) {
+    AgregadosVentas agregados;
+    SeguidorCSV seguidor(archivo);
+    string error;
+    if (!seguidor.iniciar(error)) {
+        cerr << "Seguimiento: " << error << endl;
+        return false;
+    }
+
+    auto alLeerVenta = [&](const Venta& v) {
+        unsigned long long version = listaVentas.getVersion();
+        listaVentas.insertarUltimo(v);
+        g_indicesVentas.ventaAgregada(listaVentas, version);
+        agregados.agregar(v);
+    };
+    seguidor.leerNuevas(alLeerVenta);
+    cerr << "Se han cargado " << listaVentas.getTamanio() << " ventas. Siguiendo " << archivo
+         << " (ordenes por stdin, 'quit' para salir)." << endl;
+
+    signal(SIGINT, manejarSenialSeguimiento);
+    signal(SIGTERM, manejarSenialSeguimiento);
+
+    string entrada;
+    vector<string> lineas;
+    bool entradaAbierta = true;
+    while (entradaAbierta && !g_detenerSeguimiento) {
+        pollfd esperas[2] = {{seguidor.getFdInotify(), POLLIN, 0}, {STDIN_FILENO, POLLIN, 0}};
+        // Timeout para revisar periódicamente si llegó una señal
+        if (poll(esperas, 2, 200) <= 0) continue;
+
+        if (esperas[0].revents & POLLIN) {
+            seguidor.descartarEventos();
+            long long nuevas = seguidor.leerNuevas(alLeerVenta);
+            if (nuevas > 0) {
+                cerr << "Seguimiento: +" << nuevas << " ventas (total " << listaVentas.getTamanio() << ")." << endl;
+            }
+        }
+
+        if (esperas[1].revents & (POLLIN | POLLHUP)) {
+            char bloque[4096];
+            ssize_t leidos = read(STDIN_FILENO, bloque, sizeof(bloque));
+            if (leidos < 0 && errno == EINTR) continue;
+            if (leidos <= 0) {
+                entradaAbierta = false;
+                if (!entrada.empty()) entrada += '\n'; // última orden sin fin de línea
+            } else {
+                entrada.append(bloque, leidos);
+            }
+            lineas.clear();
+            extraerLineas(entrada, lineas);
+            for (string& linea : lineas) {
+                if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+                if (linea == "quit") {
+                    entradaAbierta = false;
+                    break;
+                }
+                atenderOrdenSeguimiento(linea, listaVentas, agregados, seguidor, salida, formato);
+            }
+        }
+    }
+    return true;
+}
+
+#endif // SEGUIMIENTO_H
@@ -0,0 +1,263 @@
+#ifndef SERIEDIARIA_H
+#define SERIEDIARIA_H
+
+// Serie de ventas por día: monto, unidades y cantidad de ventas de cada día,
+// global y por país.
+//
+// Sumar un rango de fechas recorría las filas del país y volvía a leer la
+// fecha de cada una. SerieDiaria guarda los totales de cada día en un arreglo
+// denso (un lugar por día entre el primero y el último con ventas) y, sobre
+// él:
+//   - un árbol de Fenwick con las sumas parciales: el total de un rango de
+//     días es la resta de dos prefijos, O(log D);
+//   - un árbol de segmentos con el día de mayor monto de cada tramo: el mejor
+//     día de un rango también sale en O(log D).
+// Cada alta, baja o modificación actualiza su día en O(log D). Si llega un
+// día fuera del tramo cubierto, el arreglo se agranda (al doble, para que
+// reconstruir los árboles salga amortizado).
+//
+// Las semanas (de lunes a domingo) y los meses son rangos de días: cada uno
+// es una consulta al árbol de Fenwick. Los N días de mayor monto salen de una
+// pasada por el arreglo denso.
+//
+// IndiceVentas guarda el día de cada fila y mantiene las series.
+
+#include <cstdint>
+#include <vector>
+
+#include "Fechas.h"
+
+using namespace std;
+
+// Totales de un día o de un rango de días
+struct TotalesDia {
+    double monto = 0.0;
+    long long cantidad = 0;
+    long long ventas = 0;
+
+    TotalesDia() {}
+    TotalesDia(double m, long long c, long long v) : monto(m), cantidad(c), ventas(v) {}
+
+    TotalesDia& operator+=(const TotalesDia& o) {
+        monto += o.monto;
+        cantidad += o.cantidad;
+        ventas += o.ventas;
+        return *this;
+    }
+
+    TotalesDia operator-(const TotalesDia& o) const {
+        return TotalesDia(monto - o.monto, cantidad - o.cantidad, ventas - o.ventas);
+    }
+};
+
+// Árbol de Fenwick (binary indexed tree) sobre posiciones 0..n-1: suma un
+// valor en una posición y devuelve sumas de prefijos, ambos en O(log n)
+template <class T>
+class ArbolFenwick {
+private:
+    vector<T> arbol; // arbol[i] (base 1) suma las posiciones (i - (i & -i), i]
+
+public:
+    // Arma el árbol con los valores iniciales en O(n)
+    void construir(const vector<T>& valores) {
+        arbol.assign(valores.size() + 1, T());
+        for (size_t i = 1; i <= valores.size(); ++i) {
+            arbol[i] += valores[i - 1];
+            size_t padre = i + (i & (~i + 1));
+            if (padre < arbol.size()) arbol[padre] += arbol[i];
+        }
+    }
+
+    void sumar(size_t posicion, const T& delta) {
+        for (size_t i = posicion + 1; i < arbol.size(); i += i & (~i + 1)) arbol[i] += delta;
+    }
+
+    // Suma de las posiciones [0, fin)
+    T prefijo(size_t fin) const {
+        T total;
+        for (size_t i = fin < arbol.size() ? fin : arbol.size() - 1; i > 0; i -= i & (~i + 1)) total += arbol[i];
+        return total;
+    }
+
+    size_t getBytes() const {
+        return arbol.capacity() * sizeof(T);
+    }
+};
+
+class SerieDiaria {
+private:
+    long long primerDia = 0;    // día de dias[0]
+    vector<TotalesDia> dias;    // totales de cada día del tramo cubierto
+    ArbolFenwick<TotalesDia> sumas;
+    vector<int32_t> mejores;    // árbol de segmentos: posición del día de mayor monto (-1: sin ventas)
+    size_t hojas = 0;           // primera hoja de 'mejores' (potencia de 2)
+
+    // El mejor de dos días: más monto y, a igual monto, el primero
+    int32_t mejor(int32_t a, int32_t b) const {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        return dias[b].monto > dias[a].monto ? b : a;
+    }
+
+    void reconstruirArboles() {
+        sumas.construir(dias);
+        hojas = 1;
+        while (hojas < dias.size()) hojas *= 2;
+        mejores.assign(2 * hojas, -1);
+        for (size_t i = 0; i < dias.size(); ++i) {
+            if (dias[i].ventas > 0) mejores[hojas + i] = static_cast<int32_t>(i);
+        }
+        for (size_t i = hojas - 1; i > 0; --i) mejores[i] = mejor(mejores[2 * i], mejores[2 * i + 1]);
+    }
+
+    // Agranda el tramo cubierto hasta incluir 'dia'
+    void cubrir(long long dia) {
+        if (dias.empty()) {
+            primerDia = dia;
+            dias.assign(1, TotalesDia());
+            reconstruirArboles();
+            return;
+        }
+        long long ultimoDia = primerDia + static_cast<long long>(dias.size()) - 1;
+        if (dia >= primerDia && dia <= ultimoDia) return;
+
+        long long largo = static_cast<long long>(dias.size());
+        long long nuevoPrimero = primerDia, nuevoUltimo = ultimoDia;
+        if (dia < primerDia) nuevoPrimero = min(dia, primerDia - largo);
+        else nuevoUltimo = max(dia, ultimoDia + largo);
+
+        vector<TotalesDia> nuevos(static_cast<size_t>(nuevoUltimo - nuevoPrimero + 1));
+        for (size_t i = 0; i < dias.size(); ++i) nuevos[static_cast<size_t>(primerDia - nuevoPrimero) + i] = dias[i];
+        dias.swap(nuevos);
+        primerDia = nuevoPrimero;
+        reconstruirArboles();
+    }
+
+    // Posiciones [desde, hasta] del rango de días, recortado al tramo cubierto;
+    // false si no se tocan
+    bool posiciones(long long desdeDia, long long hastaDia, size_t& desde, size_t& hasta) const {
+        long long ultimoDia = primerDia + static_cast<long long>(dias.size()) - 1;
+        if (dias.empty() || hastaDia < primerDia || desdeDia > ultimoDia || desdeDia > hastaDia) return false;
+        desde = static_cast<size_t>(max(desdeDia, primerDia) - primerDia);
+        hasta = static_cast<size_t>(min(hastaDia, ultimoDia) - primerDia);
+        return true;
+    }
+
+public:
+    // Suma 'delta' (negativo para quitar una venta) al día
+    void sumar(long long dia, const TotalesDia& delta) {
+        cubrir(dia);
+        size_t i = static_cast<size_t>(dia - primerDia);
+        TotalesDia nuevo = dias[i];
+        nuevo += delta;
+        // Un día que se quedó sin ventas vuelve a cero exacto (sin restos de redondeo)
+        if (nuevo.ventas == 0) nuevo = TotalesDia();
+        sumas.sumar(i, nuevo - dias[i]);
+        dias[i] = nuevo;
+
+        size_t nodo = hojas + i;
+        mejores[nodo] = dias[i].ventas > 0 ? static_cast<int32_t>(i) : -1;
+        for (nodo /= 2; nodo > 0; nodo /= 2) mejores[nodo] = mejor(mejores[2 * nodo], mejores[2 * nodo + 1]);
+    }
+
+    // Totales de los días [desdeDia, hastaDia]
+    TotalesDia rango(long long desdeDia, long long hastaDia) const {
+        size_t desde, hasta;
+        if (!posiciones(desdeDia, hastaDia, desde, hasta)) return TotalesDia();
+        return sumas.prefijo(hasta + 1) - sumas.prefijo(desde);
+    }
+
+    // Día de mayor monto entre [desdeDia, hastaDia] (a igual monto, el
+    // primero); false si no hay ventas en el rango
+    bool diaMayor(long long desdeDia, long long hastaDia, long long& dia, TotalesDia& totales) const {
+        size_t desde, hasta;
+        if (!posiciones(desdeDia, hastaDia, desde, hasta)) return false;
+        // Se recorre de abajo hacia arriba; los tramos de la izquierda se
+        // combinan en orden y los de la derecha se guardan para el final
+        int32_t izquierda = -1, derecha = -1;
+        for (size_t a = desde + hojas, b = hasta + hojas + 1; a < b; a /= 2, b /= 2) {
+            if (a & 1) izquierda = mejor(izquierda, mejores[a++]);
+            if (b & 1) derecha = mejor(mejores[--b], derecha);
+        }
+        int32_t posicion = mejor(izquierda, derecha);
+        if (posicion < 0) return false;
+        dia = primerDia + posicion;
+        totales = dias[posicion];
+        return true;
+    }
+
+    // Los 'n' días de mayor monto (a igual monto, el primero), de mayor a
+    // menor, en una pasada por el arreglo
+    vector<long long> mejoresDias(size_t n) const {
+        vector<size_t> mejores; // de mayor a menor
+        for (size_t i = 0; i < dias.size(); ++i) {
+            if (dias[i].ventas == 0) continue;
+            if (mejores.size() == n && !(dias[i].monto > dias[mejores.back()].monto)) continue;
+            if (mejores.size() == n) mejores.pop_back();
+            size_t j = mejores.size();
+            mejores.push_back(i);
+            for (; j > 0 && dias[i].monto > dias[mejores[j - 1]].monto; --j) mejores[j] = mejores[j - 1];
+            mejores[j] = i;
+        }
+        vector<long long> resultado;
+        for (size_t i : mejores) resultado.push_back(primerDia + static_cast<long long>(i));
+        return resultado;
+    }
+
+    // Totales de un día (cero si no tuvo ventas)
+    TotalesDia dia(long long d) const {
+        size_t desde, hasta;
+        return posiciones(d, d, desde, hasta) ? dias[desde] : TotalesDia();
+    }
+
+    // Primer y último día del tramo cubierto; false si nunca tuvo ventas
+    bool tramo(long long& desdeDia, long long& hastaDia) const {
+        if (dias.empty()) return false;
+        desdeDia = primerDia;
+        hastaDia = primerDia + static_cast<long long>(dias.size()) - 1;
+        return true;
+    }
+
+    const vector<TotalesDia>& getDias() const {
+        return dias;
+    }
+
+    size_t getBytes() const {
+        return dias.capacity() * sizeof(TotalesDia) + sumas.getBytes() + mejores.capacity() * sizeof(int32_t);
+    }
+};
+
+// Serie global y una por país (por código de país de IndiceVentas)
+class SeriesDiarias {
+private:
+    SerieDiaria global;
+    vector<SerieDiaria> paises;
+
+public:
+    size_t getCantidadPaises() const {
+        return paises.size();
+    }
+
+    void sumar(uint32_t codigoPais, long long dia, const TotalesDia& delta) {
+        global.sumar(dia, delta);
+        if (codigoPais >= paises.size()) paises.resize(codigoPais + 1);
+        paises[codigoPais].sumar(dia, delta);
+    }
+
+    const SerieDiaria& getGlobal() const {
+        return global;
+    }
+
+    // nullptr si el país no tiene ventas con fecha
+    const SerieDiaria* pais(uint32_t codigoPais) const {
+        return codigoPais < paises.size() ? &paises[codigoPais] : nullptr;
+    }
+
+    size_t getBytes() const {
+        size_t total = global.getBytes() + paises.capacity() * sizeof(SerieDiaria);
+        for (const SerieDiaria& s : paises) total += s.getBytes();
+        return total;
+    }
+};
+
+#endif // SERIEDIARIA_H
@@ -0,0 +1,179 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+// Modo servidor: carga el dataset una vez y atiende consultas, análisis y
+// operaciones de gestión por un socket de dominio Unix (protocolo descripto
+// en SocketUnix.h, órdenes con la sintaxis de ModoBatch.h).
+//
+// Un hilo acepta conexiones y las encola; un pool de trabajadores las atiende.
+// Las lecturas (analyze/query) fijan la versión vigente de BaseVentas y
+// corren sin locks; las escrituras (add/delete/modify) se serializan entre sí
+// y publican una versión nueva sin esperar a las lecturas en curso.
+
+#include <atomic>
+#include <condition_variable>
+#include <csignal>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <poll.h>
+
+#include "ModoBatch.h"
+#include "BaseVentas.h"
+#include "SocketUnix.h"
+
+using namespace std;
+
+// Lo pone en true el manejador de SIGINT/SIGTERM
+volatile sig_atomic_t g_detenerServidor = 0;
+
+void manejarSenialServidor(int) {
+    g_detenerServidor = 1;
+}
+
+class ServidorVentas {
+private:
+    BaseVentas& base;
+    string ruta;
+    int cantidadHilos;
+    FormatoResultado formato; // de las respuestas a analyze/query
+    int fdEscucha = -1;
+
+    mutex mtxCola;
+    condition_variable hayConexiones;
+    deque<int> pendientes;
+    unordered_set<int> activas; // conexiones en curso, para cortarlas al detener
+    bool detenido = false;
+
+    atomic<long long> ordenesAtendidas{0};
+    atomic<long long> ordenesConError{0};
+
+    // Ejecuta una orden (lectura sobre la versión fijada, escritura sobre una
+    // copia que luego se publica) y arma la respuesta
+    string responder(const string& linea, bool& cerrarConexion) {
+        vector<string> tokens = tokenizarOrden(linea);
+        if (tokens.empty() || tokens[0] == "ping") return "OK 0\n";
+        if (tokens[0] == "quit") {
+            cerrarConexion = true;
+            return "OK 0\n";
+        }
+
+        ostringstream salida;
+        string clave, error;
+        bool ok;
+        try {
+            if (esOrdenDeEscritura(tokens)) {
+                ok = false;
+                base.modificar([&](Lista<Venta>& lista) {
+                    bool cambio;
+                    ok = ejecutarEscritura(lista, tokens, salida, clave, error, cambio);
+                    return ok && cambio;
+                });
+                // Con WAL, se confirma recién cuando el cambio está en disco
+                if (ok && g_observadorGestion != nullptr && !g_observadorGestion->esperarDurable()) {
+                    ok = false;
+                    error = "el cambio se aplico pero no se pudo persistir en el WAL";
+                }
+            } else {
+                shared_ptr<const VersionVentas> version = base.fijar();
+                ok = ejecutarLectura(version->ventas, tokens, salida, clave, error, formato);
+            }
+        } catch (const exception& e) {
+            ok = false;
+            error = e.what();
+        } catch (int codigo) {
+            ok = false;
+            error = "codigo " + to_string(codigo);
+        }
+
+        ordenesAtendidas++;
+        if (!ok) {
+            ordenesConError++;
+            for (char& c : error) {
+                if (c == '\n') c = ' ';
+            }
+            return "ERR " + error + "\n";
+        }
+        string resultado = salida.str();
+        return "OK " + to_string(resultado.size()) + "\n" + resultado;
+    }
+
+    void atenderConexion(int fd) {
+        ConexionSocket conexion(fd);
+        string linea;
+        bool cerrarConexion = false;
+        while (!cerrarConexion && conexion.leerLinea(linea)) {
+            if (!conexion.escribir(responder(linea, cerrarConexion))) break;
+        }
+        lock_guard<mutex> lock(mtxCola);
+        activas.erase(fd);
+    }
+
+    void trabajador() {
+        while (true) {
+            int fd;
+            {
+                unique_lock<mutex> lock(mtxCola);
+                hayConexiones.wait(lock, [this] { return detenido || !pendientes.empty(); });
+                if (detenido) return;
+                fd = pendientes.front();
+                pendientes.pop_front();
+                activas.insert(fd);
+            }
+            atenderConexion(fd);
+        }
+    }
+
+public:
+    ServidorVentas(BaseVentas& b, const string& r, int hilos, FormatoResultado f = FORMATO_TEXTO)
+        : base(b), ruta(r), cantidadHilos(hilos < 1 ? 1 : hilos), formato(f) {}
+
+    bool iniciar() {
+        fdEscucha = escucharSocketUnix(ruta, 128);
+        return fdEscucha != -1;
+    }
+
+    // Acepta conexiones hasta recibir SIGINT o SIGTERM
+    void ejecutar() {
+        signal(SIGINT, manejarSenialServidor);
+        signal(SIGTERM, manejarSenialServidor);
+
+        vector<thread> hilos;
+        for (int i = 0; i < cantidadHilos; ++i) {
+            hilos.emplace_back(&ServidorVentas::trabajador, this);
+        }
+        cerr << "Servidor escuchando en " << ruta << " con " << cantidadHilos << " hilos." << endl;
+
+        // poll con timeout para revisar periódicamente si llegó una señal
+        pollfd espera{fdEscucha, POLLIN, 0};
+        while (!g_detenerServidor) {
+            if (poll(&espera, 1, 200) <= 0) continue;
+            int fd = accept(fdEscucha, nullptr, nullptr);
+            if (fd == -1) continue;
+            lock_guard<mutex> lock(mtxCola);
+            pendientes.push_back(fd);
+            hayConexiones.notify_one();
+        }
+
+        {
+            lock_guard<mutex> lock(mtxCola);
+            detenido = true;
+            for (int fd : pendientes) close(fd);
+            pendientes.clear();
+            for (int fd : activas) shutdown(fd, SHUT_RDWR); // desbloquea a los trabajadores
+        }
+        hayConexiones.notify_all();
+        for (thread& h : hilos) h.join();
+
+        close(fdEscucha);
+        unlink(ruta.c_str());
+        cerr << "Servidor detenido. Ordenes atendidas: " << ordenesAtendidas
+             << " (" << ordenesConError << " con error)." << endl;
+    }
+};
+
+#endif // SERVIDOR_H
@@ -0,0 +1,154 @@
+#ifndef SOCKETUNIX_H
+#define SOCKETUNIX_H
+
+// Utilidades mínimas sobre sockets de dominio Unix (servidor y cliente de
+// carga). Protocolo de línea:
+//
+//   cliente -> servidor:  una orden por línea, con la sintaxis del modo batch
+//   servidor -> cliente:  "OK <n>\n" seguido de n bytes de resultado, o
+//                         "ERR <mensaje>\n"
+//
+// Además de las órdenes del modo batch se aceptan "ping" (responde OK sin
+// contenido) y "quit" (cierra la conexión).
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace std;
+
+// Conexión con lectura por líneas sobre un buffer propio
+class ConexionSocket {
+private:
+    int fd;
+    string buffer;
+    size_t inicio = 0;
+
+    // Trae más datos al buffer. Devuelve false si se cerró la conexión.
+    bool rellenar() {
+        if (inicio > 0 && inicio == buffer.size()) {
+            buffer.clear();
+            inicio = 0;
+        }
+        char bloque[65536];
+        ssize_t leidos;
+        do {
+            leidos = recv(fd, bloque, sizeof(bloque), 0);
+        } while (leidos < 0 && errno == EINTR);
+        if (leidos <= 0) return false;
+        buffer.append(bloque, leidos);
+        return true;
+    }
+
+public:
+    explicit ConexionSocket(int f) : fd(f) {}
+
+    ~ConexionSocket() {
+        cerrar();
+    }
+
+    ConexionSocket(const ConexionSocket&) = delete;
+    ConexionSocket& operator=(const ConexionSocket&) = delete;
+
+    int getFd() const {
+        return fd;
+    }
+
+    void cerrar() {
+        if (fd != -1) close(fd);
+        fd = -1;
+    }
+
+    // Lee una línea sin el '\n' (y sin '\r' final)
+    bool leerLinea(string& linea) {
+        while (true) {
+            size_t fin = buffer.find('\n', inicio);
+            if (fin != string::npos) {
+                linea.assign(buffer, inicio, fin - inicio);
+                inicio = fin + 1;
+                if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+                return true;
+            }
+            if (!rellenar()) return false;
+        }
+    }
+
+    // Lee exactamente n bytes
+    bool leerBytes(size_t n, string& datos) {
+        while (buffer.size() - inicio < n) {
+            if (!rellenar()) return false;
+        }
+        datos.assign(buffer, inicio, n);
+        inicio += n;
+        return true;
+    }
+
+    bool escribir(const string& datos) {
+        size_t enviados = 0;
+        while (enviados < datos.size()) {
+            ssize_t n = send(fd, datos.data() + enviados, datos.size() - enviados, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            enviados += n;
+        }
+        return true;
+    }
+
+    // Envía una orden y espera la respuesta. 'ok' indica si fue OK o ERR;
+    // 'respuesta' queda con el resultado o con el mensaje de error.
+    // Devuelve false si la conexión se cortó.
+    bool enviarOrden(const string& orden, bool& ok, string& respuesta) {
+        if (!escribir(orden + "\n")) return false;
+        string cabecera;
+        if (!leerLinea(cabecera)) return false;
+        if (cabecera.compare(0, 3, "OK ") == 0) {
+            ok = true;
+            return leerBytes(stoul(cabecera.substr(3)), respuesta);
+        }
+        ok = false;
+        respuesta = cabecera.compare(0, 4, "ERR ") == 0 ? cabecera.substr(4) : cabecera;
+        return true;
+    }
+};
+
+bool direccionUnix(const string& ruta, sockaddr_un& direccion) {
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    if (ruta.size() >= sizeof(direccion.sun_path)) return false;
+    strcpy(direccion.sun_path, ruta.c_str());
+    return true;
+}
+
+// Crea el socket de escucha (borra un socket viejo en la misma ruta).
+// Devuelve -1 si falla.
+int escucharSocketUnix(const string& ruta, int pendientes) {
+    sockaddr_un direccion;
+    if (!direccionUnix(ruta, direccion)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) return -1;
+    unlink(ruta.c_str());
+    if (bind(fd, (sockaddr*)&direccion, sizeof(direccion)) == -1 || listen(fd, pendientes) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Conecta con el servidor. Devuelve -1 si falla.
+int conectarSocketUnix(const string& ruta) {
+    sockaddr_un direccion;
+    if (!direccionUnix(ruta, direccion)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) return -1;
+    if (connect(fd, (sockaddr*)&direccion, sizeof(direccion)) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+#endif // SOCKETUNIX_H
@@ -33,20 +33,20 @@ public:
     Venta() : cantidad(0), precioUnitario(0.0), montoTotal(0.0) {}
 
     // Nueva función mostrar()
-    void mostrar() const {
-        cout << "==================" << endl;
-        cout << "Id de la venta : " << idVenta << endl;
-        cout << "Fecha : " << fecha << endl;
-        cout << "Pais : " << pais << endl;
-        cout << "Ciudad a la que llega : " << ciudad << endl;
-        cout << "Cliente : " << cliente << endl;
-        cout << "Producto a despachar : " << producto << endl;
-        cout << "Categoria del producto : " << categoria << endl;
-        cout << "Cantidad: " << cantidad << endl;
-        cout << "Precio unitario: " << precioUnitario << endl;
-        cout << "Monto total: " << montoTotal << endl;
-        cout << "Medio de envio: " << medioEnvio << endl;
-        cout << "Estado del envio: " << estadoEnvio << endl;
+    void mostrar(ostream& salida = cout) const {
+        salida << "==================\n";
+        salida << "Id de la venta : " << idVenta << "\n";
+        salida << "Fecha : " << fecha << "\n";
+        salida << "Pais : " << pais << "\n";
+        salida << "Ciudad a la que llega : " << ciudad << "\n";
+        salida << "Cliente : " << cliente << "\n";
+        salida << "Producto a despachar : " << producto << "\n";
+        salida << "Categoria del producto : " << categoria << "\n";
+        salida << "Cantidad: " << cantidad << "\n";
+        salida << "Precio unitario: " << precioUnitario << "\n";
+        salida << "Monto total: " << montoTotal << "\n";
+        salida << "Medio de envio: " << medioEnvio << "\n";
+        salida << "Estado del envio: " << estadoEnvio << "\n";
     }
 };
 
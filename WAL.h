@@ -0,0 +1,428 @@
+#ifndef WAL_H
+#define WAL_H
+
+// Registro de escritura anticipada (WAL) para altas, bajas y modificaciones.
+//
+// Cada cambio aplicado se agrega como un registro binario al final del
+// archivo. Un hilo escritor vuelca los registros acumulados y hace fdatasync
+// cada 'loteMs' milisegundos o cuando se juntan 'loteRegistros' registros
+// (group commit), de modo que el throughput no queda atado a la latencia de
+// fsync. Quien necesite confirmar un cambio (el servidor antes de responder)
+// llama a esperarDurable().
+//
+// Formato del archivo:
+//   encabezado: "TPWAL002" | tamaño de la base (u64) | CRC32 de la base (u32)
+//   registros:  largo (u32) | CRC32 del contenido (u32) | contenido
+//   contenido:  tipo (u8); el alta sigue con la venta completa, la baja con
+//               la posición (u32) y el ID, y la modificación con la
+//               posición y la venta nueva. Los textos van como largo (u32)
+//               + bytes
+//
+// Bajas y modificaciones se reproducen sobre la posición registrada (los IDs
+// no son únicos); el ID guardado sólo se usa para verificar que la fila en
+// esa posición sea la esperada.
+//
+// El encabezado identifica el CSV base sobre el que se aplican los registros.
+// Al arrancar se carga la base y se reproducen los registros si el WAL le
+// corresponde; si la base cambió (por ejemplo, un checkpoint que llegó a
+// reemplazarla pero no a reiniciar el log) el WAL viejo se descarta. Un
+// registro cortado o con CRC inválido al final (caída a mitad de escritura)
+// se trunca. Un registro entero y con CRC válido que no se puede aplicar
+// (posición fuera de rango o ID distinto) indica que el log y la base no
+// coinciden: no se arranca y el WAL queda como estaba.
+//
+// checkpoint() escribe la lista actual como nueva base y reinicia el log:
+// base.tmp y wal.tmp se escriben y sincronizan completos y recién después se
+// renombran sobre los archivos reales.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "Venta.h"
+#include "Lista.h"
+#include "Gestion.h"
+#include "CargaCSV.h"
+#include "Metricas.h"
+#include "RegistroBinario.h" // Ventas y textos en registros binarios
+
+using namespace std;
+
+enum TipoRegistroWAL : uint8_t {
+    WAL_ALTA = 1,
+    WAL_BAJA = 2,
+    WAL_MODIFICACION = 3,
+};
+
+const char MAGIA_WAL[8] = {'T', 'P', 'W', 'A', 'L', '0', '0', '2'};
+const size_t TAMANIO_ENCABEZADO_WAL = 8 + 8 + 4;
+
+// CRC-32 (polinomio 0xEDB88320), por tabla
+uint32_t crc32WAL(const void* datos, size_t n, uint32_t crc = 0) {
+    static uint32_t tabla[256];
+    static bool inicializada = [] {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            tabla[i] = c;
+        }
+        return true;
+    }();
+    (void)inicializada;
+    const unsigned char* p = static_cast<const unsigned char*>(datos);
+    crc = ~crc;
+    for (size_t i = 0; i < n; ++i) crc = tabla[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// Tamaño y CRC32 de un archivo, para reconocer la base de un WAL
+bool huellaArchivo(const string& nombre, uint64_t& tamanio, uint32_t& crc) {
+    int fd = open(nombre.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+    vector<char> bloque(1 << 20);
+    tamanio = 0;
+    crc = 0;
+    ssize_t leidos;
+    while ((leidos = read(fd, bloque.data(), bloque.size())) > 0) {
+        crc = crc32WAL(bloque.data(), leidos, crc);
+        tamanio += leidos;
+    }
+    close(fd);
+    return leidos == 0;
+}
+
+bool sincronizarArchivo(const string& nombre) {
+    int fd = open(nombre.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+
+// Directorio que contiene a 'nombre' (para sincronizar los renombres)
+string directorioDe(const string& nombre) {
+    size_t barra = nombre.find_last_of('/');
+    if (barra == string::npos) return ".";
+    if (barra == 0) return "/";
+    return nombre.substr(0, barra);
+}
+
+class RegistroWAL : public ObservadorGestion {
+private:
+    string archivoWAL;
+    string archivoBase;
+    int loteMs;
+    long long loteRegistros;
+    int fd = -1;
+
+    mutex mtx;
+    condition_variable hayPendientes;
+    condition_variable hayDurables;
+    string buffer;                // registros agregados y todavía no escritos
+    long long agregados = 0;      // registros agregados desde que se abrió
+    long long escritos = 0;       // registros ya escritos y sincronizados
+    long long pendientesLote = 0;
+    bool volcando = false;        // hay una escritura en curso fuera del lock
+    bool detener = false;
+    bool fallo = false;
+    thread escritor;
+
+    void agregarRegistro(TipoRegistroWAL tipo, const string& cuerpo) {
+        string contenido;
+        contenido.reserve(cuerpo.size() + 1);
+        contenido += static_cast<char>(tipo);
+        contenido += cuerpo;
+        lock_guard<mutex> lock(mtx);
+        agregarU32(buffer, (uint32_t)contenido.size());
+        agregarU32(buffer, crc32WAL(contenido.data(), contenido.size()));
+        buffer += contenido;
+        agregados++;
+        if (++pendientesLote >= loteRegistros) hayPendientes.notify_one();
+    }
+
+    // Escribe y sincroniza lo acumulado. Se llama con 'mtx' tomado; lo suelta
+    // mientras dura la E/S para que se puedan seguir agregando registros.
+    // Al volver no queda ninguna escritura en curso.
+    void volcar(unique_lock<mutex>& lock) {
+        hayDurables.wait(lock, [this] { return !volcando; });
+        if (buffer.empty()) return;
+        string datos;
+        datos.swap(buffer);
+        long long hasta = agregados;
+        pendientesLote = 0;
+        volcando = true;
+        lock.unlock();
+        bool ok;
+        {
+            // Corre en el hilo escritor (o dentro de wal/checkpoint): no se
+            // suma al tiempo de gestión
+            TemporizadorFase temporizador("wal/fsync", "wal");
+            ok = escribirTodoFd(fd, datos.data(), datos.size()) && fdatasync(fd) == 0;
+        }
+        lock.lock();
+        if (!ok && !fallo) {
+            fallo = true;
+            cerr << "Error: no se pudo escribir el WAL " << archivoWAL << ": " << strerror(errno) << endl;
+        }
+        escritos = hasta;
+        volcando = false;
+        hayDurables.notify_all();
+    }
+
+    void cicloEscritor() {
+        unique_lock<mutex> lock(mtx);
+        while (true) {
+            hayPendientes.wait_for(lock, chrono::milliseconds(loteMs),
+                                   [this] { return detener || pendientesLote >= loteRegistros; });
+            volcar(lock);
+            if (detener && buffer.empty()) return;
+        }
+    }
+
+    // Crea un WAL vacío (sólo encabezado) para la base indicada y lo sincroniza
+    bool crearArchivoWAL(const string& nombre, const string& base, string& error) {
+        uint64_t tamanio;
+        uint32_t crc;
+        if (!huellaArchivo(base, tamanio, crc)) {
+            error = "no se pudo leer la base " + base;
+            return false;
+        }
+        string encabezado(MAGIA_WAL, sizeof(MAGIA_WAL));
+        encabezado.append(reinterpret_cast<const char*>(&tamanio), sizeof(tamanio));
+        agregarU32(encabezado, crc);
+        int nuevo = open(nombre.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (nuevo == -1) {
+            error = "no se pudo crear " + nombre + ": " + strerror(errno);
+            return false;
+        }
+        bool ok = escribirTodoFd(nuevo, encabezado.data(), encabezado.size()) && fsync(nuevo) == 0;
+        close(nuevo);
+        if (!ok) error = "no se pudo escribir " + nombre;
+        return ok;
+    }
+
+    // Aplica un registro sobre la lista. Devuelve false si el contenido no es
+    // válido o la fila registrada no está en la posición indicada.
+    static bool aplicarRegistro(const string& contenido, Lista<Venta>& listaVentas) {
+        LectorRegistroWAL lector(contenido);
+        uint8_t tipo = lector.leer<uint8_t>();
+        if (tipo == WAL_ALTA) {
+            Venta v = lector.leerVenta();
+            if (!lector.ok || !lector.alFinal()) return false;
+            listaVentas.insertarUltimo(v);
+            return true;
+        }
+        if (tipo == WAL_BAJA || tipo == WAL_MODIFICACION) {
+            uint32_t posicion = lector.leer<uint32_t>();
+            Venta v;
+            if (tipo == WAL_BAJA) v.idVenta = lector.leerTexto();
+            else v = lector.leerVenta();
+            if (!lector.ok || !lector.alFinal()) return false;
+            if (posicion >= static_cast<uint32_t>(listaVentas.getTamanio()) ||
+                listaVentas.getDato(posicion).idVenta != v.idVenta) {
+                return false;
+            }
+            if (tipo == WAL_BAJA) listaVentas.remover(posicion);
+            else listaVentas.reemplazar(posicion, v);
+            return true;
+        }
+        return false;
+    }
+
+    // Reproduce el WAL existente sobre la lista. Devuelve la cantidad de
+    // registros aplicados, o -1 si el archivo no corresponde a la base (con
+    // 'error' cargado si además no se puede arrancar).
+    long long reproducir(Lista<Venta>& listaVentas, string& error) {
+        TemporizadorFase temporizador("wal/reproducir", "carga");
+        int lectura = open(archivoWAL.c_str(), O_RDONLY);
+        if (lectura == -1) return -1;
+        string contenidoArchivo;
+        vector<char> bloque(1 << 20);
+        ssize_t leidos;
+        while ((leidos = read(lectura, bloque.data(), bloque.size())) > 0) {
+            contenidoArchivo.append(bloque.data(), leidos);
+        }
+        close(lectura);
+
+        uint64_t tamanioBase;
+        uint32_t crcBase;
+        if (!huellaArchivo(archivoBase, tamanioBase, crcBase)) {
+            error = "no se pudo leer la base " + archivoBase;
+            return -1;
+        }
+        if (contenidoArchivo.size() < TAMANIO_ENCABEZADO_WAL ||
+            memcmp(contenidoArchivo.data(), MAGIA_WAL, sizeof(MAGIA_WAL)) != 0) {
+            return -1;
+        }
+        uint64_t tamanioEsperado;
+        uint32_t crcEsperado;
+        memcpy(&tamanioEsperado, contenidoArchivo.data() + 8, sizeof(tamanioEsperado));
+        memcpy(&crcEsperado, contenidoArchivo.data() + 16, sizeof(crcEsperado));
+        if (tamanioEsperado != tamanioBase || crcEsperado != crcBase) {
+            return -1;
+        }
+
+        size_t pos = TAMANIO_ENCABEZADO_WAL;
+        long long aplicados = 0;
+        while (pos + 8 <= contenidoArchivo.size()) {
+            uint32_t largo, crc;
+            memcpy(&largo, contenidoArchivo.data() + pos, 4);
+            memcpy(&crc, contenidoArchivo.data() + pos + 4, 4);
+            if (pos + 8 + largo > contenidoArchivo.size()) break;
+            string contenido = contenidoArchivo.substr(pos + 8, largo);
+            if (crc32WAL(contenido.data(), contenido.size()) != crc) break;
+            if (!aplicarRegistro(contenido, listaVentas)) {
+                // El registro llegó entero: el log no corresponde a la base.
+                // No se toca el archivo, para no perder los registros siguientes.
+                error = "el registro " + to_string(aplicados + 1) + " de " + archivoWAL +
+                        " (byte " + to_string(pos) + ") no se puede aplicar sobre " + archivoBase +
+                        "; el WAL y la base no coinciden";
+                return -1;
+            }
+            pos += 8 + largo;
+            aplicados++;
+        }
+        if (pos < contenidoArchivo.size()) {
+            cerr << "Aviso: se descartan " << contenidoArchivo.size() - pos
+                 << " bytes incompletos o corruptos al final del WAL." << endl;
+            if (truncate(archivoWAL.c_str(), pos) != 0) {
+                error = "no se pudo truncar " + archivoWAL;
+                return -1;
+            }
+        }
+        temporizador.setFilas(aplicados);
+        return aplicados;
+    }
+
+public:
+    RegistroWAL(const string& archivo, int ms, long long registros)
+        : archivoWAL(archivo), loteMs(ms < 1 ? 1 : ms), loteRegistros(registros < 1 ? 1 : registros) {}
+
+    ~RegistroWAL() {
+        cerrar();
+    }
+
+    // Reproduce el WAL sobre la lista recién cargada desde 'base' y lo deja
+    // abierto para agregar. Si no existe o es de otra base, lo crea de cero.
+    // 'reproducidos' queda con la cantidad de registros aplicados.
+    bool abrir(const string& base, Lista<Venta>& listaVentas, long long& reproducidos, string& error) {
+        archivoBase = base;
+        reproducidos = 0;
+        struct stat st;
+        bool existe = stat(archivoWAL.c_str(), &st) == 0;
+        if (existe) {
+            reproducidos = reproducir(listaVentas, error);
+            if (!error.empty()) return false;
+            if (reproducidos == -1) {
+                cerr << "Aviso: " << archivoWAL << " no corresponde a " << base << "; se descarta." << endl;
+                reproducidos = 0;
+                existe = false;
+            }
+        }
+        if (!existe && !crearArchivoWAL(archivoWAL, archivoBase, error)) {
+            return false;
+        }
+        fd = open(archivoWAL.c_str(), O_WRONLY | O_APPEND);
+        if (fd == -1) {
+            error = "no se pudo abrir " + archivoWAL + ": " + strerror(errno);
+            return false;
+        }
+        escritor = thread(&RegistroWAL::cicloEscritor, this);
+        return true;
+    }
+
+    void ventaAgregada(const Venta& venta) override {
+        string cuerpo;
+        agregarVentaWAL(cuerpo, venta);
+        agregarRegistro(WAL_ALTA, cuerpo);
+    }
+
+    void ventaEliminada(const string& idVenta, int posicion) override {
+        string cuerpo;
+        agregarU32(cuerpo, posicion);
+        agregarTexto(cuerpo, idVenta);
+        agregarRegistro(WAL_BAJA, cuerpo);
+    }
+
+    void ventaModificada(const Venta& venta, int posicion) override {
+        string cuerpo;
+        agregarU32(cuerpo, posicion);
+        agregarVentaWAL(cuerpo, venta);
+        agregarRegistro(WAL_MODIFICACION, cuerpo);
+    }
+
+    // Espera a que todo lo agregado hasta ahora esté en disco. Devuelve false
+    // si hubo un error de escritura.
+    bool esperarDurable() override {
+        unique_lock<mutex> lock(mtx);
+        long long objetivo = agregados;
+        hayDurables.wait(lock, [this, objetivo] { return escritos >= objetivo || fd == -1; });
+        return !fallo;
+    }
+
+    // Escribe la lista como nueva base y deja el WAL vacío apuntando a ella.
+    // El llamador debe impedir que se agreguen cambios mientras tanto.
+    bool checkpoint(const Lista<Venta>& listaVentas, string& error) override {
+        TemporizadorFase temporizador("wal/checkpoint", "gestion");
+        unique_lock<mutex> lock(mtx);
+        volcar(lock); // lo pendiente pertenece al WAL actual
+
+        string baseTemporal = archivoBase + ".tmp";
+        string walTemporal = archivoWAL + ".tmp";
+        if (!guardarVentasCSV(baseTemporal, listaVentas) || !sincronizarArchivo(baseTemporal)) {
+            error = "no se pudo escribir " + baseTemporal;
+            return false;
+        }
+        if (!crearArchivoWAL(walTemporal, baseTemporal, error)) {
+            return false;
+        }
+        // Si se cae entre los dos rename, el WAL viejo no coincide con la base
+        // nueva y se descarta al arrancar: la base nueva ya lo incluye.
+        if (rename(baseTemporal.c_str(), archivoBase.c_str()) != 0 ||
+            rename(walTemporal.c_str(), archivoWAL.c_str()) != 0) {
+            error = string("no se pudo reemplazar la base o el WAL: ") + strerror(errno);
+            return false;
+        }
+        sincronizarArchivo(directorioDe(archivoWAL));
+        if (directorioDe(archivoBase) != directorioDe(archivoWAL)) {
+            sincronizarArchivo(directorioDe(archivoBase));
+        }
+
+        close(fd);
+        fd = open(archivoWAL.c_str(), O_WRONLY | O_APPEND);
+        if (fd == -1) {
+            error = "no se pudo reabrir " + archivoWAL + ": " + strerror(errno);
+            fallo = true;
+            hayDurables.notify_all();
+            return false;
+        }
+        temporizador.setFilas(listaVentas.getTamanio());
+        return true;
+    }
+
+    // Vuelca lo pendiente y detiene el hilo escritor
+    void cerrar() {
+        {
+            lock_guard<mutex> lock(mtx);
+            if (fd == -1 && !escritor.joinable()) return;
+            detener = true;
+        }
+        hayPendientes.notify_one();
+        if (escritor.joinable()) escritor.join();
+        lock_guard<mutex> lock(mtx);
+        if (fd != -1) close(fd);
+        fd = -1;
+        hayDurables.notify_all();
+    }
+};
+
+#endif // WAL_H
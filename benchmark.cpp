@@ -0,0 +1,891 @@
+// Benchmark de las estructuras (Lista, HashMap, HashMapList, quickSort),
+// de la carga del CSV y de cada análisis/consulta.
+//
+// Compilar: g++ -std=c++17 -O2 -o benchmark benchmark.cpp
+// Uso:      ./benchmark [--filas 10K,1M,10M] [--repeticiones 5]
+//                       [--calentamiento 1] [--semilla 42] [--casos prefijo]
+//                       [--max-ops 2e9] [--etiqueta commit] [--salida bench.json]
+//                       [--filas-columnas 1e8]
+//
+// Cada caso se mide con steady_clock: primero se ejecutan las iteraciones de
+// calentamiento (descartadas) y luego las repeticiones, de las que se informa
+// mínimo, media, mediana y p95. El resultado se emite como JSON, un caso por
+// línea, para poder comparar corridas de distintos commits con diff.
+//
+// Los casos que recorren la Lista por índice (getDato(i)) son cuadráticos;
+// si su costo estimado supera --max-ops se marcan como omitidos en lugar de
+// correrlos (en el JSON con "omitido" y el costo estimado). Al final se
+// listan por stderr los casos omitidos; con los tamaños por defecto (10K, 1M
+// y 10M filas) quedan fuera los cuadráticos de 1M y 10M.
+//
+// Los casos columnas/* corren los kernels de KernelsColumnas.h (escalares y
+// AVX2) sobre columnas sintéticas de --filas-columnas filas, aparte de
+// --filas, e informan también GB/s leídos. --filas acepta los sufijos K, M y B
+// como el generador.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+
+using namespace std;
+
+#include "Venta.h"
+#include "Lista.h"
+#include "HashMap.h"
+#include "HashMapList.h"
+#include "quickSort.h"
+#include "Analisis.h"
+#include "AnalisisAproximado.h"
+#include "Consultas.h"
+#include "CargaCSV.h"
+#include "SalidaReporte.h"
+#include "GroupBy.h"
+#include "AgregacionDensa.h"
+#include "IndiceVentas.h"
+#include "KernelsColumnas.h"
+#include "GeneradorVentas.h" // parsearCantidadFilas
+
+// streambuf que descarta todo lo que se escribe (para silenciar cout)
+class BufferNulo : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+struct OpcionesBenchmark {
+    vector<int> filas = {10000, 1000000, 10000000};
+    int repeticiones = 5;
+    int calentamiento = 1;
+    unsigned int semilla = 42;
+    string casos = "";
+    double maxOps = 2e9;
+    string etiqueta = "";
+    string salida = "";
+    double filasColumnas = 1e8;
+};
+
+struct ResultadoCaso {
+    string caso;
+    int filas;
+    bool omitido;
+    vector<double> muestrasNs;
+    double bytes; // bytes leídos por ejecución (0: no se informa GB/s)
+    double ops;   // costo estimado (se compara con --max-ops)
+};
+
+// --- Datos sintéticos ---
+
+struct PaisCiudades {
+    const char* pais;
+    const char* ciudades[3];
+};
+
+const PaisCiudades PAISES_SINTETICOS[] = {
+    {"Argentina", {"Buenos Aires", "Cordoba", "Rosario"}},
+    {"Bolivia", {"Cochabamba", "La Paz", "Santa Cruz"}},
+    {"Brasil", {"Brasilia", "Rio de Janeiro", "Sao Paulo"}},
+    {"Chile", {"Concepcion", "Santiago", "Valparaiso"}},
+    {"Colombia", {"Bogota", "Cali", "Medellin"}},
+    {"Ecuador", {"Cuenca", "Guayaquil", "Quito"}},
+    {"Paraguay", {"Asuncion", "Ciudad del Este", "Encarnacion"}},
+    {"Peru", {"Arequipa", "Cusco", "Lima"}},
+    {"Uruguay", {"Montevideo", "Paysandu", "Salto"}},
+    {"Venezuela", {"Caracas", "Maracaibo", "Valencia"}},
+};
+
+const char* PRODUCTOS_SINTETICOS[][2] = {
+    {"Auriculares", "Accesorios"}, {"Camara", "Electronica"}, {"Celular", "Electronica"},
+    {"Escritorio", "Muebles"}, {"Impresora", "Oficina"}, {"Laptop", "Electronica"},
+    {"Monitor", "Electronica"}, {"Silla ergonomica", "Muebles"}, {"Tablet", "Electronica"},
+    {"Teclado", "Accesorios"},
+};
+
+const char* MEDIOS_SINTETICOS[] = {"Aereo", "Maritimo", "Terrestre"};
+const char* ESTADOS_SINTETICOS[] = {"Cancelado", "En transito", "Entregado", "Pendiente"};
+
+Venta ventaSintetica(mt19937& rng, int id) {
+    const PaisCiudades& pc = PAISES_SINTETICOS[rng() % 10];
+    int prod = rng() % 10;
+    int cantidad = 1 + rng() % 5;
+    float precio = (2000 + rng() % 118000) / 100.0f;
+    int dia = 1 + rng() % 28, mes = 1 + rng() % 12, anio = 2024 + rng() % 2;
+    string fecha = (dia < 10 ? "0" : "") + to_string(dia) + "/" + (mes < 10 ? "0" : "") + to_string(mes) + "/" + to_string(anio);
+    return Venta(to_string(id), fecha, pc.pais, pc.ciudades[rng() % 3], "Cliente " + to_string(rng() % 50),
+                 PRODUCTOS_SINTETICOS[prod][0], PRODUCTOS_SINTETICOS[prod][1], cantidad, precio,
+                 cantidad * precio, MEDIOS_SINTETICOS[rng() % 3], ESTADOS_SINTETICOS[rng() % 4]);
+}
+
+// Construye la lista insertando al principio en orden inverso
+void construirListaSintetica(Lista<Venta>& lista, int n, unsigned int semilla) {
+    mt19937 rng(semilla);
+    vector<Venta> ventas;
+    ventas.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        ventas.push_back(ventaSintetica(rng, i + 1));
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        lista.insertarPrimero(ventas[i]);
+    }
+}
+
+void escribirCSVSintetico(const string& nombreArchivo, int n, unsigned int semilla) {
+    mt19937 rng(semilla);
+    ofstream archivo(nombreArchivo);
+    archivo << "ID_Venta,Fecha,Pais,Ciudad,Cliente,Producto,Categoria,Cantidad,Precio_Unitario,Monto_Total,Medio_Envio,Estado_Envio\r\n";
+    for (int i = 0; i < n; ++i) {
+        Venta v = ventaSintetica(rng, i + 1);
+        archivo << v.idVenta << ',' << v.fecha << ',' << v.pais << ',' << v.ciudad << ',' << v.cliente << ','
+                << v.producto << ',' << v.categoria << ',' << v.cantidad << ',' << fixed << setprecision(2)
+                << v.precioUnitario << ',' << v.montoTotal << ',' << v.medioEnvio << ',' << v.estadoEnvio << "\r\n";
+    }
+}
+
+// --- Medición ---
+
+double percentil(vector<double> muestras, double p) {
+    if (muestras.empty()) return 0.0;
+    sort(muestras.begin(), muestras.end());
+    size_t rango = (size_t)ceil(p * muestras.size());
+    if (rango == 0) rango = 1;
+    return muestras[rango - 1];
+}
+
+double mediana(vector<double> muestras) {
+    if (muestras.empty()) return 0.0;
+    sort(muestras.begin(), muestras.end());
+    size_t m = muestras.size() / 2;
+    if (muestras.size() % 2 == 0) return (muestras[m - 1] + muestras[m]) / 2.0;
+    return muestras[m];
+}
+
+class Benchmark {
+private:
+    OpcionesBenchmark opciones;
+    vector<ResultadoCaso> resultados;
+    BufferNulo bufferNulo;
+
+public:
+    explicit Benchmark(const OpcionesBenchmark& o) : opciones(o) {}
+
+    // Mide un caso: preparar() no se cronometra, ejecutar() sí.
+    // ops es el costo estimado en operaciones elementales; si se pasa bytes
+    // se informa también el ancho de banda con la mediana.
+    void medir(const string& caso, int filas, double ops,
+               function<void()> preparar, function<void()> ejecutar, double bytes = 0) {
+        if (!opciones.casos.empty() && caso.compare(0, opciones.casos.size(), opciones.casos) != 0) {
+            return;
+        }
+        ResultadoCaso r{caso, filas, false, {}, bytes, ops};
+        if (ops > opciones.maxOps) {
+            r.omitido = true;
+            resultados.push_back(r);
+            cerr << caso << " [" << filas << "] omitido (costo estimado " << ops << " ops)" << endl;
+            return;
+        }
+
+        streambuf* coutOriginal = cout.rdbuf(&bufferNulo);
+        for (int i = 0; i < opciones.calentamiento + opciones.repeticiones; ++i) {
+            preparar();
+            auto inicio = chrono::steady_clock::now();
+            ejecutar();
+            auto fin = chrono::steady_clock::now();
+            if (i >= opciones.calentamiento) {
+                r.muestrasNs.push_back(chrono::duration<double, nano>(fin - inicio).count());
+            }
+        }
+        cout.rdbuf(coutOriginal);
+
+        cerr << caso << " [" << filas << "] mediana " << mediana(r.muestrasNs) / 1e6 << " ms";
+        if (bytes > 0) cerr << " (" << bytes / mediana(r.muestrasNs) << " GB/s)";
+        cerr << endl;
+        resultados.push_back(r);
+    }
+
+    void escribirJSON(ostream& out) {
+        out << "{\n";
+        out << "  \"etiqueta\": \"" << opciones.etiqueta << "\",\n";
+        out << "  \"semilla\": " << opciones.semilla << ",\n";
+        out << "  \"repeticiones\": " << opciones.repeticiones << ",\n";
+        out << "  \"calentamiento\": " << opciones.calentamiento << ",\n";
+        out << "  \"resultados\": [\n";
+        for (size_t i = 0; i < resultados.size(); ++i) {
+            const ResultadoCaso& r = resultados[i];
+            out << "    {\"caso\": \"" << r.caso << "\", \"filas\": " << r.filas;
+            if (r.omitido) {
+                out << fixed << setprecision(0) << ", \"omitido\": true, \"costo_estimado\": " << r.ops << "}";
+            } else {
+                double suma = 0.0;
+                for (double m : r.muestrasNs) suma += m;
+                out << fixed << setprecision(0)
+                    << ", \"mediana_ns\": " << mediana(r.muestrasNs)
+                    << ", \"p95_ns\": " << percentil(r.muestrasNs, 0.95)
+                    << ", \"min_ns\": " << *min_element(r.muestrasNs.begin(), r.muestrasNs.end())
+                    << ", \"media_ns\": " << suma / r.muestrasNs.size()
+                    << ", \"muestras\": " << r.muestrasNs.size();
+                if (r.bytes > 0) out << setprecision(2) << ", \"gb_s\": " << r.bytes / mediana(r.muestrasNs);
+                out << "}";
+            }
+            out << (i + 1 < resultados.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+
+    // Lista los casos que no se corrieron por superar --max-ops
+    void resumirOmitidos(ostream& out) {
+        int omitidos = 0;
+        for (const ResultadoCaso& r : resultados) omitidos += r.omitido ? 1 : 0;
+        if (omitidos == 0) return;
+        out << omitidos << " casos omitidos por superar --max-ops " << opciones.maxOps
+            << " (subir --max-ops para correrlos):" << endl;
+        for (const ResultadoCaso& r : resultados) {
+            if (r.omitido) out << "  " << r.caso << " [" << r.filas << "] costo estimado " << r.ops << " ops" << endl;
+        }
+    }
+};
+
+// --- Casos ---
+
+void casosLista(Benchmark& b, int n, unsigned int) {
+    double nn = (double)n * n;
+    Lista<int>* lista = nullptr;
+
+    b.medir("lista/insertarUltimo", n, n,
+            [&]() { delete lista; lista = new Lista<int>(); },
+            [&]() { for (int i = 0; i < n; ++i) lista->insertarUltimo(i); });
+
+    Lista<int> base;
+    for (int i = n - 1; i >= 0; --i) base.insertarPrimero(i);
+    volatile long long sumidero = 0;
+
+    b.medir("lista/recorrido_getDato", n, nn / 2, []() {},
+            [&]() {
+                long long s = 0;
+                for (int i = 0; i < base.getTamanio(); ++i) s += base.getDato(i);
+                sumidero = s;
+            });
+
+    b.medir("lista/recorrido_nodos", n, n, []() {},
+            [&]() {
+                long long s = 0;
+                for (Nodo<int>* aux = base.getInicio(); aux != nullptr; aux = aux->getSiguiente()) s += aux->getDato();
+                sumidero = s;
+            });
+
+    // Remueve k elementos de la mitad de la lista
+    int k = min(n, 1000);
+    b.medir("lista/remover", n, (double)k * n,
+            [&]() {
+                delete lista;
+                lista = new Lista<int>();
+                for (int i = n - 1; i >= 0; --i) lista->insertarPrimero(i);
+            },
+            [&]() { for (int i = 0; i < k; ++i) lista->remover(lista->getTamanio() / 2); });
+
+    delete lista;
+}
+
+void casosHashMap(Benchmark& b, int n, unsigned int semilla) {
+    // HashMap no maneja colisiones: se usan claves 0..n-1 con tabla de tamaño n
+    vector<int> claves(n);
+    for (int i = 0; i < n; ++i) claves[i] = i;
+    shuffle(claves.begin(), claves.end(), mt19937(semilla));
+    HashMap<int, int>* mapa = nullptr;
+    volatile long long sumidero = 0;
+
+    auto llenar = [&]() {
+        delete mapa;
+        mapa = new HashMap<int, int>(n);
+        for (int c : claves) mapa->put(c, c);
+    };
+
+    b.medir("hashmap/put", n, n, [&]() { delete mapa; mapa = new HashMap<int, int>(n); },
+            [&]() { for (int c : claves) mapa->put(c, c); });
+    llenar();
+    b.medir("hashmap/get", n, n, []() {},
+            [&]() { long long s = 0; for (int c : claves) s += mapa->get(c); sumidero = s; });
+    b.medir("hashmap/recorrido", n, n, []() {},
+            [&]() { long long s = 0; for (int i = 0; i < n; ++i) s += mapa->get(i); sumidero = s; });
+    b.medir("hashmap/remove", n, n, llenar,
+            [&]() { for (int c : claves) mapa->remove(c); });
+    delete mapa;
+}
+
+void casosHashMapList(Benchmark& b, int n, unsigned int semilla) {
+    vector<string> claves(n);
+    for (int i = 0; i < n; ++i) claves[i] = "clave" + to_string(i);
+    shuffle(claves.begin(), claves.end(), mt19937(semilla));
+    HashMapList<string, int>* mapa = nullptr;
+    volatile long long sumidero = 0;
+
+    auto llenar = [&]() {
+        delete mapa;
+        mapa = new HashMapList<string, int>(n, stringHash);
+        for (int i = 0; i < n; ++i) mapa->put(claves[i], i);
+    };
+
+    b.medir("hashmaplist/put", n, n, [&]() { delete mapa; mapa = new HashMapList<string, int>(n, stringHash); },
+            [&]() { for (int i = 0; i < n; ++i) mapa->put(claves[i], i); });
+    llenar();
+    b.medir("hashmaplist/get", n, n, []() {},
+            [&]() { long long s = 0; for (const string& c : claves) s += mapa->get(c); sumidero = s; });
+    b.medir("hashmaplist/getAllEntries", n, n, []() {},
+            [&]() { sumidero = mapa->getAllEntries().size(); });
+    b.medir("hashmaplist/remove", n, n, llenar,
+            [&]() { for (const string& c : claves) mapa->remove(c); });
+    delete mapa;
+}
+
+void casosQuickSort(Benchmark& b, int n, unsigned int semilla) {
+    mt19937 rng(semilla);
+    vector<CiudadMonto> aleatorio(n), ordenado, inverso, pocosValores(n);
+    for (int i = 0; i < n; ++i) {
+        aleatorio[i] = CiudadMonto("c" + to_string(i), (rng() % 10000000) / 100.0f);
+        pocosValores[i] = CiudadMonto("c" + to_string(i), (float)(rng() % 10));
+    }
+    ordenado = aleatorio;
+    sort(ordenado.begin(), ordenado.end(), compararCiudadesMonto);
+    inverso = ordenado;
+    reverse(inverso.begin(), inverso.end());
+
+    vector<CiudadMonto> trabajo;
+    double ops = n * log2((double)max(n, 2));
+    struct Distribucion { const char* nombre; const vector<CiudadMonto>* datos; };
+    Distribucion distribuciones[] = {
+        {"quicksort/aleatorio", &aleatorio}, {"quicksort/ordenado", &ordenado},
+        {"quicksort/inverso", &inverso}, {"quicksort/pocos_valores", &pocosValores},
+    };
+    for (const Distribucion& d : distribuciones) {
+        b.medir(d.nombre, n, ops, [&]() { trabajo = *d.datos; },
+                [&]() { quickSort(trabajo, 0, (int)trabajo.size() - 1, compararCiudadesMonto); });
+    }
+}
+
+void casosCargaCSV(Benchmark& b, int n, unsigned int semilla) {
+    string nombreArchivo = "bench_tmp_" + to_string(n) + ".csv";
+    double ops = n;
+    Lista<Venta>* lista = nullptr;
+    bool escrito = false;
+
+    b.medir("csv/cargarVentasCSV", n, ops,
+            [&]() {
+                if (!escrito) { escribirCSVSintetico(nombreArchivo, n, semilla); escrito = true; }
+                delete lista;
+                lista = new Lista<Venta>();
+            },
+            [&]() { cargarVentasCSV(nombreArchivo, *lista); });
+
+    // --approx: lee todo el archivo pero sólo parsea la muestra (Muestreo.h)
+    MuestraVentas* muestra = nullptr;
+    const pair<const char*, EstratificacionMuestra> muestreos[] = {
+        {"csv/cargarMuestraCSV_uniforme", MUESTRA_UNIFORME}, {"csv/cargarMuestraCSV_pais", MUESTRA_POR_PAIS}};
+    for (const auto& m : muestreos) {
+        b.medir(m.first, n, ops,
+                [&]() {
+                    delete muestra;
+                    muestra = new MuestraVentas(m.second, TAMANIO_MUESTRA);
+                },
+                [&]() { cargarMuestraCSV(nombreArchivo, *muestra); });
+    }
+
+    // --memoria: agrupa leyendo el archivo, con un presupuesto que alcanza y
+    // con uno que obliga a derramar particiones (AgregacionExterna.h)
+    const pair<const char*, size_t> presupuestos[] = {
+        {"csv/groupby_externo_en_memoria", (size_t)1 << 30},
+        {"csv/groupby_externo_particiones", RESERVA_BUFFERS_DISCO + 4 * 1024}};
+    long long grupos = 0;
+    for (const auto& p : presupuestos) {
+        b.medir(p.first, n, ops, []() {}, [&]() {
+            GroupByExterno<Claves<ColumnaPais, ColumnaCiudad>, Suma<ColumnaMonto>> ventasPorPaisCiudad(p.second, directorioTemporalPorDefecto());
+            recorrerVentasCSV(nombreArchivo, [&](const Venta& v) { ventasPorPaisCiudad.agregar(v); });
+            ventasPorPaisCiudad.terminar();
+            grupos += ventasPorPaisCiudad.getTamanio();
+        });
+    }
+    if (grupos < 0) cerr << grupos << endl;
+
+    delete muestra;
+    delete lista;
+    if (escrito) remove(nombreArchivo.c_str());
+}
+
+void casosAnalisis(Benchmark& b, int n, unsigned int semilla) {
+    // Los análisis agrupan con GroupBy en una pasada (analizarDiaMayorVentas
+    // lee las series por día del índice; los *Aproximado y
+    // analizarClientesDistintosPorPais arman los resúmenes de
+    // AnalisisAproximado.h), las consultas filtran por país con
+    // el índice de bitmaps o leen del cubo país x producto (la primera
+    // repetición construye el índice); listarVentasPorCiudad
+    // todavía usa getDato(i), que recorre la lista desde el inicio en cada
+    // iteración
+    double opsAnalisis = 20.0 * n;
+    double ops = 0.5 * n * n;
+    // La lista sólo se construye si al menos un caso va a correr
+    Lista<Venta>* lista = nullptr;
+    auto asegurarLista = [&]() {
+        if (lista == nullptr) {
+            lista = new Lista<Venta>();
+            construirListaSintetica(*lista, n, semilla);
+        }
+    };
+
+    // Los análisis y consultas escriben en un ostream que descarta todo
+    BufferNulo descarte;
+    ostream salidaNula(&descarte);
+
+    struct Analisis { const char* nombre; void (*funcion)(const Lista<Venta>&, ostream&); };
+    Analisis analisis[] = {
+        {"analisis/analizarTop5CiudadesPorPais", analizarTop5CiudadesPorPais},
+        {"analisis/analizarMontoTotalPorProductoPorPais", analizarMontoTotalPorProductoPorPais},
+        {"analisis/analizarPromedioVentasPorCategoriaPorPais", analizarPromedioVentasPorCategoriaPorPais},
+        {"analisis/analizarMedioEnvioMasUtilizadoPorPais", analizarMedioEnvioMasUtilizadoPorPais},
+        {"analisis/analizarMedioEnvioMasUtilizadoPorCategoria", analizarMedioEnvioMasUtilizadoPorCategoria},
+        {"analisis/analizarDiaMayorVentas", analizarDiaMayorVentas},
+        {"analisis/analizarProductoMasYMenosVendido", analizarProductoMasYMenosVendido},
+        {"analisis/analizarPercentilesMontos", analizarPercentilesMontos},
+        {"analisis/analizarTop5CiudadesPorPaisAproximado", analizarTop5CiudadesPorPaisAproximado},
+        {"analisis/analizarProductoMasYMenosVendidoAproximado", analizarProductoMasYMenosVendidoAproximado},
+        {"analisis/analizarClientesDistintosPorPais", analizarClientesDistintosPorPais},
+    };
+    for (const Analisis& a : analisis) {
+        b.medir(a.nombre, n, opsAnalisis, asegurarLista, [&]() { a.funcion(*lista, salidaNula); });
+    }
+
+    // Las consultas se llaman con sus parámetros, sin pasar por cin. La caché
+    // de consultas se apaga: cada repetición tiene que calcular de nuevo.
+    g_cacheConsultas.setHabilitada(false);
+    struct Consulta { const char* nombre; function<void(const Lista<Venta>&, ostream&)> funcion; double ops; };
+    Consulta consultas[] = {
+        {"consulta/listarVentasPorCiudad",
+         [](const Lista<Venta>& l, ostream& s) { listarVentasPorCiudad(l, "Lima", s); }, ops},
+        {"consulta/listarVentasPorRangoFechasPorPais",
+         [](const Lista<Venta>& l, ostream& s) { listarVentasPorRangoFechasPorPais(l, "01/01/2024", "31/03/2024", "Peru", s); }, opsAnalisis},
+        {"consulta/compararDosPaises",
+         [](const Lista<Venta>& l, ostream& s) { compararDosPaises(l, "Peru", "Chile", s); }, opsAnalisis},
+        {"consulta/compararDosProductosPorPais",
+         [](const Lista<Venta>& l, ostream& s) { compararDosProductosPorPais(l, "Laptop", "Tablet", s); }, opsAnalisis},
+        {"consulta/buscarProductosPorDebajoUmbralPorPais",
+         [](const Lista<Venta>& l, ostream& s) { buscarProductosPorDebajoUmbralPorPais(l, "Peru", 500, s); }, opsAnalisis},
+        {"consulta/buscarProductosPorEncimaUmbral",
+         [](const Lista<Venta>& l, ostream& s) { buscarProductosPorEncimaUmbral(l, 300, s); }, opsAnalisis},
+        {"consulta/totalesPorFechas",
+         [](const Lista<Venta>& l, ostream& s) { totalesPorFechas(l, "1/1/2024", "31/12/2024", "Peru", AGRUPAR_MES, s); }, opsAnalisis},
+    };
+    for (const Consulta& c : consultas) {
+        b.medir(c.nombre, n, c.ops, asegurarLista, [&]() { c.funcion(*lista, salidaNula); });
+    }
+    g_cacheConsultas.setHabilitada(true);
+
+    // Con la caché: el calentamiento calcula y las repeticiones aciertan
+    b.medir("consulta/compararDosPaises_cache", n, opsAnalisis, asegurarLista,
+            [&]() { compararDosPaises(*lista, "Peru", "Chile", salidaNula); });
+
+    delete lista;
+}
+
+// Agrupamiento de los análisis: HashMapList anidados con get/remove/put por
+// fila (como lo hacían los análisis antes de GroupBy) contra GroupBy. Las dos
+// versiones recorren los nodos, así que se compara sólo la estructura.
+void casosGroupBy(Benchmark& b, int n, unsigned int semilla) {
+    Lista<Venta>* lista = nullptr;
+    auto asegurarLista = [&]() {
+        if (lista == nullptr) {
+            lista = new Lista<Venta>();
+            construirListaSintetica(*lista, n, semilla);
+        }
+    };
+    long long grupos = 0; // para que el compilador no descarte el trabajo
+
+    b.medir("groupby/pais_ciudad_anidado", n, 20.0 * n, asegurarLista, [&]() {
+        HashMapList<string, HashMapList<string, float>*> ventasPorPaisCiudad(TAMANIO_HASH_PAISES, stringHash);
+        for (Nodo<Venta>* nodo = lista->getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+            const Venta& v = nodo->verDato();
+            HashMapList<string, float>* ventasPorCiudad = nullptr;
+            try {
+                ventasPorCiudad = ventasPorPaisCiudad.get(v.pais);
+            } catch (const runtime_error& e) {
+                ventasPorCiudad = new HashMapList<string, float>(TAMANIO_HASH_CIUDADES, stringHash);
+                ventasPorPaisCiudad.put(v.pais, ventasPorCiudad);
+            }
+            try {
+                float montoActual = ventasPorCiudad->get(v.ciudad);
+                ventasPorCiudad->remove(v.ciudad);
+                ventasPorCiudad->put(v.ciudad, montoActual + v.montoTotal);
+            } catch (const runtime_error& e) {
+                ventasPorCiudad->put(v.ciudad, v.montoTotal);
+            }
+        }
+        for (const auto& entrada : ventasPorPaisCiudad.getAllEntries()) {
+            grupos += entrada.second->getAllEntries().size();
+            delete entrada.second;
+        }
+    });
+
+    b.medir("groupby/pais_ciudad_groupby", n, 20.0 * n, asegurarLista, [&]() {
+        GroupBy<Claves<ColumnaPais, ColumnaCiudad>, Suma<ColumnaMonto>> ventasPorPaisCiudad;
+        ventasPorPaisCiudad.agregar(*lista);
+        grupos += ventasPorPaisCiudad.getTamanio();
+    });
+
+    b.medir("groupby/producto_anidado", n, 20.0 * n, asegurarLista, [&]() {
+        HashMapList<string, int> cantidadPorProducto(TAMANIO_HASH_CIUDADES * 2, stringHash);
+        for (Nodo<Venta>* nodo = lista->getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+            const Venta& v = nodo->verDato();
+            try {
+                int cantidadActual = cantidadPorProducto.get(v.producto);
+                cantidadPorProducto.remove(v.producto);
+                cantidadPorProducto.put(v.producto, cantidadActual + v.cantidad);
+            } catch (const runtime_error& e) {
+                cantidadPorProducto.put(v.producto, v.cantidad);
+            }
+        }
+        grupos += cantidadPorProducto.getAllEntries().size();
+    });
+
+    b.medir("groupby/producto_groupby", n, 20.0 * n, asegurarLista, [&]() {
+        GroupBy<Claves<ColumnaProducto>, Suma<ColumnaCantidad>> cantidadPorProducto;
+        cantidadPorProducto.agregar(*lista);
+        grupos += cantidadPorProducto.getTamanio();
+    });
+
+    // Varios agregados en una sola pasada sobre una clave compuesta
+    b.medir("groupby/pais_categoria_varios_agregados", n, 20.0 * n, asegurarLista, [&]() {
+        GroupBy<Claves<ColumnaPais, ColumnaCategoria>, Suma<ColumnaMonto>, Conteo, Promedio<ColumnaPrecioUnitario>,
+                Minimo<ColumnaMonto>, Maximo<ColumnaMonto>, ArgMax<ColumnaMonto, ColumnaCiudad>> resumen;
+        resumen.agregar(*lista);
+        grupos += resumen.getTamanio();
+    });
+
+    if (grupos < 0) cerr << grupos << endl;
+    delete lista;
+}
+
+// Claves de pocos valores (país x medio, país x categoría, fecha): GroupBy
+// con hashing contra GroupByDenso con diccionarios y arreglo. Con una sola
+// clave (fecha) el diccionario ya es una tabla hash y el arreglo sólo agrega
+// una indirección; el caso queda para compararlo. El último usa un umbral
+// menor que la cantidad de ciudades para medir la vuelta atrás a hashing.
+void casosAgregacionDensa(Benchmark& b, int n, unsigned int semilla) {
+    Lista<Venta>* lista = nullptr;
+    auto asegurarLista = [&]() {
+        if (lista == nullptr) {
+            lista = new Lista<Venta>();
+            construirListaSintetica(*lista, n, semilla);
+        }
+    };
+    long long grupos = 0;
+
+    b.medir("densa/pais_medio_groupby", n, 20.0 * n, asegurarLista, [&]() {
+        GroupBy<Claves<ColumnaPais, ColumnaMedioEnvio>, Conteo> envios;
+        envios.agregar(*lista);
+        grupos += envios.getTamanio();
+    });
+
+    b.medir("densa/pais_medio_denso", n, 20.0 * n, asegurarLista, [&]() {
+        GroupByDenso<Claves<ColumnaPais, ColumnaMedioEnvio>, Conteo> envios(UMBRAL_CLAVES_DENSAS);
+        envios.agregar(*lista);
+        grupos += envios.getTamanio();
+    });
+
+    b.medir("densa/pais_categoria_groupby", n, 20.0 * n, asegurarLista, [&]() {
+        GroupBy<Claves<ColumnaPais, ColumnaCategoria>, Suma<ColumnaMonto>, Suma<ColumnaCantidad>> categorias;
+        categorias.agregar(*lista);
+        grupos += categorias.getTamanio();
+    });
+
+    b.medir("densa/pais_categoria_denso", n, 20.0 * n, asegurarLista, [&]() {
+        GroupByDenso<Claves<ColumnaPais, ColumnaCategoria>, Suma<ColumnaMonto>, Suma<ColumnaCantidad>> categorias(UMBRAL_CLAVES_DENSAS);
+        categorias.agregar(*lista);
+        grupos += categorias.getTamanio();
+    });
+
+    b.medir("densa/fecha_groupby", n, 20.0 * n, asegurarLista, [&]() {
+        GroupBy<Claves<ColumnaFecha>, Suma<ColumnaMonto>> porFecha(512);
+        porFecha.agregar(*lista);
+        grupos += porFecha.getTamanio();
+    });
+
+    b.medir("densa/fecha_denso", n, 20.0 * n, asegurarLista, [&]() {
+        GroupByDenso<Claves<ColumnaFecha>, Suma<ColumnaMonto>> porFecha(4096);
+        porFecha.agregar(*lista);
+        grupos += porFecha.getTamanio();
+    });
+
+    b.medir("densa/pais_ciudad_umbral_superado", n, 20.0 * n, asegurarLista, [&]() {
+        GroupByDenso<Claves<ColumnaPais, ColumnaCiudad>, Suma<ColumnaMonto>> ciudades(4);
+        ciudades.agregar(*lista);
+        grupos += ciudades.getTamanio() + (ciudades.esDenso() ? 1 : 0);
+    });
+
+    if (grupos < 0) cerr << grupos << endl;
+    delete lista;
+}
+
+// Filtro compuesto país + medio + estado de envío: recorriendo los nodos y
+// comparando cada columna contra la intersección de los bitmaps del índice.
+// La construcción del índice se mide aparte; las consultas la pagan una vez
+// por versión de la lista.
+void casosIndice(Benchmark& b, int n, unsigned int semilla) {
+    Lista<Venta>* lista = nullptr;
+    shared_ptr<IndiceVentas> indice;
+    auto asegurarIndice = [&]() {
+        if (lista == nullptr) {
+            lista = new Lista<Venta>();
+            construirListaSintetica(*lista, n, semilla);
+            indice = make_shared<IndiceVentas>(*lista);
+        }
+    };
+    double total = 0;
+
+    b.medir("indice/construccion", n, 20.0 * n, asegurarIndice, [&]() {
+        IndiceVentas nuevo(*lista);
+        total += nuevo.getFilas();
+    });
+
+    b.medir("indice/filtro_pais_medio_estado_recorrido", n, 20.0 * n, asegurarIndice, [&]() {
+        string pais = normalizeString("Peru"), medio = normalizeString("Aereo"), estado = normalizeString("Entregado");
+        for (Nodo<Venta>* nodo = lista->getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+            const Venta& v = nodo->verDato();
+            if (normalizeString(v.pais) == pais && normalizeString(v.medioEnvio) == medio &&
+                normalizeString(v.estadoEnvio) == estado) {
+                total += v.montoTotal;
+            }
+        }
+    });
+
+    b.medir("indice/filtro_pais_medio_estado_bitmap", n, 1.0 * n, asegurarIndice, [&]() {
+        BitmapRoaring filas = indice->filtrar({{INDICE_PAIS, "Peru"}, {INDICE_MEDIO_ENVIO, "Aereo"},
+                                               {INDICE_ESTADO_ENVIO, "Entregado"}});
+        indice->recorrer(filas, [&](const Venta& v) { total += v.montoTotal; });
+    });
+
+    // Monto total de un país: visitando las filas de su bitmap o con el kernel
+    // de suma con máscara sobre las columnas del índice
+    b.medir("indice/monto_pais_bitmap", n, 1.0 * n, asegurarIndice, [&]() {
+        indice->recorrer(*indice->filas(INDICE_PAIS, "Peru"), [&](const Venta& v) { total += v.montoTotal; });
+    });
+
+    b.medir("indice/monto_pais_kernel", n, 1.0 * n, asegurarIndice, [&]() {
+        total += kernelsColumnas().sumaFloatSi(indice->getMontos().data(), indice->getCodigos(INDICE_PAIS).data(),
+                                               indice->getFilas(), indice->codigo(INDICE_PAIS, "Peru"));
+    });
+
+    // p50/p90/p99 del monto por categoría y por país: ordenando la columna de
+    // montos de cada grupo (exacto) o en una pasada con un KLL por grupo,
+    // como los que mantiene el índice
+    const vector<double> percentiles = {0.5, 0.9, 0.99};
+    b.medir("indice/percentiles_ordenar", n, 20.0 * n, asegurarIndice, [&]() {
+        for (ColumnaIndexada columna : {INDICE_CATEGORIA, INDICE_PAIS}) {
+            vector<vector<float>> grupos;
+            const vector<uint32_t>& codigos = indice->getCodigos(columna);
+            for (size_t i = 0; i < indice->getFilas(); ++i) {
+                if (codigos[i] >= grupos.size()) grupos.resize(codigos[i] + 1);
+                grupos[codigos[i]].push_back(indice->getMontos()[i]);
+            }
+            for (vector<float>& g : grupos) {
+                sort(g.begin(), g.end());
+                for (double q : percentiles) total += g[static_cast<size_t>(q * (g.size() - 1))];
+            }
+        }
+    });
+
+    b.medir("indice/percentiles_kll", n, 20.0 * n, asegurarIndice, [&]() {
+        for (ColumnaIndexada columna : {INDICE_CATEGORIA, INDICE_PAIS}) {
+            vector<ResumenCuantiles> grupos;
+            const vector<uint32_t>& codigos = indice->getCodigos(columna);
+            for (size_t i = 0; i < indice->getFilas(); ++i) {
+                if (codigos[i] >= grupos.size()) grupos.resize(codigos[i] + 1);
+                grupos[codigos[i]].agregar(indice->getMontos()[i]);
+            }
+            for (const ResumenCuantiles& g : grupos) {
+                for (float v : g.cuantiles(percentiles)) total += v;
+            }
+        }
+    });
+
+    if (total < 0) cerr << total << endl;
+    delete lista;
+}
+
+// Kernels de columnas: cada uno con la versión escalar y, si el procesador la
+// soporta, la AVX2. Los datos imitan a IndiceVentas: montos y cantidades con
+// el código de país (10 valores) de cada fila.
+void casosColumnas(Benchmark& b, int n, unsigned int semilla) {
+    vector<float> montos;
+    vector<int32_t> cantidades;
+    vector<uint32_t> paises;
+    vector<uint64_t> mascara;
+    auto asegurarColumnas = [&]() {
+        if (!montos.empty()) return;
+        mt19937 rng(semilla);
+        montos.resize(n);
+        cantidades.resize(n);
+        paises.resize(n);
+        mascara.resize(palabrasMascara(n));
+        for (int i = 0; i < n; ++i) {
+            uint32_t r = rng();
+            paises[i] = r % 10;
+            cantidades[i] = 1 + (r >> 8) % 5;
+            montos[i] = cantidades[i] * ((2000 + (r >> 12) % 118000) / 100.0f);
+        }
+    };
+
+    vector<const KernelsColumnas*> variantes = {&kernelsEscalares()};
+    if (kernelsAvx2() != nullptr) variantes.push_back(kernelsAvx2());
+    double total = 0;
+    double filas = n;
+    for (const KernelsColumnas* k : variantes) {
+        string sufijo = string("_") + k->nombre;
+        b.medir("columnas/suma_float_si" + sufijo, n, filas, asegurarColumnas, [&]() {
+            total += k->sumaFloatSi(montos.data(), paises.data(), n, 7);
+        }, filas * 8);
+        b.medir("columnas/suma_int32_si" + sufijo, n, filas, asegurarColumnas, [&]() {
+            total += k->sumaInt32Si(cantidades.data(), paises.data(), n, 7);
+        }, filas * 8);
+        b.medir("columnas/contar_si" + sufijo, n, filas, asegurarColumnas, [&]() {
+            total += k->contarSi(paises.data(), n, 7);
+        }, filas * 4);
+        b.medir("columnas/minmax_float_si" + sufijo, n, filas, asegurarColumnas, [&]() {
+            MinMaxColumna m = k->minMaxFloatSi(montos.data(), paises.data(), n, 7);
+            total += m.maximo - m.minimo;
+        }, filas * 8);
+        b.medir("columnas/comparar_float" + sufijo, n, filas, asegurarColumnas, [&]() {
+            total += k->compararFloat(montos.data(), n, 500.0f, COMPARAR_MENOR, mascara.data());
+        }, filas * 4);
+        b.medir("columnas/comparar_int32" + sufijo, n, filas, asegurarColumnas, [&]() {
+            total += k->compararInt32(cantidades.data(), n, 3, COMPARAR_MAYOR, mascara.data());
+        }, filas * 4);
+    }
+
+    if (total < 0) cerr << total << endl;
+}
+
+// Listado de todas las ventas (lo que escribe listarVentasPorCiudad por fila)
+// a /dev/null: con un flush por línea como antes, con el buffer propio del
+// ofstream y con ReporteBuffereado. También el formato de montos solo.
+void casosReporte(Benchmark& b, int n, unsigned int semilla) {
+    Lista<Venta>* lista = nullptr;
+    auto asegurarLista = [&]() {
+        if (lista == nullptr) {
+            lista = new Lista<Venta>();
+            construirListaSintetica(*lista, n, semilla);
+        }
+    };
+    ofstream nulo("/dev/null");
+
+    // Venta::mostrar tal como era, con endl en cada una de sus 13 líneas
+    b.medir("reporte/listado_endl", n, n, asegurarLista, [&]() {
+        for (Nodo<Venta>* nodo = lista->getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+            const Venta& v = nodo->getDato();
+            nulo << "==================" << endl << "Id de la venta : " << v.idVenta << endl
+                 << "Fecha : " << v.fecha << endl << "Pais : " << v.pais << endl
+                 << "Ciudad a la que llega : " << v.ciudad << endl << "Cliente : " << v.cliente << endl
+                 << "Producto a despachar : " << v.producto << endl
+                 << "Categoria del producto : " << v.categoria << endl << "Cantidad: " << v.cantidad << endl
+                 << "Precio unitario: " << v.precioUnitario << endl << "Monto total: " << v.montoTotal << endl
+                 << "Medio de envio: " << v.medioEnvio << endl << "Estado del envio: " << v.estadoEnvio << endl;
+            nulo << "--------------------------------------------------\n";
+        }
+        nulo.flush();
+    });
+
+    b.medir("reporte/listado_ofstream", n, n, asegurarLista, [&]() {
+        for (Nodo<Venta>* nodo = lista->getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+            nodo->getDato().mostrar(nulo);
+            nulo << "--------------------------------------------------\n";
+        }
+        nulo.flush();
+    });
+
+    b.medir("reporte/listado_buffereado", n, n, asegurarLista, [&]() {
+        ostream salida(nullptr);
+        SumideroStream sumidero(nulo.rdbuf());
+        ReporteBuffereado reporte(salida, &sumidero);
+        for (Nodo<Venta>* nodo = lista->getInicio(); nodo != nullptr; nodo = nodo->getSiguiente()) {
+            nodo->getDato().mostrar(salida);
+            salida << "--------------------------------------------------\n";
+        }
+    });
+
+    BufferNulo descarte;
+    ostream salidaNula(&descarte);
+    vector<float> montos;
+    mt19937 rng(semilla);
+    for (int i = 0; i < n; ++i) montos.push_back((rng() % 10000000) / 100.0f);
+
+    b.medir("reporte/montos_setprecision", n, n, []() {}, [&]() {
+        for (float m : montos) salidaNula << fixed << setprecision(2) << m << '\n';
+    });
+    b.medir("reporte/montos_fijo2", n, n, []() {}, [&]() {
+        for (float m : montos) salidaNula << fijo2(m) << '\n';
+    });
+
+    delete lista;
+}
+
+vector<int> parsearFilas(const string& s) {
+    vector<int> filas;
+    stringstream ss(s);
+    string item;
+    while (getline(ss, item, ',')) {
+        filas.push_back((int)parsearCantidadFilas(item));
+    }
+    return filas;
+}
+
+int main(int argc, char* argv[]) {
+    OpcionesBenchmark opciones;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Falta el valor de " << arg << endl;
+            return 1;
+        }
+        string valor = argv[++i];
+        if (arg == "--filas") opciones.filas = parsearFilas(valor);
+        else if (arg == "--repeticiones") opciones.repeticiones = stoi(valor);
+        else if (arg == "--calentamiento") opciones.calentamiento = stoi(valor);
+        else if (arg == "--semilla") opciones.semilla = stoul(valor);
+        else if (arg == "--casos") opciones.casos = valor;
+        else if (arg == "--max-ops") opciones.maxOps = stod(valor);
+        else if (arg == "--etiqueta") opciones.etiqueta = valor;
+        else if (arg == "--salida") opciones.salida = valor;
+        else if (arg == "--filas-columnas") opciones.filasColumnas = stod(valor);
+        else {
+            cerr << "Opcion desconocida: " << arg << endl;
+            return 1;
+        }
+    }
+    if (opciones.repeticiones < 1) opciones.repeticiones = 1;
+
+    Benchmark b(opciones);
+    for (int n : opciones.filas) {
+        casosLista(b, n, opciones.semilla);
+        casosHashMap(b, n, opciones.semilla);
+        casosHashMapList(b, n, opciones.semilla);
+        casosQuickSort(b, n, opciones.semilla);
+        casosCargaCSV(b, n, opciones.semilla);
+        casosAnalisis(b, n, opciones.semilla);
+        casosGroupBy(b, n, opciones.semilla);
+        casosAgregacionDensa(b, n, opciones.semilla);
+        casosIndice(b, n, opciones.semilla);
+        casosReporte(b, n, opciones.semilla);
+    }
+    casosColumnas(b, (int)opciones.filasColumnas, opciones.semilla);
+    b.resumirOmitidos(cerr);
+
+    if (opciones.salida.empty()) {
+        b.escribirJSON(cout);
+    } else {
+        ofstream archivo(opciones.salida);
+        b.escribirJSON(archivo);
+    }
+    return 0;
+}
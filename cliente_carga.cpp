@@ -0,0 +1,162 @@
+// Generador de carga para el servidor de ventas (tp --servidor).
+//
+// Compilar: g++ -std=c++17 -O2 -pthread -o cliente_carga cliente_carga.cpp
+// Uso:      ./cliente_carga --socket /tmp/ventas.sock [--conexiones 4]
+//                           [--solicitudes 200] [--script ordenes.txt]
+//
+// Abre --conexiones conexiones en paralelo; cada una envía --solicitudes
+// órdenes tomadas en ronda del script (o de una mezcla de consultas por
+// defecto) y mide la latencia de cada respuesta. Al final informa el
+// throughput total y p50/p99 global y por orden.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#include "SocketUnix.h"
+
+struct ResultadoHilo {
+    vector<pair<string, double>> latencias; // orden (dos primeras palabras), ms
+    long long errores = 0;
+    long long cortes = 0;
+};
+
+// Nombre corto de la orden para agrupar latencias ("query city", "add", ...)
+string claveOrden(const string& orden) {
+    size_t primero = orden.find(' ');
+    if (primero == string::npos) return orden;
+    if (orden.compare(0, primero, "query") != 0 && orden.compare(0, primero, "analyze") != 0) {
+        return orden.substr(0, primero);
+    }
+    size_t segundo = orden.find(' ', primero + 1);
+    return orden.substr(0, segundo);
+}
+
+double percentil(vector<double>& v, double p) {
+    if (v.empty()) return 0.0;
+    size_t i = static_cast<size_t>(p * (v.size() - 1) + 0.5);
+    nth_element(v.begin(), v.begin() + i, v.end());
+    return v[i];
+}
+
+void ejecutarConexion(const string& rutaSocket, const vector<string>& ordenes, int solicitudes,
+                      int desfase, ResultadoHilo& resultado) {
+    int fd = conectarSocketUnix(rutaSocket);
+    if (fd == -1) {
+        resultado.cortes++;
+        return;
+    }
+    ConexionSocket conexion(fd);
+    string respuesta;
+    bool ok;
+    for (int i = 0; i < solicitudes; ++i) {
+        const string& orden = ordenes[(desfase + i) % ordenes.size()];
+        auto inicio = chrono::steady_clock::now();
+        if (!conexion.enviarOrden(orden, ok, respuesta)) {
+            resultado.cortes++;
+            return;
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+        if (!ok) resultado.errores++;
+        resultado.latencias.push_back({claveOrden(orden), ms});
+    }
+    conexion.enviarOrden("quit", ok, respuesta);
+}
+
+int main(int argc, char* argv[]) {
+    string rutaSocket;
+    string archivoScript;
+    int conexiones = 4;
+    int solicitudes = 200;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Falta el valor de " << arg << endl;
+            return 1;
+        }
+        string valor = argv[++i];
+        if (arg == "--socket") rutaSocket = valor;
+        else if (arg == "--conexiones") conexiones = stoi(valor);
+        else if (arg == "--solicitudes") solicitudes = stoi(valor);
+        else if (arg == "--script") archivoScript = valor;
+        else {
+            cerr << "Opcion desconocida: " << arg << endl;
+            return 1;
+        }
+    }
+    if (rutaSocket.empty() || conexiones < 1 || solicitudes < 1) {
+        cerr << "Uso: " << argv[0] << " --socket <ruta> [--conexiones N] [--solicitudes M] [--script archivo]" << endl;
+        return 1;
+    }
+
+    vector<string> ordenes;
+    if (!archivoScript.empty()) {
+        ifstream script(archivoScript);
+        if (!script.is_open()) {
+            cerr << "No se pudo abrir " << archivoScript << endl;
+            return 1;
+        }
+        string linea;
+        while (getline(script, linea)) {
+            if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+            size_t primero = linea.find_first_not_of(" \t");
+            if (primero == string::npos || linea[primero] == '#') continue;
+            ordenes.push_back(linea.substr(primero));
+        }
+    } else {
+        ordenes = {
+            "query city Lima",
+            "query range 01/01/2024 31/03/2024 Peru",
+            "query compare-countries Peru Chile",
+            "query compare-products Laptop Tablet",
+            "query below Peru 500",
+            "query above 300",
+        };
+    }
+    if (ordenes.empty()) {
+        cerr << "El script no tiene ordenes." << endl;
+        return 1;
+    }
+
+    vector<ResultadoHilo> resultados(conexiones);
+    vector<thread> hilos;
+    auto inicio = chrono::steady_clock::now();
+    for (int i = 0; i < conexiones; ++i) {
+        hilos.emplace_back(ejecutarConexion, cref(rutaSocket), cref(ordenes), solicitudes, i, ref(resultados[i]));
+    }
+    for (thread& h : hilos) h.join();
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    vector<double> todas;
+    map<string, vector<double>> porOrden;
+    long long errores = 0, cortes = 0;
+    for (const ResultadoHilo& r : resultados) {
+        for (const auto& l : r.latencias) {
+            todas.push_back(l.second);
+            porOrden[l.first].push_back(l.second);
+        }
+        errores += r.errores;
+        cortes += r.cortes;
+    }
+
+    cout << fixed << setprecision(3);
+    cout << "Conexiones: " << conexiones << ", respuestas: " << todas.size() << ", errores: " << errores
+         << ", conexiones cortadas: " << cortes << "\n";
+    cout << "Tiempo: " << segundos << " s, throughput: " << todas.size() / segundos << " ordenes/s\n";
+    cout << "Latencia global: p50 " << percentil(todas, 0.50) << " ms, p99 " << percentil(todas, 0.99) << " ms\n\n";
+    cout << left << setw(28) << "Orden" << right << setw(10) << "Cantidad" << setw(12) << "p50 (ms)" << setw(12) << "p99 (ms)" << "\n";
+    for (auto& par : porOrden) {
+        cout << left << setw(28) << par.first << right << setw(10) << par.second.size()
+             << setw(12) << percentil(par.second, 0.50) << setw(12) << percentil(par.second, 0.99) << "\n";
+    }
+    return cortes == 0 ? 0 : 1;
+}
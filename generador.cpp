@@ -0,0 +1,81 @@
+// Generador de ventas sintéticas con el mismo esquema que ventas_sudamerica.csv.
+//
+// Compilar: g++ -std=c++17 -O2 -o generador generador.cpp
+// Uso:      ./generador --filas 1000000 [--salida ventas_1M.csv]
+//                       [--modelo ventas_sudamerica.csv] [--semilla 42]
+//                       [--zipf-productos 1.1] [--zipf-ciudades 0.8] [--lf]
+//
+// Las distribuciones (países, ciudades por país, productos y su categoría,
+// rango de precios por producto, cantidades, clientes, medios y estados de
+// envío, rango de fechas) se aprenden del CSV indicado en --modelo. Con
+// --zipf-* se reemplazan las frecuencias aprendidas por una Zipf sobre el
+// ranking de frecuencias. La misma semilla produce siempre el mismo archivo.
+// --filas acepta los sufijos K, M y B (por ejemplo 500M o 1B).
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+
+using namespace std;
+
+#include "GeneradorVentas.h"
+
+int main(int argc, char* argv[]) {
+    string archivoModelo = "ventas_sudamerica.csv";
+    string archivoSalida = "";
+    unsigned long long filas = 0;
+    OpcionesGenerador opciones;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--lf") {
+            opciones.finDeLineaCRLF = false;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Falta el valor de " << arg << endl;
+            return 1;
+        }
+        string valor = argv[++i];
+        if (arg == "--filas") filas = parsearCantidadFilas(valor);
+        else if (arg == "--salida") archivoSalida = valor;
+        else if (arg == "--modelo") archivoModelo = valor;
+        else if (arg == "--semilla") opciones.semilla = stoull(valor);
+        else if (arg == "--zipf-productos") opciones.zipfProductos = stod(valor);
+        else if (arg == "--zipf-ciudades") opciones.zipfCiudades = stod(valor);
+        else {
+            cerr << "Opcion desconocida: " << arg << endl;
+            return 1;
+        }
+    }
+
+    if (filas == 0) {
+        cerr << "Debe indicar --filas (por ejemplo --filas 1M)" << endl;
+        return 1;
+    }
+
+    ModeloVentas modelo;
+    if (!aprenderModelo(archivoModelo, modelo)) {
+        cerr << "No se pudo aprender el modelo de " << archivoModelo << endl;
+        return 1;
+    }
+    cerr << "Modelo aprendido de " << modelo.filasAprendidas << " filas: "
+         << modelo.paises.valores.size() << " paises, "
+         << modelo.productos.valores.size() << " productos, "
+         << modelo.clientes.valores.size() << " clientes" << endl;
+
+    FILE* salida = stdout;
+    if (!archivoSalida.empty()) {
+        salida = fopen(archivoSalida.c_str(), "wb");
+        if (salida == nullptr) {
+            cerr << "No se pudo abrir " << archivoSalida << endl;
+            return 1;
+        }
+    }
+
+    GeneradorVentas generador(modelo, opciones);
+    generador.generar(salida, filas, !archivoSalida.empty());
+
+    if (salida != stdout) fclose(salida);
+    return 0;
+}
@@ -13,8 +13,9 @@
 struct CiudadMonto {
     std::string ciudad;
     float monto;
+    float margen; // con --approx, margen del intervalo de confianza del monto
 
-    CiudadMonto(std::string c = "", float m = 0.0f) : ciudad(c), monto(m) {}
+    CiudadMonto(std::string c = "", float m = 0.0f, float e = 0.0f) : ciudad(c), monto(m), margen(e) {}
 };
 
 // Función de comparación para ordenar CiudadMonto por monto (descendente)